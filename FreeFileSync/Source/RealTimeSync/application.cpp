@@ -70,7 +70,7 @@ bool Application::OnInit()
     try { fff::setLanguage(globalCfg.programLanguage); } //throw FileError
     catch (const FileError& e) { logExtraError(e.toString()); }
 
-    try { imageResourcesInit(appendPath(fff::getResourceDirPath(), Zstr("Icons.zip"))); }
+    try { imageResourcesInit(appendPath(fff::getResourceDirPath(), Zstr("Icons.zip")), appendPath(fff::getConfigDirPath(), Zstr("IconCache.dat"))); }
     catch (const FileError& e) { logExtraError(e.toString()); } //not critical in this context
 
     //GTK should already have been initialized by wxWidgets (see \src\gtk\app.cpp:wxApp::Initialize)
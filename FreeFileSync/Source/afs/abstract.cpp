@@ -16,6 +16,20 @@ using namespace fff;
 using AFS = AbstractFileSystem;
 
 
+std::string AfsCallTrace::getDeviceLabel(const AfsDevice& afsDevice)
+{
+    return utfTo<std::string>(AFS::getDisplayPath(AbstractPath(afsDevice, AfsPath())));
+}
+
+
+void AfsCallTrace::start(const char* operation, const AfsDevice& afsDevice)
+{
+    operation_ = operation;
+    device_    = getDeviceLabel(afsDevice);
+    startTime_ = std::chrono::steady_clock::now();
+}
+
+
 AfsPath fff::sanitizeDeviceRelativePath(Zstring relPath)
 {
     if constexpr (FILE_NAME_SEPARATOR != Zstr('/' )) replace(relPath, Zstr('/'),  FILE_NAME_SEPARATOR);
@@ -167,7 +181,7 @@ AFS::FileCopyResult AFS::copyFileTransactional(const AbstractPath& sourcePath, c
                                                const std::function<void()>& onDeleteTargetFile,
                                                const IoCallback& notifyUnbufferedIO /*throw X*/)
 {
-    auto copyFilePlain = [&](const AbstractPath& targetPathTmp)
+    auto copyFilePlainImpl = [&](const AbstractPath& targetPathTmp)
     {
         //caveat: typeid returns static type for pointers, dynamic type for references!!!
         if (typeid(sourcePath.afsDevice.ref()) == typeid(targetPathTmp.afsDevice.ref()))
@@ -184,6 +198,22 @@ AFS::FileCopyResult AFS::copyFileTransactional(const AbstractPath& sourcePath, c
         return sourcePath.afsDevice.ref().copyFileAsStream(sourcePath.afsPath, attrSource, targetPathTmp, notifyUnbufferedIO); //throw FileError, ErrorFileLocked, X
     };
 
+    auto copyFilePlain = [&](const AbstractPath& targetPathTmp)
+    {
+        if (!perfTraceEnabled())
+            return copyFilePlainImpl(targetPathTmp); //throw FileError, ErrorFileLocked, X
+
+        PerfTraceSpan span("afs", "copyFile");
+        const auto startTime = std::chrono::steady_clock::now();
+
+        const FileCopyResult result = copyFilePlainImpl(targetPathTmp); //throw FileError, ErrorFileLocked, X
+
+        const std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - startTime;
+        perfRecordTransfer(AfsCallTrace::getDeviceLabel(sourcePath   .afsDevice), "read",  result.fileSize, duration);
+        perfRecordTransfer(AfsCallTrace::getDeviceLabel(targetPathTmp.afsDevice), "write", result.fileSize, duration);
+        return result;
+    };
+
     if (transactionalCopy && !hasNativeTransactionalCopy(targetPath))
     {
         const std::optional<AbstractPath> parentPath = getParentPath(targetPath);
@@ -11,6 +11,7 @@
 #include <chrono>
 #include <zen/file_error.h>
 #include <zen/file_path.h>
+#include <zen/perf.h>
 #include <zen/serialize.h> //InputStream/OutputStream support buffered stream concept
 #include <wx+/image_holder.h> //NOT a wxWidgets dependency!
 
@@ -46,6 +47,28 @@ struct AbstractPath //THREAD-SAFETY: like an int!
 };
 //==============================================================================================================
 
+class AfsCallTrace //perf trace (if enabled): latency histogram per AFS call and device, see zen/perf.h
+{
+public:
+    AfsCallTrace(const char* operation, const AfsDevice& afsDevice) : span_("afs", operation)
+    {
+        if (zen::perfTraceEnabled())
+            start(operation, afsDevice);
+    }
+    ~AfsCallTrace() { if (operation_) zen::perfRecordLatency(operation_, device_, std::chrono::steady_clock::now() - startTime_); }
+
+    static std::string getDeviceLabel(const AfsDevice& afsDevice);
+
+private:
+    void start(const char* operation, const AfsDevice& afsDevice);
+
+    zen::PerfTraceSpan span_;
+    const char* operation_ = nullptr;
+    std::string device_;
+    std::chrono::steady_clock::time_point startTime_;
+};
+//==============================================================================================================
+
 struct AbstractFileSystem //THREAD-SAFETY: "const" member functions must model thread-safe access!
 {
     //=============== convenience =================
@@ -90,21 +113,21 @@ struct AbstractFileSystem //THREAD-SAFETY: "const" member functions must model t
     };
     //(hopefully) fast: does not distinguish between error/not existing
     //root path? => do access test
-    static ItemType getItemType(const AbstractPath& itemPath) { return itemPath.afsDevice.ref().getItemType(itemPath.afsPath); } //throw FileError
+    static ItemType getItemType(const AbstractPath& itemPath) { AfsCallTrace trace("getItemType", itemPath.afsDevice); return itemPath.afsDevice.ref().getItemType(itemPath.afsPath); } //throw FileError
 
     //assumes: - folder traversal access right (=> yes, because we can assume base path exist at this point; e.g. avoids problem when SFTP parent paths might deny access)
     //         - all child item path parts must correspond to folder traversal
     //           => conclude whether an item is *not* existing anymore by doing a *case-sensitive* name search => potentially SLOW!
     //         - root path? => do access test
     static std::optional<ItemType> getItemTypeIfExists(const AbstractPath& itemPath)
-    { return itemPath.afsDevice.ref().getItemTypeIfExists(itemPath.afsPath); } //throw FileError
+    { AfsCallTrace trace("getItemTypeIfExists", itemPath.afsDevice); return itemPath.afsDevice.ref().getItemTypeIfExists(itemPath.afsPath); } //throw FileError
 
     static bool itemExists(const AbstractPath& itemPath) { return static_cast<bool>(getItemTypeIfExists(itemPath)); } //throw FileError
     //----------------------------------------------------------------------------------------------------------------
 
     //already existing: fail
     //does NOT create parent directories recursively if not existing
-    static void createFolderPlain(const AbstractPath& folderPath) { folderPath.afsDevice.ref().createFolderPlain(folderPath.afsPath); } //throw FileError
+    static void createFolderPlain(const AbstractPath& folderPath) { AfsCallTrace trace("createFolderPlain", folderPath.afsDevice); folderPath.afsDevice.ref().createFolderPlain(folderPath.afsPath); } //throw FileError
 
     //creates directories recursively if not existing
     //returns false if folder already exists
@@ -120,9 +143,9 @@ struct AbstractFileSystem //THREAD-SAFETY: "const" member functions must model t
     static void removeSymlinkIfExists    (const AbstractPath& linkPath);   //throw FileError
     static void removeEmptyFolderIfExists(const AbstractPath& folderPath); //
 
-    static void removeFilePlain   (const AbstractPath& filePath  ) { filePath  .afsDevice.ref().removeFilePlain   (filePath  .afsPath); } //
-    static void removeSymlinkPlain(const AbstractPath& linkPath  ) { linkPath  .afsDevice.ref().removeSymlinkPlain(linkPath  .afsPath); } //throw FileError
-    static void removeFolderPlain (const AbstractPath& folderPath) { folderPath.afsDevice.ref().removeFolderPlain (folderPath.afsPath); } //
+    static void removeFilePlain   (const AbstractPath& filePath  ) { AfsCallTrace trace("removeFilePlain",    filePath  .afsDevice); filePath  .afsDevice.ref().removeFilePlain   (filePath  .afsPath); } //
+    static void removeSymlinkPlain(const AbstractPath& linkPath  ) { AfsCallTrace trace("removeSymlinkPlain", linkPath  .afsDevice); linkPath  .afsDevice.ref().removeSymlinkPlain(linkPath  .afsPath); } //throw FileError
+    static void removeFolderPlain (const AbstractPath& folderPath) { AfsCallTrace trace("removeFolderPlain",  folderPath.afsDevice); folderPath.afsDevice.ref().removeFolderPlain (folderPath.afsPath); } //
     //----------------------------------------------------------------------------------------------------------------
     //static void setModTime(const AbstractPath& itemPath, time_t modTime) { itemPath.afsDevice.ref().setModTime(itemPath.afsPath, modTime); } //throw FileError, follows symlinks
 
@@ -152,7 +175,7 @@ struct AbstractFileSystem //THREAD-SAFETY: "const" member functions must model t
         virtual std::optional<StreamAttributes> tryGetAttributesFast() = 0; //throw FileError
     };
     //return value always bound:
-    static std::unique_ptr<InputStream> getInputStream(const AbstractPath& filePath) { return filePath.afsDevice.ref().getInputStream(filePath.afsPath); } //throw FileError, ErrorFileLocked
+    static std::unique_ptr<InputStream> getInputStream(const AbstractPath& filePath) { AfsCallTrace trace("getInputStream", filePath.afsDevice); return filePath.afsDevice.ref().getInputStream(filePath.afsPath); } //throw FileError, ErrorFileLocked
 
     //----------------------------------------------------------------------------------------------------------------
 
@@ -189,7 +212,7 @@ struct AbstractFileSystem //THREAD-SAFETY: "const" member functions must model t
     static std::unique_ptr<OutputStream> getOutputStream(const AbstractPath& filePath, //throw FileError
                                                          std::optional<uint64_t> streamSize,
                                                          std::optional<time_t> modTime)
-    { return std::make_unique<OutputStream>(filePath.afsDevice.ref().getOutputStream(filePath.afsPath, streamSize, modTime), filePath, streamSize); }
+    { AfsCallTrace trace("getOutputStream", filePath.afsDevice); return std::make_unique<OutputStream>(filePath.afsDevice.ref().getOutputStream(filePath.afsPath, streamSize, modTime), filePath, streamSize); }
     //----------------------------------------------------------------------------------------------------------------
 
     struct SymlinkInfo
@@ -254,7 +277,7 @@ struct AbstractFileSystem //THREAD-SAFETY: "const" member functions must model t
                                const std::function<void(const FileInfo&    fi)>& onFile,    //
                                const std::function<void(const FolderInfo&  fi)>& onFolder,  //optional
                                const std::function<void(const SymlinkInfo& si)>& onSymlink) //
-    { folderPath.afsDevice.ref().traverseFolder(folderPath.afsPath, onFile, onFolder, onSymlink); }
+    { AfsCallTrace trace("traverseFolder", folderPath.afsDevice); folderPath.afsDevice.ref().traverseFolder(folderPath.afsPath, onFile, onFolder, onSymlink); }
     //----------------------------------------------------------------------------------------------------------------
 
     //already existing: undefined behavior! (e.g. fail/overwrite)
@@ -537,6 +560,7 @@ void AbstractFileSystem::moveAndRenameItem(const AbstractPath& pathFrom, const A
     if (typeid(pathFrom.afsDevice.ref()) != typeid(pathTo.afsDevice.ref()))
         throw ErrorMoveUnsupported(generateMoveErrorMsg(pathFrom, pathTo), _("Operation not supported between different devices."));
 
+    AfsCallTrace trace("moveAndRenameItem", pathFrom.afsDevice);
     //already existing: undefined behavior! (e.g. fail/overwrite)
     pathFrom.afsDevice.ref().moveAndRenameItemForSameAfsType(pathFrom.afsPath, pathTo); //throw FileError, ErrorMoveUnsupported
 }
@@ -557,7 +581,10 @@ void AbstractFileSystem::copyNewFolder(const AbstractPath& sourcePath, const Abs
                             _("Operation not supported between different devices."));
     }
     else
+    {
+        AfsCallTrace trace("copyNewFolder", targetPath.afsDevice);
         sourcePath.afsDevice.ref().copyNewFolderForSameAfsType(sourcePath.afsPath, targetPath, copyFilePermissions); //throw FileError
+    }
 }
 
 
@@ -572,6 +599,7 @@ void AbstractFileSystem::copySymlink(const AbstractPath& sourcePath, const Abstr
                                               L"%x", L'\n' + fmtPath(getDisplayPath(sourcePath))),
                                    L"%y", L'\n' + fmtPath(getDisplayPath(targetPath))), _("Operation not supported between different devices."));
 
+    AfsCallTrace trace("copySymlink", targetPath.afsDevice);
     //already existing: fail
     sourcePath.afsDevice.ref().copySymlinkForSameAfsType(sourcePath.afsPath, targetPath, copyFilePermissions); //throw FileError
 }
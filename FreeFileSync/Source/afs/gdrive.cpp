@@ -17,6 +17,7 @@
 #include <zen/http.h>
 #include <zen/json.h>
 #include <zen/resolve_path.h>
+#include <zen/ring_buffer.h>
 #include <zen/process_exec.h>
 #include <zen/socket.h>
 #include <zen/shutdown.h>
@@ -69,7 +70,21 @@ namespace
 {
 //Google Drive REST API Overview:  https://developers.google.com/drive/api/v3/about-sdk
 //Google Drive REST API Reference: https://developers.google.com/drive/api/v3/reference
-const Zchar* GOOGLE_REST_API_SERVER = Zstr("www.googleapis.com");
+//server overrides for testing against a local mock server, e.g. FFS_GDRIVE_API_SERVER=http://localhost:8080
+//=> plain HTTP only if "http://" is given explicitly; otherwise TLS, validated against the bundled CA certificates
+Zstring getGoogleServer(const ZstringView envName, const Zchar* defaultServer)
+{
+    if (const std::optional<Zstring> server = getEnvironmentVar(envName);
+        server && !server->empty())
+        return *server;
+    return defaultServer;
+}
+const Zstring GOOGLE_REST_API_SERVER = getGoogleServer(Zstr("FFS_GDRIVE_API_SERVER"),   Zstr("www.googleapis.com"));
+const Zstring GOOGLE_OAUTH_SERVER    = getGoogleServer(Zstr("FFS_GDRIVE_OAUTH_SERVER"), Zstr("oauth2.googleapis.com"));
+
+bool useTls(const Zstring& server) { return !startsWithAsciiNoCase(server, Zstr("http://")); }
+
+std::string getServerUrl(const Zstring& server) { return useTls(server) ? "https://" + utfTo<std::string>(server) : utfTo<std::string>(server); }
 
 constexpr std::chrono::seconds HTTP_SESSION_MAX_IDLE_TIME  (20);
 constexpr std::chrono::seconds HTTP_SESSION_CLEANUP_INTERVAL(4);
@@ -79,13 +94,16 @@ const size_t GDRIVE_BLOCK_SIZE_DOWNLOAD =  64 * 1024; //libcurl returns blocks o
 const size_t GDRIVE_BLOCK_SIZE_UPLOAD   =  64 * 1024; //libcurl requests blocks of 64 kB. larger blocksizes set via CURLOPT_UPLOAD_BUFFERSIZE do not seem to make a difference
 const size_t GDRIVE_STREAM_BUFFER_SIZE = 1024 * 1024; //unit: [byte]
 //stream buffer should be big enough to facilitate prefetching during alternating read/write operations => e.g. see serialize.h::unbufferedStreamCopy()
+const size_t GDRIVE_UPLOAD_CHUNK_SIZE = 16 * 1024 * 1024; //must be a multiple of 256 KiB; buffered in memory per upload => don't go overboard
+const size_t GDRIVE_UPLOAD_RETRY_MAX  = 3; //per chunk: consecutive failures without progress
+constexpr std::chrono::hours GDRIVE_UPLOAD_SESSION_MAX_AGE(6 * 24); //upload URLs are valid for one week
 
 constexpr ZstringView gdrivePrefix = Zstr("gdrive:");
 const char gdriveFolderMimeType  [] = "application/vnd.google-apps.folder";
 const char gdriveShortcutMimeType[] = "application/vnd.google-apps.shortcut"; //= symbolic link!
 
 const char DB_FILE_DESCR[] = "FreeFileSync";
-const int  DB_FILE_VERSION = 5; //2021-05-15
+const int  DB_FILE_VERSION = 6; //2026-10-17
 
 std::string getGdriveClientId    () { return ""; } // => replace with live credentials
 std::string getGdriveClientSecret() { return ""; } //
@@ -233,7 +251,7 @@ private:
     struct HttpInitSession
     {
         HttpInitSession(const Zstring& server, const Zstring& caCertFilePath) :
-            session(server, true /*useTls*/, caCertFilePath) {}
+            session(useTls(server) ? server : afterFirst(server, Zstr("://"), IfNotFoundReturn::none), useTls(server), caCertFilePath) {}
 
         const std::shared_ptr<UniCounterCookie> cookie{getLibsshCurlUnifiedInitCookie(httpSessionCount)}; //throw SysError
         HttpSession session; //life time must be subset of UniCounterCookie
@@ -431,7 +449,7 @@ GdriveAccessInfo gdriveExchangeAuthCode(const GdriveAuthCode& authCode, int time
         {"code_verifier", authCode.codeChallenge},
     });
     std::string response;
-    googleHttpsRequest(Zstr("oauth2.googleapis.com"), "/token", {} /*extraHeaders*/, {{CURLOPT_POSTFIELDS, postBuf.c_str()}},
+    googleHttpsRequest(GOOGLE_OAUTH_SERVER, "/token", {} /*extraHeaders*/, {{CURLOPT_POSTFIELDS, postBuf.c_str()}},
     [&](std::span<const char> buf) { response.append(buf.data(), buf.size()); },
     nullptr /*readRequest*/, nullptr /*receiveHeader*/, timeoutSec); //throw SysError
 
@@ -709,7 +727,7 @@ GdriveAccessToken gdriveRefreshAccess(const std::string& refreshToken, int timeo
         {"grant_type",    "refresh_token"},
     });
     std::string response;
-    googleHttpsRequest(Zstr("oauth2.googleapis.com"), "/token", {} /*extraHeaders*/, {{CURLOPT_POSTFIELDS, postBuf.c_str()}},
+    googleHttpsRequest(GOOGLE_OAUTH_SERVER, "/token", {} /*extraHeaders*/, {{CURLOPT_POSTFIELDS, postBuf.c_str()}},
     [&](std::span<const char> buf) { response.append(buf.data(), buf.size()); },
     nullptr /*readRequest*/, nullptr /*receiveHeader*/, timeoutSec); //throw SysError
 
@@ -730,7 +748,7 @@ void gdriveRevokeAccess(const GdriveAccess& access) //throw SysError
 {
     //https://developers.google.com/identity/protocols/OAuth2InstalledApp#tokenrevoke
     std::string response;
-    const HttpSession::Result httpResult = googleHttpsRequest(Zstr("oauth2.googleapis.com"), "/revoke?token=" + access.token,
+    const HttpSession::Result httpResult = googleHttpsRequest(GOOGLE_OAUTH_SERVER, "/revoke?token=" + access.token,
     {"Content-Type: application/x-www-form-urlencoded"}, {{ CURLOPT_POSTFIELDS, ""}},
     [&](std::span<const char> buf) { response.append(buf.data(), buf.size()); },
     nullptr /*readRequest*/, nullptr /*receiveHeader*/, access.timeoutSec); //throw SysError
@@ -940,61 +958,155 @@ struct GdriveItemDetails
 };
 
 
-GdriveItemDetails extractItemDetails(const JsonValue& jvalue) //throw SysError
+//item metadata as received: from JsonValue or while stream-parsing a response
+struct GdriveItemFields
+{
+    std::optional<std::string> itemId;
+    std::optional<std::string> name;
+    std::optional<std::string> mimeType;
+    std::optional<std::string> ownedByMe;
+    std::optional<std::string> size;
+    std::optional<std::string> modifiedTime;
+    std::optional<std::string> trashed;
+    std::vector<std::string> parentIds;
+    bool haveShortcut = false; //"shortcutDetails"
+    std::optional<std::string> targetId;
+    bool invalidParents = false;
+
+    //relPath: relative to the item's JSON object
+    void addValue(std::span<const std::string> relPath, JsonValue::Type type, std::string_view primVal)
+    {
+        if (relPath.size() == 1)
+        {
+            const std::string& fieldName = relPath[0];
+            if      (fieldName == "id"          ) itemId      .emplace(primVal);
+            else if (fieldName == "name"        ) name        .emplace(primVal);
+            else if (fieldName == "mimeType"    ) mimeType    .emplace(primVal);
+            else if (fieldName == "ownedByMe"   ) ownedByMe   .emplace(primVal);
+            else if (fieldName == "size"        ) size        .emplace(primVal);
+            else if (fieldName == "modifiedTime") modifiedTime.emplace(primVal);
+            else if (fieldName == "trashed"     ) trashed     .emplace(primVal);
+            else if (fieldName == "shortcutDetails") haveShortcut = true;
+        }
+        else if (relPath.size() == 2 && relPath[0] == "parents")
+        {
+            if (type != JsonValue::Type::string)
+                invalidParents = true;
+            else
+                parentIds.emplace_back(primVal);
+        }
+        else if (relPath.size() == 2 && relPath[0] == "shortcutDetails" && relPath[1] == "targetId")
+            targetId.emplace(primVal);
+    }
+
+    void addContainer(std::span<const std::string> relPath)
+    {
+        if (relPath.size() == 1 && relPath[0] == "shortcutDetails")
+            haveShortcut = true;
+        else if (relPath.size() == 2 && relPath[0] == "parents")
+            invalidParents = true;
+    }
+};
+
+
+GdriveItemFields getItemFields(const JsonValue& jvalue)
+{
+    GdriveItemFields fields;
+    fields.itemId       = getPrimitiveFromJsonObject(jvalue, "id");
+    fields.name         = getPrimitiveFromJsonObject(jvalue, "name");
+    fields.mimeType     = getPrimitiveFromJsonObject(jvalue, "mimeType");
+    fields.ownedByMe    = getPrimitiveFromJsonObject(jvalue, "ownedByMe");
+    fields.size         = getPrimitiveFromJsonObject(jvalue, "size");
+    fields.modifiedTime = getPrimitiveFromJsonObject(jvalue, "modifiedTime");
+    fields.trashed      = getPrimitiveFromJsonObject(jvalue, "trashed");
+
+    if (const JsonValue* parents = getChildFromJsonObject(jvalue, "parents"))
+        for (const JsonValue& parentVal : parents->arrayVal)
+        {
+            if (parentVal.type != JsonValue::Type::string)
+                fields.invalidParents = true;
+            else
+                fields.parentIds.push_back(parentVal.primVal);
+        }
+
+    if (const JsonValue* shortcut = getChildFromJsonObject(jvalue, "shortcutDetails"))
+    {
+        fields.haveShortcut = true;
+        fields.targetId = getPrimitiveFromJsonObject(*shortcut, "targetId");
+    }
+    return fields;
+}
+
+
+JsonValue toJson(const GdriveItemFields& fields) //for error messages
 {
-    assert(jvalue.type == JsonValue::Type::object);
+    JsonValue jvalue(JsonValue::Type::object);
+    auto addPrimitive = [&](const char* name, const std::optional<std::string>& val)
+    {
+        if (val)
+            jvalue.objectVal.emplace(name, JsonValue(*val));
+    };
+    addPrimitive("id",           fields.itemId);
+    addPrimitive("name",         fields.name);
+    addPrimitive("mimeType",     fields.mimeType);
+    addPrimitive("ownedByMe",    fields.ownedByMe);
+    addPrimitive("size",         fields.size);
+    addPrimitive("modifiedTime", fields.modifiedTime);
+    addPrimitive("trashed",      fields.trashed);
+
+    if (!fields.parentIds.empty())
+    {
+        JsonValue& parents = jvalue.objectVal.emplace("parents", JsonValue::Type::array).first->second;
+        for (const std::string& parentId : fields.parentIds)
+            parents.arrayVal.emplace_back(parentId);
+    }
+    if (fields.haveShortcut)
+    {
+        JsonValue& shortcut = jvalue.objectVal.emplace("shortcutDetails", JsonValue::Type::object).first->second;
+        if (fields.targetId)
+            shortcut.objectVal.emplace("targetId", JsonValue(*fields.targetId));
+    }
+    return jvalue;
+}
 
-    /**/  std::optional<std::string> itemName     = getPrimitiveFromJsonObject(jvalue, "name");
-    const std::optional<std::string> mimeType     = getPrimitiveFromJsonObject(jvalue, "mimeType");
-    const std::optional<std::string> ownedByMe    = getPrimitiveFromJsonObject(jvalue, "ownedByMe");
-    const std::optional<std::string> size         = getPrimitiveFromJsonObject(jvalue, "size");
-    const std::optional<std::string> modifiedTime = getPrimitiveFromJsonObject(jvalue, "modifiedTime");
-    const JsonValue*                 parents      = getChildFromJsonObject    (jvalue, "parents");
-    const JsonValue*                 shortcut     = getChildFromJsonObject    (jvalue, "shortcutDetails");
 
-    if (!itemName || itemName->empty() || !mimeType || !modifiedTime)
-        throw SysError(formatGdriveErrorRaw(serializeJson(jvalue)));
+GdriveItemDetails extractItemDetails(GdriveItemFields fields) //throw SysError
+{
+    if (!fields.name || fields.name->empty() || !fields.mimeType || !fields.modifiedTime || fields.invalidParents)
+        throw SysError(formatGdriveErrorRaw(serializeJson(toJson(fields))));
 
-    const GdriveItemType type = *mimeType == gdriveFolderMimeType   ? GdriveItemType::folder :
-                                *mimeType == gdriveShortcutMimeType ? GdriveItemType::shortcut :
+    const GdriveItemType type = *fields.mimeType == gdriveFolderMimeType   ? GdriveItemType::folder :
+                                *fields.mimeType == gdriveShortcutMimeType ? GdriveItemType::shortcut :
                                 GdriveItemType::file;
 
-    const FileOwner owner = ownedByMe ? (*ownedByMe == "true" ? FileOwner::me : FileOwner::other) : FileOwner::none; //"Not populated for items in Shared Drives"
-    const uint64_t fileSize = size ? stringTo<uint64_t>(*size) : 0; //not available for folders and shortcuts
+    const FileOwner owner = fields.ownedByMe ? (*fields.ownedByMe == "true" ? FileOwner::me : FileOwner::other) : FileOwner::none; //"Not populated for items in Shared Drives"
+    const uint64_t fileSize = fields.size ? stringTo<uint64_t>(*fields.size) : 0; //not available for folders and shortcuts
 
     //RFC 3339 date-time: e.g. "2018-09-29T08:39:12.053Z"
-    const TimeComp tc = parseTime("%Y-%m-%dT%H:%M:%S", beforeLast(*modifiedTime, '.', IfNotFoundReturn::all));
-    if (tc == TimeComp() || !endsWith(*modifiedTime, 'Z')) //'Z' means "UTC" => it seems Google doesn't use the time-zone offset postfix
-        throw SysError(L"Modification time is invalid. (" + utfTo<std::wstring>(*modifiedTime) + L')');
+    const TimeComp tc = parseTime("%Y-%m-%dT%H:%M:%S", beforeLast(*fields.modifiedTime, '.', IfNotFoundReturn::all));
+    if (tc == TimeComp() || !endsWith(*fields.modifiedTime, 'Z')) //'Z' means "UTC" => it seems Google doesn't use the time-zone offset postfix
+        throw SysError(L"Modification time is invalid. (" + utfTo<std::wstring>(*fields.modifiedTime) + L')');
 
     const auto [modTime, timeValid] = utcToTimeT(tc);
     if (!timeValid)
-        throw SysError(L"Modification time is invalid. (" + utfTo<std::wstring>(*modifiedTime) + L')');
+        throw SysError(L"Modification time is invalid. (" + utfTo<std::wstring>(*fields.modifiedTime) + L')');
 
-    std::vector<std::string> parentIds;
-    if (parents) //item without "parents" array is possible! e.g. 1. shared item located in "Shared with me", referenced via a Shortcut 2. root folder under "Computers"
-        for (const JsonValue& parentVal : parents->arrayVal)
-        {
-            if (parentVal.type != JsonValue::Type::string)
-                throw SysError(formatGdriveErrorRaw(serializeJson(jvalue)));
-            parentIds.emplace_back(parentVal.primVal);
-        }
+    //item without "parents" array is possible! e.g. 1. shared item located in "Shared with me", referenced via a Shortcut 2. root folder under "Computers"
 
-    if (!!shortcut != (type == GdriveItemType::shortcut))
-        throw SysError(formatGdriveErrorRaw(serializeJson(jvalue)));
+    if (fields.haveShortcut != (type == GdriveItemType::shortcut))
+        throw SysError(formatGdriveErrorRaw(serializeJson(toJson(fields))));
 
     std::string targetId;
-    if (shortcut)
+    if (fields.haveShortcut)
     {
-        std::optional<std::string> targetItemId = getPrimitiveFromJsonObject(*shortcut, "targetId");
-        if (!targetItemId || targetItemId->empty())
-            throw SysError(formatGdriveErrorRaw(serializeJson(jvalue)));
+        if (!fields.targetId || fields.targetId->empty())
+            throw SysError(formatGdriveErrorRaw(serializeJson(toJson(fields))));
 
-        targetId = std::move(*targetItemId);
+        targetId = std::move(*fields.targetId);
         //evaluate "targetMimeType" ? don't bother: "The MIME type of a shortcut can become stale"!
     }
 
-    return {utfTo<Zstring>(*itemName), fileSize, modTime, type, owner, std::move(targetId), std::move(parentIds)};
+    return {utfTo<Zstring>(*fields.name), fileSize, modTime, type, owner, std::move(targetId), std::move(fields.parentIds)};
 }
 
 
@@ -1013,25 +1125,123 @@ GdriveItemDetails getItemDetails(const std::string& itemId, const GdriveAccess&
     try
     {
         const JsonValue jvalue = parseJson(response); //throw JsonParsingError
+        GdriveItemFields fields = getItemFields(jvalue);
 
         //careful: do NOT return details about trashed items! they don't exist as far as FFS is concerned!!!
-        const std::optional<std::string> trashed = getPrimitiveFromJsonObject(jvalue, "trashed");
-        if (!trashed)
+        if (!fields.trashed)
             throw SysError(formatGdriveErrorRaw(response));
-        else if (*trashed == "true")
+        else if (*fields.trashed == "true")
             throw SysError(L"Item has been trashed.");
 
-        return extractItemDetails(jvalue); //throw SysError
+        return extractItemDetails(std::move(fields)); //throw SysError
     }
     catch (JsonParsingError&) { throw SysError(formatGdriveErrorRaw(response)); }
 }
 
 
+//stream-parse response while receiving: no JsonValue tree for large responses, e.g. 1000 items per folder listing page
+//returns beginning of response: for error messages only
+std::string gdriveHttpsRequestJson(const std::string& serverRelPath, JsonStreamCallback& cb, const GdriveAccess& access) //throw SysError, X
+{
+    const size_t responseHeadMax = 10'000; //error responses are small
+
+    std::string responseHead;
+    JsonStreamParser jsonParser(cb);
+    bool jsonValid = true;
+
+    gdriveHttpsRequest(serverRelPath, {} /*extraHeaders*/, {} /*extraOptions*/,
+                       [&](std::span<const char> buf)
+    {
+        if (responseHead.size() < responseHeadMax)
+            responseHead.append(buf.data(), std::min(buf.size(), responseHeadMax - responseHead.size()));
+
+        if (jsonValid)
+            try { jsonParser.feed(buf); } //throw JsonParsingError, X
+            catch (JsonParsingError&) { jsonValid = false; }
+    },
+    nullptr /*readRequest*/, nullptr /*receiveHeader*/, access); //throw SysError, X
+
+    if (jsonValid)
+        try { jsonParser.finish(); } //throw JsonParsingError, X
+        catch (JsonParsingError&) { jsonValid = false; }
+
+    if (!jsonValid)
+        throw SysError(formatGdriveErrorRaw(responseHead));
+    return responseHead;
+}
+
+
 struct GdriveItem
 {
     std::string itemId;
     GdriveItemDetails details;
 };
+class FolderContentPageParser : public JsonStreamCallback
+{
+public:
+    FolderContentPageParser(const std::string& folderId, std::vector<GdriveItem>& childItems) : folderId_(folderId), childItems_(childItems) {}
+
+    void onContainerBegin(std::span<const std::string> path, JsonValue::Type type) override //throw SysError
+    {
+        if (path.size() == 1 && path[0] == "files")
+            haveFiles_ = type == JsonValue::Type::array;
+        else if (isItemPath(path))
+        {
+            if (path.size() == 2)
+            {
+                if (type != JsonValue::Type::object)
+                    throw SysError(formatGdriveErrorRaw(serializeJson(JsonValue(type))));
+                item_ = {};
+            }
+            else
+                item_.addContainer(path.subspan(2));
+        }
+    }
+
+    void onContainerEnd(std::span<const std::string> path, JsonValue::Type type) override //throw SysError
+    {
+        if (path.size() == 2 && isItemPath(path))
+        {
+            if (!item_.itemId || item_.itemId->empty())
+                throw SysError(formatGdriveErrorRaw(serializeJson(toJson(item_))));
+
+            std::string itemId = std::move(*item_.itemId);
+            GdriveItemDetails itemDetails = extractItemDetails(std::move(item_)); //throw SysError
+            assert(std::find(itemDetails.parentIds.begin(), itemDetails.parentIds.end(), folderId_) != itemDetails.parentIds.end());
+
+            childItems_.push_back({std::move(itemId), std::move(itemDetails)});
+        }
+    }
+
+    void onValue(std::span<const std::string> path, JsonValue::Type type, std::string_view primVal) override //throw SysError
+    {
+        if (path.size() == 1)
+        {
+            if      (path[0] == "nextPageToken"   ) nextPageToken   .emplace(primVal);
+            else if (path[0] == "incompleteSearch") incompleteSearch.emplace(primVal);
+        }
+        else if (isItemPath(path))
+        {
+            if (path.size() == 2)
+                throw SysError(formatGdriveErrorRaw(std::string(primVal)));
+            item_.addValue(path.subspan(2), type, primVal);
+        }
+    }
+
+    std::optional<std::string> nextPageToken;
+    std::optional<std::string> incompleteSearch;
+    bool haveFiles() const { return haveFiles_; }
+
+private:
+    bool isItemPath(std::span<const std::string> path) const { return haveFiles_ && path.size() >= 2 && path[0] == "files"; }
+
+    const std::string& folderId_;
+    std::vector<GdriveItem>& childItems_;
+    bool haveFiles_ = false;
+    GdriveItemFields item_;
+};
+
+
 std::vector<GdriveItem> readFolderContent(const std::string& folderId, const GdriveAccess& access) //throw SysError
 {
     //https://developers.google.com/drive/api/v3/reference/files/list
@@ -1053,32 +1263,12 @@ std::vector<GdriveItem> readFolderContent(const std::string& folderId, const Gdr
             if (nextPageToken)
                 queryParams += '&' + xWwwFormUrlEncode({{"pageToken", *nextPageToken}});
 
-            std::string response;
-            gdriveHttpsRequest("/drive/v3/files?" + queryParams, {} /*extraHeaders*/, {} /*extraOptions*/,
-            [&](std::span<const char> buf) { response.append(buf.data(), buf.size()); },
-            nullptr /*readRequest*/, nullptr /*receiveHeader*/, access); //throw SysError
-
-            JsonValue jresponse;
-            try { jresponse = parseJson(response); }
-            catch (JsonParsingError&) {}
-
-            /**/                             nextPageToken    = getPrimitiveFromJsonObject(jresponse, "nextPageToken");
-            const std::optional<std::string> incompleteSearch = getPrimitiveFromJsonObject(jresponse, "incompleteSearch");
-            const JsonValue*                 files            = getChildFromJsonObject    (jresponse, "files");
-            if (!incompleteSearch || *incompleteSearch != "false" || !files || files->type != JsonValue::Type::array)
-                throw SysError(formatGdriveErrorRaw(response));
-
-            for (const JsonValue& childVal : files->arrayVal)
-            {
-                std::optional<std::string> itemId = getPrimitiveFromJsonObject(childVal, "id");
-                if (!itemId || itemId->empty())
-                    throw SysError(formatGdriveErrorRaw(serializeJson(childVal)));
+            FolderContentPageParser pageParser(folderId, childItems);
+            const std::string responseHead = gdriveHttpsRequestJson("/drive/v3/files?" + queryParams, pageParser, access); //throw SysError
 
-                GdriveItemDetails itemDetails(extractItemDetails(childVal)); //throw SysError
-                assert(std::find(itemDetails.parentIds.begin(), itemDetails.parentIds.end(), folderId) != itemDetails.parentIds.end());
-
-                childItems.push_back({std::move(*itemId), std::move(itemDetails)});
-            }
+            nextPageToken = std::move(pageParser.nextPageToken);
+            if (!pageParser.incompleteSearch || *pageParser.incompleteSearch != "false" || !pageParser.haveFiles())
+                throw SysError(formatGdriveErrorRaw(responseHead));
         }
         while (nextPageToken);
     }
@@ -1102,6 +1292,168 @@ struct ChangesDelta
     std::vector<FileChange> fileChanges;
     std::vector<DriveChange> driveChanges;
 };
+class ChangesPageParser : public JsonStreamCallback
+{
+public:
+    explicit ChangesPageParser(ChangesDelta& delta) : delta_(delta) {}
+
+    void onContainerBegin(std::span<const std::string> path, JsonValue::Type type) override //throw SysError
+    {
+        if (path.size() == 1 && path[0] == "changes")
+            haveChanges_ = type == JsonValue::Type::array;
+        else if (isChangePath(path))
+        {
+            if (path.size() == 2)
+            {
+                if (type != JsonValue::Type::object)
+                    throw SysError(formatGdriveErrorRaw(serializeJson(JsonValue(type))));
+                change_ = {};
+            }
+            else
+                addChangeField(path.subspan(2), [&](std::span<const std::string> fileRelPath) { change_.file.addContainer(fileRelPath); });
+        }
+    }
+
+    void onContainerEnd(std::span<const std::string> path, JsonValue::Type type) override //throw SysError
+    {
+        if (path.size() == 2 && isChangePath(path))
+            finishChange(); //throw SysError
+    }
+
+    void onValue(std::span<const std::string> path, JsonValue::Type type, std::string_view primVal) override //throw SysError
+    {
+        if (path.size() == 1)
+        {
+            if      (path[0] == "nextPageToken"    ) nextPageToken    .emplace(primVal);
+            else if (path[0] == "newStartPageToken") newStartPageToken.emplace(primVal);
+            else if (path[0] == "kind"             ) listKind         .emplace(primVal);
+        }
+        else if (isChangePath(path))
+        {
+            if (path.size() == 2)
+                throw SysError(formatGdriveErrorRaw(std::string(primVal)));
+
+            if (path.size() == 3)
+            {
+                if      (path[2] == "kind"      ) change_.kind      .emplace(primVal);
+                else if (path[2] == "changeType") change_.changeType.emplace(primVal);
+                else if (path[2] == "removed"   ) change_.removed   .emplace(primVal);
+                else if (path[2] == "fileId"    ) change_.fileId    .emplace(primVal);
+                else if (path[2] == "driveId"   ) change_.driveId   .emplace(primVal);
+            }
+            else if (path.size() == 4 && path[2] == "drive" && path[3] == "name")
+                change_.driveName.emplace(primVal);
+
+            addChangeField(path.subspan(2), [&](std::span<const std::string> fileRelPath) { change_.file.addValue(fileRelPath, type, primVal); });
+        }
+    }
+
+    std::optional<std::string> nextPageToken;
+    std::optional<std::string> newStartPageToken;
+    std::optional<std::string> listKind;
+    bool haveChanges() const { return haveChanges_; }
+
+private:
+    struct ChangeFields
+    {
+        std::optional<std::string> kind;
+        std::optional<std::string> changeType;
+        std::optional<std::string> removed;
+        std::optional<std::string> fileId;
+        std::optional<std::string> driveId;
+        bool haveFile = false;
+        GdriveItemFields file;
+        bool haveDrive = false;
+        std::optional<std::string> driveName;
+    };
+
+    bool isChangePath(std::span<const std::string> path) const { return haveChanges_ && path.size() >= 2 && path[0] == "changes"; }
+
+    template <class Function>
+    void addChangeField(std::span<const std::string> relPath, Function addFileField)
+    {
+        if (relPath[0] == "file")
+        {
+            change_.haveFile = true;
+            if (relPath.size() >= 2)
+                addFileField(relPath.subspan(1));
+        }
+        else if (relPath[0] == "drive")
+            change_.haveDrive = true;
+    }
+
+    void finishChange() //throw SysError
+    {
+        if (!change_.kind || *change_.kind != "drive#change" || !change_.changeType || !change_.removed)
+            throw SysError(formatGdriveErrorRaw(serializeJson(toJson(change_))));
+
+        if (*change_.changeType == "file")
+        {
+            if (!change_.fileId || change_.fileId->empty())
+                throw SysError(formatGdriveErrorRaw(serializeJson(toJson(change_))));
+
+            FileChange change;
+            change.itemId = *change_.fileId;
+            if (*change_.removed != "true")
+            {
+                if (!change_.haveFile || !change_.file.trashed)
+                    throw SysError(formatGdriveErrorRaw(serializeJson(toJson(change_))));
+
+                if (*change_.file.trashed != "true")
+                    change.details = extractItemDetails(std::move(change_.file)); //throw SysError
+            }
+            delta_.fileChanges.push_back(std::move(change));
+        }
+        else if (*change_.changeType == "drive")
+        {
+            if (!change_.driveId || change_.driveId->empty())
+                throw SysError(formatGdriveErrorRaw(serializeJson(toJson(change_))));
+
+            DriveChange change;
+            change.driveId = *change_.driveId;
+            if (*change_.removed != "true")
+            {
+                if (!change_.haveDrive || !change_.driveName || change_.driveName->empty())
+                    throw SysError(formatGdriveErrorRaw(serializeJson(toJson(change_))));
+
+                change.driveName = utfTo<Zstring>(*change_.driveName);
+            }
+            delta_.driveChanges.push_back(std::move(change));
+        }
+        else assert(false); //no other types (yet!)
+    }
+
+    static JsonValue toJson(const ChangeFields& fields) //for error messages
+    {
+        JsonValue jvalue(JsonValue::Type::object);
+        auto addPrimitive = [&](const char* name, const std::optional<std::string>& val)
+        {
+            if (val)
+                jvalue.objectVal.emplace(name, JsonValue(*val));
+        };
+        addPrimitive("kind",       fields.kind);
+        addPrimitive("changeType", fields.changeType);
+        addPrimitive("removed",    fields.removed);
+        addPrimitive("fileId",     fields.fileId);
+        addPrimitive("driveId",    fields.driveId);
+
+        if (fields.haveFile)
+            jvalue.objectVal.emplace("file", ::toJson(fields.file));
+        if (fields.haveDrive)
+        {
+            JsonValue& drive = jvalue.objectVal.emplace("drive", JsonValue::Type::object).first->second;
+            if (fields.driveName)
+                drive.objectVal.emplace("name", JsonValue(*fields.driveName));
+        }
+        return jvalue;
+    }
+
+    ChangesDelta& delta_;
+    bool haveChanges_ = false;
+    ChangeFields change_;
+};
+
+
 ChangesDelta getChangesDelta(const std::string& sharedDriveId /*empty for "My Drive"*/, const std::string& startPageToken, const GdriveAccess& access) //throw SysError
 {
     //https://developers.google.com/drive/api/v3/reference/changes/list
@@ -1124,84 +1476,18 @@ ChangesDelta getChangesDelta(const std::string& sharedDriveId /*empty for "My Dr
         if (!sharedDriveId.empty())
             queryParams += '&' + xWwwFormUrlEncode({{"driveId", sharedDriveId}}); //only allowed for shared drives!
 
-        std::string response;
-        gdriveHttpsRequest("/drive/v3/changes?" + queryParams, {} /*extraHeaders*/, {} /*extraOptions*/,
-        [&](std::span<const char> buf) { response.append(buf.data(), buf.size()); },
-        nullptr /*readRequest*/, nullptr /*receiveHeader*/, access); //throw SysError
-
-        JsonValue jresponse;
-        try { jresponse = parseJson(response); }
-        catch (JsonParsingError&) {}
-
-        /**/                             nextPageToken     = getPrimitiveFromJsonObject(jresponse, "nextPageToken");
-        const std::optional<std::string> newStartPageToken = getPrimitiveFromJsonObject(jresponse, "newStartPageToken");
-        const std::optional<std::string> listKind          = getPrimitiveFromJsonObject(jresponse, "kind");
-        const JsonValue*                 changes           = getChildFromJsonObject    (jresponse, "changes");
-
-        if (!!nextPageToken == !!newStartPageToken || //there can be only one
-            !listKind || *listKind != "drive#changeList" ||
-            !changes || changes->type != JsonValue::Type::array)
-            throw SysError(formatGdriveErrorRaw(response));
-
-        for (const JsonValue& childVal : changes->arrayVal)
-        {
-            const std::optional<std::string> kind       = getPrimitiveFromJsonObject(childVal, "kind");
-            const std::optional<std::string> changeType = getPrimitiveFromJsonObject(childVal, "changeType");
-            const std::optional<std::string> removed    = getPrimitiveFromJsonObject(childVal, "removed");
-            if (!kind || *kind != "drive#change" || !changeType || !removed)
-                throw SysError(formatGdriveErrorRaw(serializeJson(childVal)));
-
-            if (*changeType == "file")
-            {
-                std::optional<std::string> fileId = getPrimitiveFromJsonObject(childVal, "fileId");
-                if (!fileId || fileId->empty())
-                    throw SysError(formatGdriveErrorRaw(serializeJson(childVal)));
-
-                FileChange change;
-                change.itemId = std::move(*fileId);
-                if (*removed != "true")
-                {
-                    const JsonValue* file = getChildFromJsonObject(childVal, "file");
-                    if (!file)
-                        throw SysError(formatGdriveErrorRaw(serializeJson(childVal)));
-
-                    const std::optional<std::string> trashed = getPrimitiveFromJsonObject(*file, "trashed");
-                    if (!trashed)
-                        throw SysError(formatGdriveErrorRaw(serializeJson(childVal)));
+        ChangesPageParser pageParser(delta);
+        const std::string responseHead = gdriveHttpsRequestJson("/drive/v3/changes?" + queryParams, pageParser, access); //throw SysError
 
-                    if (*trashed != "true")
-                        change.details = extractItemDetails(*file); //throw SysError
-                }
-                delta.fileChanges.push_back(std::move(change));
-            }
-            else if (*changeType == "drive")
-            {
-                std::optional<std::string> driveId = getPrimitiveFromJsonObject(childVal, "driveId");
-                if (!driveId || driveId->empty())
-                    throw SysError(formatGdriveErrorRaw(serializeJson(childVal)));
-
-                DriveChange change;
-                change.driveId = std::move(*driveId);
-                if (*removed != "true")
-                {
-                    const JsonValue* drive = getChildFromJsonObject(childVal, "drive");
-                    if (!drive)
-                        throw SysError(formatGdriveErrorRaw(serializeJson(childVal)));
-
-                    const std::optional<std::string> name = getPrimitiveFromJsonObject(*drive, "name");
-                    if (!name || name->empty())
-                        throw SysError(formatGdriveErrorRaw(serializeJson(childVal)));
-
-                    change.driveName = utfTo<Zstring>(*name);
-                }
-                delta.driveChanges.push_back(std::move(change));
-            }
-            else assert(false); //no other types (yet!)
-        }
+        nextPageToken = std::move(pageParser.nextPageToken);
+        if (!!nextPageToken == !!pageParser.newStartPageToken || //there can be only one
+            !pageParser.listKind || *pageParser.listKind != "drive#changeList" ||
+            !pageParser.haveChanges())
+            throw SysError(formatGdriveErrorRaw(responseHead));
 
         if (!nextPageToken)
         {
-            delta.newStartPageToken = *newStartPageToken;
+            delta.newStartPageToken = *pageParser.newStartPageToken;
             return delta;
         }
     }
@@ -1697,86 +1983,298 @@ TODO:
 #endif
 
 
+//https://developers.google.com/drive/api/v3/manage-uploads#resumable
+std::string /*uploadUrlRelative*/ gdriveStartUploadSession(const Zstring& fileName, const std::string& parentId, std::optional<time_t> modTime, const GdriveAccess& access) //throw SysError
+{
+    //https://developers.google.com/drive/api/v3/folder#inserting_a_file_in_a_folder
+    const std::string& queryParams = xWwwFormUrlEncode(
+    {
+        {"supportsAllDrives", "true"},
+        {"uploadType", "resumable"},
+    });
+    JsonValue postParams(JsonValue::Type::object);
+    postParams.objectVal.emplace("name", utfTo<std::string>(fileName));
+    postParams.objectVal.emplace("parents", std::vector<JsonValue> {JsonValue(parentId)});
+    if (modTime) //convert to RFC 3339 date-time: e.g. "2018-09-29T08:39:12.053Z"
+    {
+        const std::string& modTimeRfc = utfTo<std::string>(formatTime(Zstr("%Y-%m-%dT%H:%M:%S.000Z"), getUtcTime(*modTime))); //returns empty string on error
+        if (modTimeRfc.empty())
+            throw SysError(L"Invalid modification time (time_t: " + numberTo<std::wstring>(*modTime) + L')');
+
+        postParams.objectVal.emplace("modifiedTime", modTimeRfc);
+    }
+    const std::string& postBuf = serializeJson(postParams, "" /*lineBreak*/, "" /*indent*/);
+    //---------------------------------------------------
+
+    std::string uploadUrl;
+
+    auto onHeaderData = [&](const std::string_view& header)
+    {
+        //"The callback will be called once for each header and only complete header lines are passed on to the callback" (including \r\n at the end)
+        if (startsWithAsciiNoCase(header, "Location:"))
+        {
+            uploadUrl = header;
+            uploadUrl = afterFirst(uploadUrl, ':', IfNotFoundReturn::none);
+            trim(uploadUrl);
+        }
+    };
+
+    std::string response;
+    const HttpSession::Result httpResult = gdriveHttpsRequest("/upload/drive/v3/files?" + queryParams,
+    {"Content-Type: application/json; charset=UTF-8"}, {{CURLOPT_POSTFIELDS, postBuf.c_str()}},
+    [&](std::span<const char> buf) { response.append(buf.data(), buf.size()); },
+    nullptr /*readRequest*/, onHeaderData, access); //throw SysError
+
+    if (httpResult.statusCode != 200)
+        throw SysError(formatGdriveErrorRaw(response));
+
+    const std::string serverUrl = getServerUrl(GOOGLE_REST_API_SERVER);
+    if (!startsWithAsciiNoCase(uploadUrl, serverUrl + '/'))
+        throw SysError(L"Invalid upload URL: " + utfTo<std::wstring>(uploadUrl)); //user should never see this
+
+    return uploadUrl.substr(serverUrl.size());
+}
+
+
+struct GdriveUploadStatus
+{
+    uint64_t bytesReceived = 0;
+    std::optional<std::string> itemId; //set if upload is complete
+};
+
+DEFINE_NEW_SYS_ERROR(SysErrorUploadExpired)
+//send file content [offset, offset + buf.size()) of a resumable upload session; empty "buf": query status (or complete upload if "totalSize" is known)
+//https://developers.google.com/drive/api/v3/manage-uploads#resume-upload
+GdriveUploadStatus gdriveSendUploadChunk(const std::string& uploadUrlRelative, uint64_t offset, std::span<const char> buf, std::optional<uint64_t> totalSize, int timeoutSec) //throw SysError, SysErrorUploadExpired
+{
+    const std::string totalSizeStr = totalSize ? numberTo<std::string>(*totalSize) : "*";
+    const std::string contentRange = buf.empty() ?
+                                     "Content-Range: bytes */" + totalSizeStr :
+                                     "Content-Range: bytes " + numberTo<std::string>(offset) + '-' + numberTo<std::string>(offset + buf.size() - 1) + '/' + totalSizeStr;
+
+    std::optional<uint64_t> bytesReceived;
+    auto onHeaderData = [&](const std::string_view& header)
+    {
+        if (startsWithAsciiNoCase(header, "Range:")) //e.g. "Range: bytes=0-42" => 43 bytes received
+        {
+            std::string range(header);
+            range = afterFirst(range, '-', IfNotFoundReturn::none);
+            trim(range);
+            bytesReceived = stringTo<uint64_t>(range) + 1;
+        }
+    };
+
+    size_t bytesSent = 0;
+    auto readRequest = [&](std::span<char> bufOut)
+    {
+        const size_t junkSize = std::min(bufOut.size(), buf.size() - bytesSent);
+        std::memcpy(bufOut.data(), buf.data() + bytesSent, junkSize);
+        bytesSent += junkSize;
+        return junkSize;
+    };
+
+    std::string response; //don't need "Authorization: Bearer": upload URL is valid for one week, regardless of access token expiry
+    const HttpSession::Result httpResult = googleHttpsRequest(GOOGLE_REST_API_SERVER, uploadUrlRelative, {contentRange},
+    {{CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(buf.size())}},
+    [&](std::span<const char> buf2) { response.append(buf2.data(), buf2.size()); }, readRequest, onHeaderData, timeoutSec); //throw SysError
+
+    if (httpResult.statusCode == 308) //"Resume Incomplete"
+        return {.bytesReceived = bytesReceived ? *bytesReceived : 0}; //no "Range" header: nothing received yet
+
+    if (httpResult.statusCode == 200 ||
+        httpResult.statusCode == 201)
+    {
+        JsonValue jresponse;
+        try { jresponse = parseJson(response); }
+        catch (JsonParsingError&) {}
+
+        if (std::optional<std::string> itemId = getPrimitiveFromJsonObject(jresponse, "id"))
+            return {.bytesReceived = totalSize ? *totalSize : offset + buf.size(), .itemId = std::move(itemId)};
+    }
+
+    if (httpResult.statusCode == 404 || //upload session is gone: can't resume
+        httpResult.statusCode == 410)
+        throw SysErrorUploadExpired(formatGdriveErrorRaw(response));
+
+    throw SysError(formatGdriveErrorRaw(response));
+}
+
+
 //file name already existing? => duplicate file created!
 //note: Google Drive upload is already transactional!
+/*  files larger than GDRIVE_UPLOAD_CHUNK_SIZE are sent in chunks: on error, the upload continues at the offset acknowledged by Google Drive
+    => only the current chunk must be buffered in memory
+    - resumeUrlRelative: upload session of a previous (failed) run; skip the bytes already received
+    - onUploadSession: called for multi-chunk uploads when the session URL changes (empty: don't resume) => caller persists it */
 std::string /*itemId*/ gdriveUploadFile(const Zstring& fileName, const std::string& parentId, std::optional<time_t> modTime, //throw SysError, X
                                         const std::function<size_t(void* buffer, size_t bytesToRead)>& tryReadBlock /*throw X*/, //returning 0 signals EOF: Posix read() semantics
+                                        const std::string& resumeUrlRelative,
+                                        const std::function<void(const std::string& uploadUrlRelative)>& onUploadSession /*throw X*/, //optional
                                         const GdriveAccess& access)
 {
-    //https://developers.google.com/drive/api/v3/folder#inserting_a_file_in_a_folder
-    //https://developers.google.com/drive/api/v3/manage-uploads#resumable
-
-    //step 1: initiate resumable upload session
     std::string uploadUrlRelative;
+    uint64_t chunkOffset = 0; //stream position of chunkBuf[0]
+    std::string chunkBuf;
+    bool eof = false;
+
+    auto readBlock = [&](size_t bytesToRead) //throw X
+    {
+        const size_t bufPos = chunkBuf.size();
+        chunkBuf.resize(bufPos + bytesToRead);
+        const size_t bytesRead = tryReadBlock(chunkBuf.data() + bufPos, bytesToRead); //throw X; may return short, only 0 means EOF!
+        chunkBuf.resize(bufPos + bytesRead);
+        if (bytesRead == 0)
+            eof = true;
+    };
+
+    if (!resumeUrlRelative.empty())
     {
-        const std::string& queryParams = xWwwFormUrlEncode(
-        {
-            {"supportsAllDrives", "true"},
-            {"uploadType", "resumable"},
-        });
-        JsonValue postParams(JsonValue::Type::object);
-        postParams.objectVal.emplace("name", utfTo<std::string>(fileName));
-        postParams.objectVal.emplace("parents", std::vector<JsonValue> {JsonValue(parentId)});
-        if (modTime) //convert to RFC 3339 date-time: e.g. "2018-09-29T08:39:12.053Z"
-        {
-            const std::string& modTimeRfc = utfTo<std::string>(formatTime(Zstr("%Y-%m-%dT%H:%M:%S.000Z"), getUtcTime(*modTime))); //returns empty string on error
-            if (modTimeRfc.empty())
-                throw SysError(L"Invalid modification time (time_t: " + numberTo<std::wstring>(*modTime) + L')');
+        std::optional<GdriveUploadStatus> status;
+        for (size_t errorCount = 0;;)
+            try
+            {
+                status = gdriveSendUploadChunk(resumeUrlRelative, 0, {} /*buf*/, std::nullopt /*totalSize*/, access.timeoutSec); //throw SysError, SysErrorUploadExpired
+                break;
+            }
+            catch (SysErrorUploadExpired&) //=> start over
+            {
+                if (onUploadSession) onUploadSession("");
+                break;
+            }
+            catch (SysError&) //temporary network/server error: keep upload session for next attempt
+            {
+                if (++errorCount > GDRIVE_UPLOAD_RETRY_MAX)
+                    throw;
+                interruptibleSleep(std::chrono::seconds(errorCount)); //throw ThreadStopRequest
+            }
 
-            postParams.objectVal.emplace("modifiedTime", modTimeRfc);
+        if (status)
+        {
+            //skip bytes received during previous run
+            while (chunkOffset < status->bytesReceived && !eof)
+            {
+                readBlock(static_cast<size_t>(std::min<uint64_t>(status->bytesReceived - chunkOffset, GDRIVE_BLOCK_SIZE_UPLOAD))); //throw X
+                chunkOffset += chunkBuf.size();
+                chunkBuf.clear();
+            }
+            if (status->itemId) //previous run completed the upload, but failed afterwards
+            {
+                while (!eof) //caller expects a fully consumed stream
+                {
+                    readBlock(GDRIVE_BLOCK_SIZE_UPLOAD); //throw X
+                    chunkBuf.clear();
+                }
+                return *status->itemId;
+            }
+            if (eof) //file content changed since previous run!?
+            {
+                if (onUploadSession) onUploadSession("");
+                throw SysError(L"Unexpected end of stream while resuming upload at " + numberTo<std::wstring>(status->bytesReceived) + L" bytes.");
+            }
+            uploadUrlRelative = resumeUrlRelative;
         }
-        const std::string& postBuf = serializeJson(postParams, "" /*lineBreak*/, "" /*indent*/);
-        //---------------------------------------------------
+    }
 
-        std::string uploadUrl;
+    //buffer one chunk (+ look-ahead) => detect last chunk *before* sending it
+    auto fillChunk = [&] //throw X
+    {
+        while (chunkBuf.size() <= GDRIVE_UPLOAD_CHUNK_SIZE && !eof)
+            readBlock(GDRIVE_BLOCK_SIZE_UPLOAD); //throw X
+    };
+    fillChunk(); //throw X
 
-        auto onHeaderData = [&](const std::string_view& header)
+    if (uploadUrlRelative.empty())
+    {
+        uploadUrlRelative = gdriveStartUploadSession(fileName, parentId, modTime, access); //throw SysError
+
+        if (eof) //fits into a single chunk: no need to resume => send compressed
         {
-            //"The callback will be called once for each header and only complete header lines are passed on to the callback" (including \r\n at the end)
-            if (startsWithAsciiNoCase(header, "Location:"))
+            //not officially documented, but Google Drive supports compressed file upload when "Content-Encoding: gzip" is set! :)))
+            InputStreamAsGzip gzipStream([&, bytesRead = size_t(0)](void* buffer, size_t bytesToRead) mutable
             {
-                uploadUrl = header;
-                uploadUrl = afterFirst(uploadUrl, ':', IfNotFoundReturn::none);
-                trim(uploadUrl);
-            }
-        };
+                const size_t junkSize = std::min(bytesToRead, chunkBuf.size() - bytesRead);
+                std::memcpy(buffer, chunkBuf.data() + bytesRead, junkSize);
+                bytesRead += junkSize;
+                return junkSize;
+            }, GDRIVE_BLOCK_SIZE_UPLOAD); //throw SysError
 
-        std::string response;
-        const HttpSession::Result httpResult = gdriveHttpsRequest("/upload/drive/v3/files?" + queryParams,
-        {"Content-Type: application/json; charset=UTF-8"}, {{CURLOPT_POSTFIELDS, postBuf.c_str()}},
-        [&](std::span<const char> buf) { response.append(buf.data(), buf.size()); },
-        nullptr /*readRequest*/, onHeaderData, access); //throw SysError
+            auto readRequest = [&](std::span<char> buf) { return gzipStream.read(buf.data(), buf.size()); }; //throw SysError
 
-        if (httpResult.statusCode != 200)
-            throw SysError(formatGdriveErrorRaw(response));
+            std::string response; //don't need "Authorization: Bearer":
+            googleHttpsRequest(GOOGLE_REST_API_SERVER, uploadUrlRelative, { "Content-Encoding: gzip" }, {} /*extraOptions*/,
+            [&](std::span<const char> buf) { response.append(buf.data(), buf.size()); }, readRequest,
+            nullptr /*receiveHeader*/, access.timeoutSec); //throw SysError
+
+            JsonValue jresponse;
+            try { jresponse = parseJson(response); }
+            catch (JsonParsingError&) {}
 
-        if (!startsWith(uploadUrl, "https://www.googleapis.com/"))
-            throw SysError(L"Invalid upload URL: " + utfTo<std::wstring>(uploadUrl)); //user should never see this
+            const std::optional<std::string> itemId = getPrimitiveFromJsonObject(jresponse, "id");
+            if (!itemId)
+                throw SysError(formatGdriveErrorRaw(response));
 
-        uploadUrlRelative = afterFirst(uploadUrl, "googleapis.com", IfNotFoundReturn::none);
+            return *itemId;
+        }
+        if (onUploadSession) onUploadSession(uploadUrlRelative); //throw X
     }
     //---------------------------------------------------
-    //step 2: upload file content
+    for (;;)
+    {
+        const bool lastChunk = chunkBuf.size() <= GDRIVE_UPLOAD_CHUNK_SIZE;
+        assert(lastChunk == eof);
+        const size_t chunkSize = lastChunk ? chunkBuf.size() : GDRIVE_UPLOAD_CHUNK_SIZE;
+        const std::optional<uint64_t> totalSize = lastChunk ? std::optional(chunkOffset + chunkSize) : std::nullopt;
 
-    //not officially documented, but Google Drive supports compressed file upload when "Content-Encoding: gzip" is set! :)))
-    InputStreamAsGzip gzipStream(tryReadBlock, GDRIVE_BLOCK_SIZE_UPLOAD); //throw SysError
+        size_t chunkPos = 0; //bytes acknowledged by Google Drive
+        bool queryStatus = false;
 
-    auto readRequest = [&](std::span<char> buf) { return gzipStream.read(buf.data(), buf.size()); }; //throw SysError, X
+        for (size_t errorCount = 0;;)
+            try
+            {
+                const GdriveUploadStatus status = queryStatus ?
+                                                  gdriveSendUploadChunk(uploadUrlRelative, 0, {} /*buf*/, totalSize, access.timeoutSec) : //throw SysError, SysErrorUploadExpired
+                                                  gdriveSendUploadChunk(uploadUrlRelative, chunkOffset + chunkPos, {chunkBuf.data() + chunkPos, chunkSize - chunkPos}, totalSize, access.timeoutSec); //throw SysError, SysErrorUploadExpired
+                if (status.itemId)
+                {
+                    if (!lastChunk) //Google Drive is making up a file size?
+                        throw SysError(L"Upload completed prematurely at " + numberTo<std::wstring>(chunkOffset + chunkPos) + L" bytes.");
+                    return *status.itemId;
+                }
 
-    std::string response; //don't need "Authorization: Bearer":
-    googleHttpsRequest(GOOGLE_REST_API_SERVER, uploadUrlRelative, { "Content-Encoding: gzip" }, {} /*extraOptions*/,
-    [&](std::span<const char> buf) { response.append(buf.data(), buf.size()); }, readRequest,
-    nullptr /*receiveHeader*/, access.timeoutSec); //throw SysError, X
+                if (status.bytesReceived < chunkOffset + chunkPos || //already sent data is lost: can't rewind stream
+                    status.bytesReceived > chunkOffset + chunkSize)
+                    throw SysError(L"Unexpected upload offset: " + numberTo<std::wstring>(status.bytesReceived) + L" bytes (expected: " +
+                                   numberTo<std::wstring>(chunkOffset + chunkPos) + L'-' + numberTo<std::wstring>(chunkOffset + chunkSize) + L')');
 
-    JsonValue jresponse;
-    try { jresponse = parseJson(response); }
-    catch (JsonParsingError&) {}
+                if (status.bytesReceived > chunkOffset + chunkPos)
+                    errorCount = 0;
+                else if (!queryStatus)
+                    throw SysError(L"Upload is not making progress at " + numberTo<std::wstring>(status.bytesReceived) + L" bytes.");
 
-    const std::optional<std::string> itemId = getPrimitiveFromJsonObject(jresponse, "id");
-    if (!itemId)
-        throw SysError(formatGdriveErrorRaw(response));
+                chunkPos = static_cast<size_t>(status.bytesReceived - chunkOffset);
+                queryStatus = false;
 
-    return *itemId;
+                if (!lastChunk && chunkPos == chunkSize)
+                    break;
+            }
+            catch (SysErrorUploadExpired&) //no point in retrying
+            {
+                if (onUploadSession) onUploadSession("");
+                throw;
+            }
+            catch (SysError&)
+            {
+                if (++errorCount > GDRIVE_UPLOAD_RETRY_MAX) //connection lost? server error? => ask what was received and continue from there
+                    throw;
+                interruptibleSleep(std::chrono::seconds(errorCount)); //throw ThreadStopRequest
+                queryStatus = true;
+            }
+
+        chunkBuf.erase(0, chunkSize); //keep look-ahead
+        chunkOffset += chunkSize;
+
+        fillChunk(); //throw X
+    }
 }
 
 
@@ -2552,6 +3050,93 @@ private:
     std::vector<StarredFolderDetails> starredFolders_;
 };
 
+
+//upload sessions of unfinished multi-chunk uploads: continue where a previous run (e.g. FreeFileSync was closed) stopped
+class GdriveUploadSessions
+{
+public:
+    struct FileId //file content is considered unchanged if size and modification time match
+    {
+        std::string parentId;
+        std::string fileName; //UTF8
+        uint64_t fileSize = 0;
+        int64_t modTime = 0;
+
+        std::strong_ordering operator<=>(const FileId&) const = default;
+    };
+
+    GdriveUploadSessions() {}
+
+    explicit GdriveUploadSessions(MemoryStreamIn& stream) //throw SysError
+    {
+        size_t sessionCount = readNumber<uint32_t>(stream); //SysErrorUnexpectedEos
+        while (sessionCount-- != 0)
+        {
+            FileId fileId;
+            fileId.parentId = readContainer<std::string>(stream); //
+            fileId.fileName = readContainer<std::string>(stream); //
+            fileId.fileSize = readNumber<uint64_t>(stream);       //SysErrorUnexpectedEos
+            fileId.modTime  = readNumber<int64_t>(stream);        //
+
+            UploadSession us;
+            us.uploadUrlRelative = readContainer<std::string>(stream); //SysErrorUnexpectedEos
+            us.startTime         = readNumber<int64_t>(stream);        //
+
+            sessions_.emplace(fileId, std::move(us));
+        }
+    }
+
+    void serialize(MemoryStreamOut& stream) const
+    {
+        const size_t activeCount = std::count_if(sessions_.begin(), sessions_.end(), [](const auto& item) { return !isExpired(item.second); });
+
+        writeNumber(stream, static_cast<uint32_t>(activeCount));
+        for (const auto& [fileId, us] : sessions_)
+            if (!isExpired(us))
+            {
+                writeContainer(stream, fileId.parentId);
+                writeContainer(stream, fileId.fileName);
+                writeNumber<uint64_t>(stream, fileId.fileSize);
+                writeNumber<int64_t >(stream, fileId.modTime);
+
+                writeContainer(stream, us.uploadUrlRelative);
+                writeNumber<int64_t>(stream, us.startTime);
+            }
+    }
+
+    std::string getUploadUrl(const FileId& fileId) const //empty if not existing or expired
+    {
+        if (auto it = sessions_.find(fileId);
+            it != sessions_.end() && !isExpired(it->second))
+            return it->second.uploadUrlRelative;
+        return {};
+    }
+
+    void setUploadUrl(const FileId& fileId, const std::string& uploadUrlRelative) //empty: remove
+    {
+        if (uploadUrlRelative.empty())
+            sessions_.erase(fileId);
+        else
+            sessions_.insert_or_assign(fileId, UploadSession{uploadUrlRelative, std::time(nullptr)});
+    }
+
+private:
+    struct UploadSession
+    {
+        std::string uploadUrlRelative;
+        time_t startTime = 0;
+    };
+
+    static bool isExpired(const UploadSession& us)
+    {
+        const time_t now = std::time(nullptr);
+        return now < us.startTime || //system clock changed?
+               now - us.startTime >= std::chrono::seconds(GDRIVE_UPLOAD_SESSION_MAX_AGE).count();
+    }
+
+    std::map<FileId, UploadSession> sessions_;
+};
+
 //==========================================================================================
 //==========================================================================================
 
@@ -2610,7 +3195,7 @@ public:
                 auto accessBuf = makeSharedRef<GdriveAccessBuffer>(accessInfo);
                 accessBuf.ref().setContextTimeout(timeoutSec2); //[!] used by GdriveDrivesBuffer()!
                 auto drivesBuf = makeSharedRef<GdriveDrivesBuffer>(accessBuf.ref()); //throw SysError
-                userSession = {accessBuf, drivesBuf};
+                userSession = {accessBuf, drivesBuf, makeSharedRef<GdriveUploadSessions>()};
             }
         });
 
@@ -2733,6 +3318,17 @@ public:
         return {access, stateDelta};
     }
 
+    void accessUploadSessions(const GdriveLogin& login, const std::function<void(GdriveUploadSessions& uploadSessions)>& useUploadSessions /*throw X*/) //throw SysError, X
+    {
+        accessUserSession(login.email, login.timeoutSec, [&](std::optional<UserSession>& userSession) //throw SysError
+        {
+            if (!userSession)
+                throw SysError(replaceCpy(_("Please add a connection to user account %x first."), L"%x", utfTo<std::wstring>(login.email)));
+
+            useUploadSessions(userSession->uploadsBuf.ref()); //throw X
+        });
+    }
+
 private:
     GdrivePersistentSessions           (const GdrivePersistentSessions&) = delete;
     GdrivePersistentSessions& operator=(const GdrivePersistentSessions&) = delete;
@@ -2779,6 +3375,7 @@ private:
         MemoryStreamOut streamOutBody;
         userSession.accessBuf.ref().serialize(streamOutBody);
         userSession.drivesBuf.ref().serialize(streamOutBody);
+        userSession.uploadsBuf.ref().serialize(streamOutBody);
 
         try
         {
@@ -2837,7 +3434,7 @@ private:
                 auto accessBuf = makeSharedRef<GdriveAccessBuffer>(streamIn2); //throw SysError
                 accessBuf.ref().setContextTimeout(timeoutSec2); //not used by GdriveDrivesBuffer(), but let's be consistent
                 auto drivesBuf = makeSharedRef<GdriveDrivesBuffer>(accessBuf.ref()); //throw SysError
-                return UserSession{accessBuf, drivesBuf};
+                return UserSession{accessBuf, drivesBuf, makeSharedRef<GdriveUploadSessions>()};
             }
             else
             {
@@ -2845,7 +3442,8 @@ private:
                     throw SysError(_("File content is corrupted.") + L" (invalid header)");
 
                 const int version = readNumber<int32_t>(streamIn); //throw SysErrorUnexpectedEos
-                if (version != 4 &&
+                if (version != 4 && //TODO: remove migration code at some time! 2021-05-15
+                    version != 5 && //TODO: remove migration code at some time! 2026-10-17
                     version != DB_FILE_VERSION)
                     throw SysError(_("Unsupported data format.") + L' ' + replaceCpy(_("Version: %x"), L"%x", numberTo<std::wstring>(version)));
 
@@ -2862,8 +3460,11 @@ private:
                     else
                         return makeSharedRef<GdriveDrivesBuffer>(streamInBody, accessBuf.ref()); //throw SysError
                 }();
+                auto uploadsBuf = version <= 5 ? //TODO: remove migration code at some time! 2026-10-17
+                                  makeSharedRef<GdriveUploadSessions>() :
+                                  makeSharedRef<GdriveUploadSessions>(streamInBody); //throw SysError
 
-                return UserSession{accessBuf, drivesBuf};
+                return UserSession{accessBuf, drivesBuf, uploadsBuf};
             }
         }
         catch (const SysError& e)
@@ -2876,6 +3477,7 @@ private:
     {
         SharedRef<GdriveAccessBuffer> accessBuf;
         SharedRef<GdriveDrivesBuffer> drivesBuf;
+        SharedRef<GdriveUploadSessions> uploadsBuf;
     };
 
     struct SessionHolder
@@ -2907,6 +3509,15 @@ GdrivePersistentSessions::AsyncAccessInfo accessGlobalFileState(const GdriveLogi
     throw SysError(formatSystemError("accessGlobalFileState", L"", L"Function call not allowed during init/shutdown."));
 }
 
+
+void accessGlobalUploadSessions(const GdriveLogin& login, const std::function<void(GdriveUploadSessions& uploadSessions)>& useUploadSessions /*throw X*/) //throw SysError, X
+{
+    if (const std::shared_ptr<GdrivePersistentSessions> gps = globalGdriveSessions.get())
+        return gps->accessUploadSessions(login, useUploadSessions); //throw SysError, X
+
+    throw SysError(formatSystemError("accessGlobalUploadSessions", L"", L"Function call not allowed during init/shutdown."));
+}
+
 //==========================================================================================
 //==========================================================================================
 
@@ -3006,22 +3617,28 @@ private:
 };
 
 
+/*  folder listings are read ahead by up to "parallelOps" threads (each using its own HTTP session)
+    => TraverserCallback is *not* thread-safe: all callbacks are still run on the calling thread, in FIFO order
+    => first comparison of deep hierarchies (before GdriveFileState is buffered) is no longer bound by request latency */
 class SingleFolderTraverser
 {
 public:
-    SingleFolderTraverser(const GdriveLogin& gdriveLogin, const std::vector<std::pair<AfsPath, std::shared_ptr<AFS::TraverserCallback>>>& workload /*throw X*/) :
-        gdriveLogin_(gdriveLogin), workload_(workload)
+    SingleFolderTraverser(const GdriveLogin& gdriveLogin, const std::vector<std::pair<AfsPath, std::shared_ptr<AFS::TraverserCallback>>>& workload /*throw X*/, size_t parallelOps) :
+        gdriveLogin_(gdriveLogin),
+        readAhead_(std::max<size_t>(parallelOps, 1), Zstr("Traverser: ") + utfTo<Zstring>(getGdriveDisplayPath({gdriveLogin, AfsPath()})))
     {
+        for (const auto& [folderPath, cb] : workload)
+            addWorkItem(folderPath, std::shared_ptr<AFS::TraverserCallback>(cb));
+
         while (!workload_.empty())
         {
-            auto wi = std::move(workload_.    back()); //yes, no strong exception guarantee (std::bad_alloc)
-            /**/                workload_.pop_back();  //
-            const auto& [folderPath, cb] = wi;
+            WorkItem wi = std::move(workload_.    front()); //yes, no strong exception guarantee (std::bad_alloc)
+            /**/                    workload_.pop_front();  //
 
             tryReportingDirError([&] //throw X
             {
-                traverseWithException(folderPath, *cb); //throw FileError, X
-            }, *cb);
+                traverseWithException(wi); //throw FileError, X
+            }, *wi.cb);
         }
     }
 
@@ -3029,9 +3646,35 @@ private:
     SingleFolderTraverser           (const SingleFolderTraverser&) = delete;
     SingleFolderTraverser& operator=(const SingleFolderTraverser&) = delete;
 
-    void traverseWithException(const AfsPath& folderPath, AFS::TraverserCallback& cb) //throw FileError, X
+    struct WorkItem
+    {
+        AfsPath folderPath;
+        std::shared_ptr<AFS::TraverserCallback> cb;
+        std::future<GetDirDetails::Result> futDirDetails; //invalid after first access
+    };
+
+    void addWorkItem(const AfsPath& folderPath, std::shared_ptr<AFS::TraverserCallback>&& cb)
+    {
+        std::packaged_task<GetDirDetails::Result()> pt(GetDirDetails({gdriveLogin_, folderPath})); //throw FileError
+        workload_.push_back(WorkItem{folderPath, std::move(cb), pt.get_future()});
+        readAhead_.run(std::move(pt));
+    }
+
+    void traverseWithException(WorkItem& wi) //throw FileError, X
     {
-        const std::vector<GdriveItem>& childItems = GetDirDetails({gdriveLogin_, folderPath})().childItems; //throw FileError
+        const AfsPath& folderPath = wi.folderPath;
+        AFS::TraverserCallback& cb = *wi.cb;
+
+        std::vector<GdriveItem> childItems;
+        if (wi.futDirDetails.valid())
+        {
+            while (wi.futDirDetails.wait_for(std::chrono::milliseconds(25)) == std::future_status::timeout)
+                interruptionPoint(); //throw ThreadStopRequest
+
+            childItems = wi.futDirDetails.get().childItems; //throw FileError
+        }
+        else //retry after error
+            childItems = GetDirDetails({gdriveLogin_, folderPath})().childItems; //throw FileError
 
         for (const GdriveItem& item : childItems)
         {
@@ -3047,7 +3690,7 @@ private:
                     if (std::shared_ptr<AFS::TraverserCallback> cbSub = cb.onFolder({itemName, false /*isFollowedSymlink*/})) //throw X
                     {
                         const AfsPath afsItemPath(appendPath(folderPath.value, itemName));
-                        workload_.push_back({afsItemPath, std::move(cbSub)});
+                        addWorkItem(afsItemPath, std::move(cbSub));
                     }
                     break;
 
@@ -3068,7 +3711,7 @@ private:
                             if (targetDetails.type == GdriveItemType::folder)
                             {
                                 if (std::shared_ptr<AFS::TraverserCallback> cbSub = cb.onFolder({itemName, true /*isFollowedSymlink*/})) //throw X
-                                    workload_.push_back({afsItemPath, std::move(cbSub)});
+                                    addWorkItem(afsItemPath, std::move(cbSub));
                             }
                             else //a file or named pipe, etc.
                                 cb.onFile({itemName, targetDetails.fileSize, targetDetails.modTime, getGdriveFilePrint(item.details.targetId), true /*isFollowedSymlink*/}); //throw X
@@ -3084,13 +3727,14 @@ private:
     }
 
     const GdriveLogin gdriveLogin_;
-    std::vector<std::pair<AfsPath, std::shared_ptr<AFS::TraverserCallback>>> workload_;
+    RingBuffer<WorkItem> workload_; //FIFO: same order as readAhead_
+    ThreadGroup<std::packaged_task<GetDirDetails::Result()>> readAhead_; //stop and join before workload_ goes out of scope
 };
 
 
-void gdriveTraverseFolderRecursive(const GdriveLogin& gdriveLogin, const std::vector<std::pair<AfsPath, std::shared_ptr<AFS::TraverserCallback>>>& workload /*throw X*/, size_t) //throw X
+void gdriveTraverseFolderRecursive(const GdriveLogin& gdriveLogin, const std::vector<std::pair<AfsPath, std::shared_ptr<AFS::TraverserCallback>>>& workload /*throw X*/, size_t parallelOps) //throw X
 {
-    SingleFolderTraverser dummy(gdriveLogin, workload); //throw X
+    SingleFolderTraverser dummy(gdriveLogin, workload, parallelOps); //throw X
 }
 //==========================================================================================
 //==========================================================================================
@@ -3185,7 +3829,7 @@ private:
 struct OutputStreamGdrive : public AFS::OutputStreamImpl
 {
     OutputStreamGdrive(const GdrivePath& gdrivePath,
-                       std::optional<uint64_t> /*streamSize*/,
+                       std::optional<uint64_t> streamSize,
                        std::optional<time_t> modTime,
                        std::unique_ptr<PathAccessLock>&& pal) : //throw SysError
         gdrivePath_(gdrivePath)
@@ -3209,7 +3853,7 @@ struct OutputStreamGdrive : public AFS::OutputStreamImpl
             parentId = ps.existingItemId;
         });
 
-        worker_ = InterruptibleThread([gdrivePath, modTime, fileName, asyncStreamIn = this->asyncStreamOut_,
+        worker_ = InterruptibleThread([gdrivePath, streamSize, modTime, fileName, asyncStreamIn = this->asyncStreamOut_,
                                        pFilePrint = std::move(promFilePrint),
                                        parentId   = std::move(parentId),
                                        aai        = std::move(aai),
@@ -3223,11 +3867,34 @@ struct OutputStreamGdrive : public AFS::OutputStreamImpl
                 {
                     return asyncStreamIn->tryRead(buffer, bytesToRead); //throw ThreadStopRequest
                 };
+                //resume upload of a previous run? requires file size and modification time to identify unchanged content
+                std::optional<GdriveUploadSessions::FileId> uploadFileId;
+                if (streamSize && modTime)
+                    uploadFileId = GdriveUploadSessions::FileId{parentId, utfTo<std::string>(fileName), *streamSize, *modTime};
+
+                std::string resumeUrlRelative;
+                if (uploadFileId)
+                    accessGlobalUploadSessions(gdrivePath.gdriveLogin, [&](GdriveUploadSessions& uploadSessions) //throw SysError
+                    {
+                        resumeUrlRelative = uploadSessions.getUploadUrl(*uploadFileId);
+                    });
+
+                auto onUploadSession = [&](const std::string& uploadUrlRelative) //throw SysError
+                {
+                    accessGlobalUploadSessions(gdrivePath.gdriveLogin, [&](GdriveUploadSessions& uploadSessions) //throw SysError
+                    {
+                        uploadSessions.setUploadUrl(*uploadFileId, uploadUrlRelative);
+                    });
+                };
+
                 //for whatever reason, gdriveUploadFile() is slightly faster than gdriveUploadSmallFile()! despite its two roundtrips! even when file sizes are 0!
                 //=> 1. issue likely on Google's side => 2. persists even after having fixed "Expect: 100-continue"
                 const std::string fileIdNew = //streamSize && *streamSize < 5 * 1024 * 1024 ?
                     //gdriveUploadSmallFile(fileName, parentId, *streamSize, modTime,    readBlock, aai.access) : //throw SysError, ThreadStopRequest
-                    gdriveUploadFile       (fileName, parentId,              modTime, tryReadBlock, aai.access);  //throw SysError, ThreadStopRequest
+                    gdriveUploadFile       (fileName, parentId,              modTime, tryReadBlock, resumeUrlRelative,
+                                            uploadFileId ? onUploadSession : std::function<void(const std::string&)>(), aai.access); //throw SysError, ThreadStopRequest
+                if (uploadFileId)
+                    onUploadSession(""); //throw SysError
                 assert(asyncStreamIn->getTotalBytesRead() == asyncStreamIn->getTotalBytesWritten());
                 //already existing: creates duplicate
 
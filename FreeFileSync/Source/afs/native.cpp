@@ -15,7 +15,9 @@
 #include <zen/guid.h>
 #include <zen/crc.h>
 #include "abstract_impl.h"
-#include "../base/icon_loader.h"
+#ifndef FFS_HEADLESS //ffs-cli: no GTK => no icons
+    #include "../base/icon_loader.h"
+#endif
 
     #include <sys/vfs.h> //statfs
 
@@ -646,22 +648,30 @@ private:
     //----------------------------------------------------------------------------------------------------------------
     FileIconHolder getFileIcon(const AfsPath& filePath, int pixelSize) const override //throw FileError; (optional return value)
     {
+#ifdef FFS_HEADLESS
+        return {};
+#else
         initComForThread(); //throw FileError
         try
         {
             return fff::getFileIcon(getNativePath(filePath), pixelSize); //throw SysError
         }
         catch (const SysError& e) { throw FileError(replaceCpy(_("Cannot read file %x."), L"%x", fmtPath(getDisplayPath(filePath))), e.toString()); }
+#endif
     }
 
     ImageHolder getThumbnailImage(const AfsPath& filePath, int pixelSize) const override //throw FileError; (optional return value)
     {
+#ifdef FFS_HEADLESS
+        return {};
+#else
         initComForThread(); //throw FileError
         try
         {
             return fff::getThumbnailImage(getNativePath(filePath), pixelSize); //throw SysError
         }
         catch (const SysError& e) { throw FileError(replaceCpy(_("Cannot read file %x."), L"%x", fmtPath(getDisplayPath(filePath))), e.toString()); }
+#endif
     }
 
     void authenticateAccess(const RequestPasswordFun& requestPassword /*throw X*/) const override //throw FileError, (X)
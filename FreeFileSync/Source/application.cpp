@@ -7,6 +7,7 @@
 #include "application.h"
 #include <memory>
 #include <zen/file_access.h>
+#include <zen/file_io.h>
 #include <zen/shutdown.h>
 #include <zen/process_exec.h>
 #include <zen/resolve_path.h>
@@ -120,8 +121,7 @@ bool Application::OnInit()
     try { localizationInit(appendPath(getResourceDirPath(), Zstr("Languages.zip"))); } //throw FileError
     catch (const FileError& e) { logExtraError(e.toString()); }
 
-    //parallel xBRZ-scaling! => run as early as possible
-    try { imageResourcesInit(appendPath(getResourceDirPath(), Zstr("Icons.zip"))); }
+    try { imageResourcesInit(appendPath(getResourceDirPath(), Zstr("Icons.zip")), appendPath(getConfigDirPath(), Zstr("IconCache.dat"))); }
     catch (const FileError& e) { logExtraError(e.toString()); } //not critical in this context
 
     //GTK should already have been initialized by wxWidgets (see \src\gtk\app.cpp:wxApp::Initialize)
@@ -493,6 +493,9 @@ void Application::runBatchMode(const FfsBatchConfig& batchCfg, const Zstring& cf
 
     const std::chrono::system_clock::time_point syncStartTime = std::chrono::system_clock::now();
 
+    if (!globalCfg.perfTraceFilePath.empty() || !globalCfg.perfMetricsFilePath.empty())
+        startPerfTrace();
+
     const WindowLayout::Dimensions progressDim
     {
         globalCfg.dpiLayouts[getDpiScalePercent()].progressDlg.size,
@@ -622,6 +625,20 @@ void Application::runBatchMode(const FfsBatchConfig& batchCfg, const Zstring& cf
                 catch (const FileError& e) { logMsg(r.errorLog.ref(), e.toString(), MSG_TYPE_ERROR); }
     }
 
+    //--------------------- export perf trace and metrics ----------------------
+    auto savePerfData = [&](const Zstring& filePathPhrase, const std::function<std::string()>& getContent)
+    {
+        if (const Zstring filePath = trimCpy(expandMacros(filePathPhrase));
+            !filePath.empty())
+            try
+            {
+                setFileContent(filePath, getContent(), nullptr /*notifyUnbufferedIO*/); //throw FileError
+            }
+            catch (const FileError& e) { logMsg(r.errorLog.ref(), e.toString(), MSG_TYPE_WARNING); }
+    };
+    savePerfData(globalCfg.perfTraceFilePath,   getPerfTraceChromeJson);
+    savePerfData(globalCfg.perfMetricsFilePath, getPerfMetricsPrometheus);
+
     //--------------------- save log file ----------------------
     std::set<AbstractPath> logsToKeepPaths;
     for (const ConfigFileItem& cfi : globalCfg.mainDlg.config.fileHistory)
@@ -959,10 +959,13 @@ template <FilterStrategy strategy>
 class ApplyPathFilter
 {
 public:
-    static void execute(ContainerObject& conObj, const PathFilter& filter) { ApplyPathFilter(conObj, filter); }
+    //skipFolder: optional perf hook => leave sub trees alone that the filter can't change
+    static void execute(ContainerObject& conObj, const PathFilter& filter, const std::function<bool(const FolderPair& folder)>& skipFolder = nullptr)
+    { ApplyPathFilter(conObj, filter, skipFolder); }
 
 private:
-    ApplyPathFilter(ContainerObject& conObj, const PathFilter& filter) : filter_(filter)  { recurse(conObj); }
+    ApplyPathFilter(ContainerObject& conObj, const PathFilter& filter, const std::function<bool(const FolderPair& folder)>& skipFolder) :
+        filter_(filter), skipFolder_(skipFolder) { recurse(conObj); }
 
     void recurse(ContainerObject& conObj) const
     {
@@ -988,6 +991,9 @@ private:
 
     void processDir(FolderPair& folder) const
     {
+        if (skipFolder_ && skipFolder_(folder))
+            return;
+
         bool childItemMightMatch = true;
         const bool filterPassed = folder.passDirFilter(filter_, &childItemMightMatch);
 
@@ -1006,6 +1012,7 @@ private:
     }
 
     const PathFilter& filter_;
+    const std::function<bool(const FolderPair& folder)>& skipFolder_;
 };
 
 
@@ -1101,7 +1108,17 @@ private:
 
 void fff::addHardFiltering(BaseFolderPair& baseFolder, const Zstring& excludeFilter)
 {
-    ApplyPathFilter<STRATEGY_AND>::execute(baseFolder, NameFilter(FilterConfig().includeFilter, excludeFilter));
+    const NameFilter filter(FilterConfig().includeFilter, excludeFilter);
+
+    //perf: e.g. excluding a single item via context menu shouldn't evaluate the filter for the full hierarchy
+    ApplyPathFilter<STRATEGY_AND>::execute(baseFolder, filter, [&](const FolderPair& folder)
+    {
+        const Zstring& relPathL = folder.getRelativePath<SelectSide::left >();
+        const Zstring& relPathR = folder.getRelativePath<SelectSide::right>();
+
+        return !filter.exclusionMightMatch(relPathL) &&
+               (relPathR == relPathL || !filter.exclusionMightMatch(relPathR));
+    });
 }
 
 
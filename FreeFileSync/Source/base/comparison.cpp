@@ -49,6 +49,7 @@ std::vector<FolderPairCfg> fff::extractCompareCfg(const MainConfiguration& mainC
             filter,
             syncCfg.directionCfg
         });
+        output.back().deviceParallelOps = mainCfg.deviceParallelOps;
     }
     return output;
 }
@@ -231,15 +232,55 @@ private:
 FolderComparison ComparisonBuffer::execute(const std::vector<std::pair<ResolvedFolderPair, FolderPairCfg>>& workLoad)
 {
     std::set<DirectoryKey> foldersToRead;
+    std::map<DirectoryKey, DirectoryValue> folderSnapshots;
+    std::map<AfsDevice, size_t> deviceParallelOps;
+
+    //folder used by *any* folder pair as sync source: don't use snapshot!
+    std::set<DirectoryKey> snapshotDenied;
+    for (const auto& [folderPair, fpCfg] : workLoad)
+        for (const SelectSide side : {SelectSide::left, SelectSide::right})
+            if (const AbstractPath& folderPath = side == SelectSide::left ? folderPair.folderPathLeft : folderPair.folderPathRight;
+                !snapshotSupported(folderPath, side, fpCfg.directionCfg, fpCfg.snapshotCfg))
+                snapshotDenied.insert({folderPath, fpCfg.filter.nameFilter, fpCfg.handleSymlinks});
+
+    auto addFolderToRead = [&](const AbstractPath& folderPath, const FolderPairCfg& fpCfg) //throw X
+    {
+        DirectoryKey folderKey{folderPath, fpCfg.filter.nameFilter, fpCfg.handleSymlinks};
+
+        size_t& parallelOps = deviceParallelOps[folderPath.afsDevice]; //folder pairs (e.g. of different jobs) may disagree: take max
+        parallelOps = std::max(parallelOps, getDeviceParallelOps(fpCfg.deviceParallelOps, folderPath.afsDevice));
+
+        if (!foldersToRead.contains(folderKey) && !folderSnapshots.contains(folderKey) &&
+            !snapshotDenied.contains(folderKey))
+        {
+            auto it = folderSnapshots.try_emplace(folderKey).first; //FolderContainer is not movable => load in place
+            bool snapshotLoaded = false;
+            try
+            {
+                snapshotLoaded = loadFolderSnapshot(folderKey, fpCfg.snapshotCfg, it->second.folderCont); //throw FileError
+            }
+            catch (const FileError& e) { cb_.logMessage(e.toString(), PhaseCallback::MsgType::warning); } //throw X; just a cache: fall back to traversal
+
+            if (snapshotLoaded)
+            {
+                cb_.logMessage(replaceCpy(_("Using folder snapshot instead of scanning %x"), L"%x", fmtPath(AFS::getDisplayPath(folderPath))),
+                               PhaseCallback::MsgType::info); //throw X
+                return;
+            }
+            folderSnapshots.erase(it);
+        }
+        foldersToRead.insert(std::move(folderKey));
+    };
+
     for (const auto& [folderPair, fpCfg] : workLoad)
         if (getBaseFolderStatus(folderPair.folderPathLeft ) != BaseFolderStatus::failure && //no need to list or display one-sided results if
             getBaseFolderStatus(folderPair.folderPathRight) != BaseFolderStatus::failure)   //*either* folder existence check fails
         {
             //+ only traverse *existing* folders
             if (getBaseFolderStatus(folderPair.folderPathLeft) == BaseFolderStatus::existing)
-                foldersToRead.emplace(DirectoryKey{folderPair.folderPathLeft,  fpCfg.filter.nameFilter, fpCfg.handleSymlinks});
+                addFolderToRead(folderPair.folderPathLeft, fpCfg); //throw X
             if (getBaseFolderStatus(folderPair.folderPathRight) == BaseFolderStatus::existing)
-                foldersToRead.emplace(DirectoryKey{folderPair.folderPathRight, fpCfg.filter.nameFilter, fpCfg.handleSymlinks});
+                addFolderToRead(folderPair.folderPathRight, fpCfg); //throw X
         }
 
     //------------------------------------------------------------------
@@ -254,10 +295,16 @@ FolderComparison ComparisonBuffer::execute(const std::vector<std::pair<ResolvedF
         cb_.updateStatus(textScanning + statusLine); //throw X
     };
 
-    folderBuffer_ = parallelFolderScan(foldersToRead,
-    [&](const PhaseCallback::ErrorInfo& errorInfo) { return cb_.reportError(errorInfo); }, //throw X
-    onStatusUpdate, //throw X
-    UI_UPDATE_INTERVAL / 2); //every ~25 ms
+    {
+        PerfTraceSpan perfPhase("phase", "Scan folders");
+
+        folderBuffer_ = parallelFolderScan(foldersToRead, deviceParallelOps,
+        [&](const PhaseCallback::ErrorInfo& errorInfo) { return cb_.reportError(errorInfo); }, //throw X
+        onStatusUpdate, //throw X
+        UI_UPDATE_INTERVAL / 2); //every ~25 ms
+
+        folderBuffer_.merge(folderSnapshots);
+    }
 
     //------------------------------------------------------------------
     const int64_t totalTimeSec = std::chrono::duration_cast<std::chrono::seconds>(scanTime.elapsed()).count();
@@ -274,9 +321,14 @@ FolderComparison ComparisonBuffer::execute(const std::vector<std::pair<ResolvedF
         if (fpCfg.compareVar == CompareVariant::content)
             workLoadByContent.push_back({folderPair, fpCfg});
 
-    std::vector<SharedRef<BaseFolderPair>> outputByContent = compareByContent(workLoadByContent);
+    std::vector<SharedRef<BaseFolderPair>> outputByContent = [&]
+    {
+        PerfTraceSpan perfPhase("phase", "Compare file content");
+        return compareByContent(workLoadByContent);
+    }();
     auto itOByC = outputByContent.begin();
 
+    PerfTraceSpan perfPhase("phase", "Merge");
     FolderComparison output;
 
     //write output in expected order
@@ -1071,6 +1123,8 @@ FolderComparison fff::compare(WarningDialogs& warnings,
                               const std::vector<FolderPairCfg>& fpCfgList,
                               ProcessCallback& callback /*throw X*/) //throw X
 {
+    PerfTraceSpan perfPhase("phase", "Compare");
+
     //indicator at the very beginning of the log to make sense of "total time"
     //init process: keep at beginning so that all GUI elements are initialized properly
     callback.initNewPhase(-1, -1, ProcessPhase::scan); //throw X; it's unknown how many files will be scanned => -1 objects
@@ -1183,9 +1237,11 @@ FolderComparison fff::compare(WarningDialogs& warnings,
         for (auto it = output.begin(); it != output.end(); ++it)
             directCfgs.emplace_back(&it->ref(), fpCfgList[it - output.begin()].directionCfg);
 
-        redetermineSyncDirection(directCfgs,
-                                 callback); //throw X
-
+        {
+            PerfTraceSpan perfDirections("phase", "Sync directions");
+            redetermineSyncDirection(directCfgs,
+                                     callback); //throw X
+        }
         return output;
     }
     catch (const std::bad_alloc& e)
@@ -11,6 +11,7 @@
 #include "process_callback.h"
 #include "norm_filter.h"
 #include "lock_holder.h"
+#include "folder_snapshot.h"
 
 
 namespace fff
@@ -42,6 +43,10 @@ struct FolderPairCfg
     NormalizedFilter filter;
 
     SyncDirectionConfig directionCfg;
+
+    SnapshotConfig snapshotCfg; //optional: skip traversal of remote folders, see folder_snapshot.h
+
+    std::map<AfsDevice, size_t> deviceParallelOps; //folder traversal
 };
 
 std::vector<FolderPairCfg> extractCompareCfg(const MainConfiguration& mainCfg); //fill FolderPairCfg and resolve folder pairs
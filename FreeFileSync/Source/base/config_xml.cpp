@@ -0,0 +1,573 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#include "config_xml.h"
+
+using namespace zen;
+using namespace fff;
+
+
+namespace
+{
+std::vector<Zstring> splitFilterByLines(Zstring filterPhrase)
+{
+    trim(filterPhrase);
+    if (filterPhrase.empty())
+        return {};
+
+    return splitCpy(filterPhrase, Zstr('\n'), SplitOnEmpty::allow);
+}
+
+Zstring mergeFilterLines(const std::vector<Zstring>& filterLines)
+{
+    Zstring out;
+    for (const Zstring& line : filterLines)
+    {
+        out += line;
+        out += Zstr('\n');
+    }
+    return trimCpy(out);
+}
+}
+
+
+void fff::readConfig(const XmlIn& in, FilterConfig& filter)
+{
+    std::vector<Zstring> tmpIn;
+    if (in["Include"](tmpIn)) //else: keep default value
+        filter.includeFilter = mergeFilterLines(tmpIn);
+
+    std::vector<Zstring> tmpEx;
+    if (in["Exclude"](tmpEx)) //else: keep default value
+        filter.excludeFilter = mergeFilterLines(tmpEx);
+
+    in["SizeMin"](filter.sizeMin);
+    in["SizeMin"].attribute("Unit", filter.unitSizeMin);
+
+    in["SizeMax"](filter.sizeMax);
+    in["SizeMax"].attribute("Unit", filter.unitSizeMax);
+
+    in["TimeSpan"](filter.timeSpan);
+    in["TimeSpan"].attribute("Type", filter.unitTimeSpan);
+}
+
+
+namespace
+{
+void readConfig(const XmlIn& in, CompConfig& cmpCfg)
+{
+    in["Variant" ](cmpCfg.compareVar);
+    in["Symlinks"](cmpCfg.handleSymlinks);
+
+    std::wstring timeShiftPhrase;
+    if (in["IgnoreTimeShift"](timeShiftPhrase))
+        cmpCfg.ignoreTimeShiftMinutes = fromTimeShiftPhrase(timeShiftPhrase);
+}
+
+
+void readConfig(const XmlIn& in, SyncDirectionConfig& dirCfg, int formatVer)
+{
+    if (formatVer < 21) //TODO: remove if parameter migration after some time! 2023-08-09
+    {
+        std::string varName;
+        in["Variant"](varName);
+        trim(varName);
+
+        if (varName == "TwoWay")
+            dirCfg = getDefaultSyncCfg(SyncVariant::twoWay);
+        else if (varName == "Mirror")
+        {
+            dirCfg = getDefaultSyncCfg(SyncVariant::mirror);
+
+            bool detectMovedFiles = false;
+            in["DetectMovedFiles"](detectMovedFiles);
+            if (detectMovedFiles)
+            {
+                if (const DirectionByDiff* diffDirs = std::get_if<DirectionByDiff>(&dirCfg.dirs))
+                    dirCfg.dirs = getChangesDirDefault(*diffDirs); //convert to "changes"-based mirror, so that move detection is enabled
+                else assert(false);
+            }
+        }
+        else if (varName == "Update")
+            dirCfg.dirs = DirectionByDiff
+        {
+            .leftOnly   = SyncDirection::right,
+            .rightOnly  = SyncDirection::none,
+            .leftNewer  = SyncDirection::right,
+            .rightNewer = SyncDirection::none, //note: will be fixed below for CompareVariant::content/size
+        };
+        else
+        {
+            assert(varName == "Custom");
+
+            dirCfg.dirs = DirectionByDiff();
+
+            XmlIn inCustDir = in["CustomDirections"];
+            inCustDir["LeftOnly"  ](std::get<DirectionByDiff>(dirCfg.dirs).leftOnly);
+            inCustDir["RightOnly" ](std::get<DirectionByDiff>(dirCfg.dirs).rightOnly);
+            inCustDir["LeftNewer" ](std::get<DirectionByDiff>(dirCfg.dirs).leftNewer);  //note: will be fixed below for CompareVariant::content/size
+            inCustDir["RightNewer"](std::get<DirectionByDiff>(dirCfg.dirs).rightNewer); //
+        }
+    }
+    else
+    {
+        if (XmlIn inDirs = in["Differences"])
+        {
+            dirCfg.dirs = DirectionByDiff();
+            inDirs.attribute("LeftOnly",   std::get<DirectionByDiff>(dirCfg.dirs).leftOnly);
+            inDirs.attribute("LeftNewer",  std::get<DirectionByDiff>(dirCfg.dirs).leftNewer);
+            inDirs.attribute("RightNewer", std::get<DirectionByDiff>(dirCfg.dirs).rightNewer);
+            inDirs.attribute("RightOnly",  std::get<DirectionByDiff>(dirCfg.dirs).rightOnly);
+        }
+        else
+        {
+            assert(in["Changes"]);
+            dirCfg.dirs = DirectionByChange();
+
+            XmlIn inDirsL = in["Changes"]["Left"];
+            inDirsL.attribute("Create", std::get<DirectionByChange>(dirCfg.dirs).left.create);
+            inDirsL.attribute("Update", std::get<DirectionByChange>(dirCfg.dirs).left.update);
+            inDirsL.attribute("Delete", std::get<DirectionByChange>(dirCfg.dirs).left.delete_);
+
+            XmlIn inDirsR = in["Changes"]["Right"];
+            inDirsR.attribute("Create", std::get<DirectionByChange>(dirCfg.dirs).right.create);
+            inDirsR.attribute("Update", std::get<DirectionByChange>(dirCfg.dirs).right.update);
+            inDirsR.attribute("Delete", std::get<DirectionByChange>(dirCfg.dirs).right.delete_);
+        }
+    }
+}
+
+
+void readConfig(const XmlIn& in, SyncConfig& syncCfg, std::map<AfsDevice, size_t>& deviceParallelOps, int formatVer)
+{
+    readConfig(in, syncCfg.directionCfg, formatVer);
+
+    in["DeletionPolicy"  ](syncCfg.deletionVariant);
+    in["VersioningFolder"](syncCfg.versioningFolderPhrase);
+
+    XmlIn verFolder = in["VersioningFolder"];
+
+    size_t parallelOps = 1;
+    if (verFolder.hasAttribute("Threads")) //*no error* if not available
+        verFolder.attribute("Threads", parallelOps); //try to get attribute
+
+    const size_t parallelOpsPrev = getDeviceParallelOps(deviceParallelOps, syncCfg.versioningFolderPhrase);
+    /**/                           setDeviceParallelOps(deviceParallelOps, syncCfg.versioningFolderPhrase, std::max(parallelOps, parallelOpsPrev));
+
+    in["VersioningFolder"].attribute("Style", syncCfg.versioningStyle);
+
+    if (syncCfg.versioningStyle != VersioningStyle::replace)
+    {
+        if (verFolder.hasAttribute("MaxAge")) //try to get attributes if available => *no error* if not available
+            verFolder.attribute("MaxAge", syncCfg.versionMaxAgeDays);
+
+        if (verFolder.hasAttribute("MinCount"))
+            verFolder.attribute("MinCount", syncCfg.versionCountMin); // => *no error* if not available
+        if (verFolder.hasAttribute("MaxCount"))
+            verFolder.attribute("MaxCount", syncCfg.versionCountMax); //
+    }
+}
+
+
+void readConfig(const XmlIn& in, LocalPairConfig& lpc, std::map<AfsDevice, size_t>& deviceParallelOps, int formatVer)
+{
+    //read folder pairs
+    in["Left" ](lpc.folderPathPhraseLeft);
+    in["Right"](lpc.folderPathPhraseRight);
+
+    size_t parallelOpsL = 1;
+    size_t parallelOpsR = 1;
+    if (in["Left" ].hasAttribute("Threads")) in["Left" ].attribute("Threads", parallelOpsL); //try to get attributes:
+    if (in["Right"].hasAttribute("Threads")) in["Right"].attribute("Threads", parallelOpsR); // => *no error* if not available
+
+    auto setParallelOps = [&](const Zstring& folderPathPhrase, size_t parallelOps)
+    {
+        const size_t parallelOpsPrev = getDeviceParallelOps(deviceParallelOps, folderPathPhrase);
+        /**/                           setDeviceParallelOps(deviceParallelOps, folderPathPhrase, std::max(parallelOps, parallelOpsPrev));
+    };
+    setParallelOps(lpc.folderPathPhraseLeft,  parallelOpsL);
+    setParallelOps(lpc.folderPathPhraseRight, parallelOpsR);
+
+    //TODO: remove after migration! 2020-04-24
+    if (formatVer < 16)
+    {
+        replaceAsciiNoCase(lpc.folderPathPhraseLeft,  Zstr("%weekday%"), Zstr("%WeekDayName%"));
+        replaceAsciiNoCase(lpc.folderPathPhraseRight, Zstr("%weekday%"), Zstr("%WeekDayName%"));
+    }
+
+    //###########################################################
+    //alternate comp configuration (optional)
+    if (XmlIn inLocalCmp = in["Compare"])
+    {
+        CompConfig cmpCfg;
+        readConfig(inLocalCmp, cmpCfg);
+
+        lpc.localCmpCfg = cmpCfg;
+    }
+    //###########################################################
+    //alternate sync configuration (optional)
+    if (XmlIn inLocalSync = in["Synchronize"])
+    {
+        SyncConfig syncCfg;
+        readConfig(inLocalSync, syncCfg, deviceParallelOps, formatVer);
+
+        lpc.localSyncCfg = syncCfg;
+    }
+
+    //###########################################################
+    //alternate filter configuration
+    if (XmlIn inLocFilter = in["Filter"])
+        readConfig(inLocFilter, lpc.localFilter);
+}
+}
+
+
+void fff::readConfig(const XmlIn& in, MainConfiguration& mainCfg, int formatVer)
+{
+    ::readConfig(in["Compare"], mainCfg.cmpCfg);
+
+    ::readConfig(in["Synchronize"], mainCfg.syncCfg, mainCfg.deviceParallelOps, formatVer);
+
+    if (formatVer < 20) //TODO: remove if parameter migration after some time! 2023-08-09
+        if (mainCfg.cmpCfg.compareVar == CompareVariant::content ||
+            mainCfg.cmpCfg.compareVar == CompareVariant::size)
+            if (std::string varName;
+                in["Synchronize"]["Variant"](varName))
+            {
+                if (varName == "Update")
+                    std::get<DirectionByDiff>(mainCfg.syncCfg.directionCfg.dirs).rightNewer = SyncDirection::right;
+                else if (varName == "Custom")
+                {
+                    SyncDirection different = SyncDirection::none;
+                    in["Synchronize"]["CustomDirections"]["Different"](different);
+
+                    std::get<DirectionByDiff>(mainCfg.syncCfg.directionCfg.dirs).leftNewer =
+                        std::get<DirectionByDiff>(mainCfg.syncCfg.directionCfg.dirs).rightNewer = different;
+                }
+            }
+
+    if (formatVer < 23) //TODO: remove if parameter migration after some time! 2023-08-24
+    {
+        bool detectMovedFiles = false;
+        in["Synchronize"]["DetectMovedFiles"](detectMovedFiles);
+        if (detectMovedFiles)
+            if (getSyncVariant(mainCfg.syncCfg.directionCfg) == SyncVariant::mirror)
+            {
+                if (const DirectionByDiff* diffDirs = std::get_if<DirectionByDiff>(&mainCfg.syncCfg.directionCfg.dirs))
+                    mainCfg.syncCfg.directionCfg.dirs = getChangesDirDefault(*diffDirs); //convert to "changes"-based mirror, so that move detection is enabled
+                else assert(false);
+            }
+    }
+
+    ::readConfig(in["Filter"], mainCfg.globalFilter);
+
+    //###########################################################
+    //read folder pairs
+    bool firstItem = true;
+    in["FolderPairs"].visitChildren([&](const XmlIn& inPair)
+    {
+        assert(*inPair.getName() == "Pair");
+
+        LocalPairConfig lpc;
+        ::readConfig(inPair, lpc, mainCfg.deviceParallelOps, formatVer);
+
+        if (formatVer < 20) //TODO: remove if parameter migration after some time! 2023-08-09
+            if (lpc.localSyncCfg)
+            {
+                const CompConfig& cmpCfg = lpc.localCmpCfg ? *lpc.localCmpCfg : mainCfg.cmpCfg;
+                if (cmpCfg.compareVar == CompareVariant::content ||
+                    cmpCfg.compareVar == CompareVariant::size)
+                    if (std::string varName;
+                        inPair["Synchronize"]["Variant"](varName))
+                    {
+                        if (varName == "Update")
+                            std::get<DirectionByDiff>(lpc.localSyncCfg->directionCfg.dirs).rightNewer = SyncDirection::right;
+                        else if (varName == "Custom")
+                            if (inPair["Synchronize"]["CustomDirections"]["Different"])
+                            {
+                                SyncDirection different = SyncDirection::none;
+                                inPair["Synchronize"]["CustomDirections"]["Different"](different);
+
+                                std::get<DirectionByDiff>(lpc.localSyncCfg->directionCfg.dirs).leftNewer =
+                                    std::get<DirectionByDiff>(lpc.localSyncCfg->directionCfg.dirs).rightNewer = different;
+                            }
+                    }
+            }
+        if (formatVer < 23) //TODO: remove if parameter migration after some time! 2023-08-24
+            if (lpc.localSyncCfg)
+            {
+                bool detectMovedFiles = false;
+                inPair["Synchronize"]["DetectMovedFiles"](detectMovedFiles);
+                if (detectMovedFiles)
+                    if (getSyncVariant(lpc.localSyncCfg->directionCfg) == SyncVariant::mirror)
+                    {
+                        if (const DirectionByDiff* diffDirs = std::get_if<DirectionByDiff>(&lpc.localSyncCfg->directionCfg.dirs))
+                            lpc.localSyncCfg->directionCfg.dirs = getChangesDirDefault(*diffDirs); //convert to "changes"-based mirror, so that move detection is enabled
+                        else assert(false);
+                    }
+            }
+
+        if (firstItem)
+        {
+            firstItem = false;
+            mainCfg.firstPair = lpc;
+            mainCfg.additionalPairs.clear();
+        }
+        else
+            mainCfg.additionalPairs.push_back(lpc);
+    });
+
+    in["Errors"].attribute("Ignore", mainCfg.ignoreErrors);
+    in["Errors"].attribute("Retry",  mainCfg.autoRetryCount);
+    in["Errors"].attribute("Delay",  mainCfg.autoRetryDelay);
+
+    in["PostSyncCommand"](mainCfg.postSyncCommand);
+    in["PostSyncCommand"].attribute("Condition", mainCfg.postSyncCondition);
+
+    in["LogFolder"](mainCfg.altLogFolderPathPhrase);
+
+    //TODO: remove after migration! 2020-04-24
+    if (formatVer < 16)
+        replaceAsciiNoCase(mainCfg.altLogFolderPathPhrase,  Zstr("%weekday%"), Zstr("%WeekDayName%"));
+
+    //TODO: remove if parameter migration after some time! 2020-01-30
+    if (formatVer < 15)
+        ;
+    else
+    {
+        in["EmailNotification"](mainCfg.emailNotifyAddress);
+        in["EmailNotification"].attribute("Condition", mainCfg.emailNotifyCondition);
+    }
+}
+
+//################################################################################################
+
+namespace
+{
+void writeConfig(const CompConfig& cmpCfg, XmlOut& out)
+{
+    out["Variant" ](cmpCfg.compareVar);
+    out["Symlinks"](cmpCfg.handleSymlinks);
+    out["IgnoreTimeShift"](toTimeShiftPhrase(cmpCfg.ignoreTimeShiftMinutes));
+}
+
+
+void writeConfig(const SyncDirectionConfig& dirCfg, XmlOut& out)
+{
+    if (const DirectionByDiff* diffDirs = std::get_if<DirectionByDiff>(&dirCfg.dirs))
+    {
+        XmlOut outDirs = out["Differences"];
+        outDirs.attribute("LeftOnly",   diffDirs->leftOnly);
+        outDirs.attribute("LeftNewer",  diffDirs->leftNewer);
+        outDirs.attribute("RightNewer", diffDirs->rightNewer);
+        outDirs.attribute("RightOnly",  diffDirs->rightOnly);
+    }
+    else
+    {
+        const DirectionByChange& changeDirs = std::get<DirectionByChange>(dirCfg.dirs);
+
+        XmlOut outDirsL = out["Changes"]["Left"];
+        outDirsL.attribute("Create", changeDirs.left.create);
+        outDirsL.attribute("Update", changeDirs.left.update);
+        outDirsL.attribute("Delete", changeDirs.left.delete_);
+
+        XmlOut outDirsR = out["Changes"]["Right"];
+        outDirsR.attribute("Create", changeDirs.right.create);
+        outDirsR.attribute("Update", changeDirs.right.update);
+        outDirsR.attribute("Delete", changeDirs.right.delete_);
+    }
+}
+
+
+void writeConfig(const SyncConfig& syncCfg, const std::map<AfsDevice, size_t>& deviceParallelOps, XmlOut& out)
+{
+    writeConfig(syncCfg.directionCfg, out);
+
+    out["DeletionPolicy"  ](syncCfg.deletionVariant);
+    out["VersioningFolder"](syncCfg.versioningFolderPhrase);
+
+    const size_t parallelOps = getDeviceParallelOps(deviceParallelOps, syncCfg.versioningFolderPhrase);
+    if (parallelOps > 1) out["VersioningFolder"].attribute("Threads", parallelOps);
+
+    out["VersioningFolder"].attribute("Style", syncCfg.versioningStyle);
+
+    if (syncCfg.versioningStyle != VersioningStyle::replace)
+    {
+        if (syncCfg.versionMaxAgeDays > 0) out["VersioningFolder"].attribute("MaxAge",   syncCfg.versionMaxAgeDays);
+        if (syncCfg.versionCountMin   > 0) out["VersioningFolder"].attribute("MinCount", syncCfg.versionCountMin);
+        if (syncCfg.versionCountMax   > 0) out["VersioningFolder"].attribute("MaxCount", syncCfg.versionCountMax);
+    }
+}
+}
+
+
+void fff::writeConfig(const FilterConfig& filter, XmlOut& out)
+{
+    out["Include"](splitFilterByLines(filter.includeFilter));
+    out["Exclude"](splitFilterByLines(filter.excludeFilter));
+
+    out["SizeMin"](filter.sizeMin);
+    out["SizeMin"].attribute("Unit", filter.unitSizeMin);
+
+    out["SizeMax"](filter.sizeMax);
+    out["SizeMax"].attribute("Unit", filter.unitSizeMax);
+
+    out["TimeSpan"](filter.timeSpan);
+    out["TimeSpan"].attribute("Type", filter.unitTimeSpan);
+}
+
+
+namespace
+{
+void writeConfig(const LocalPairConfig& lpc, const std::map<AfsDevice, size_t>& deviceParallelOps, XmlOut& out)
+{
+    XmlOut outPair = out.addChild("Pair");
+
+    //read folder pairs
+    outPair["Left" ](lpc.folderPathPhraseLeft);
+    outPair["Right"](lpc.folderPathPhraseRight);
+
+    const size_t parallelOpsL = getDeviceParallelOps(deviceParallelOps, lpc.folderPathPhraseLeft);
+    const size_t parallelOpsR = getDeviceParallelOps(deviceParallelOps, lpc.folderPathPhraseRight);
+
+    if (parallelOpsL > 1) outPair["Left" ].attribute("Threads", parallelOpsL);
+    if (parallelOpsR > 1) outPair["Right"].attribute("Threads", parallelOpsR);
+
+    //avoid "fake" changed configs by only storing "real" parallel-enabled devices in deviceParallelOps
+    assert(std::all_of(deviceParallelOps.begin(), deviceParallelOps.end(), [](const auto& item) { return item.second > 1; }));
+
+    //###########################################################
+    //alternate comp configuration (optional)
+    if (lpc.localCmpCfg)
+    {
+        XmlOut outLocalCmp = outPair["Compare"];
+        writeConfig(*lpc.localCmpCfg, outLocalCmp);
+    }
+    //###########################################################
+    //alternate sync configuration (optional)
+    if (lpc.localSyncCfg)
+    {
+        XmlOut outLocalSync = outPair["Synchronize"];
+        writeConfig(*lpc.localSyncCfg, deviceParallelOps, outLocalSync);
+    }
+
+    //###########################################################
+    //alternate filter configuration
+    if (lpc.localFilter != FilterConfig()) //don't spam .ffs_gui file with default filter entries
+    {
+        XmlOut outFilter = outPair["Filter"];
+        writeConfig(lpc.localFilter, outFilter);
+    }
+}
+}
+
+
+void fff::writeConfig(const MainConfiguration& mainCfg, XmlOut& out)
+{
+    XmlOut outCmp = out["Compare"];
+    ::writeConfig(mainCfg.cmpCfg, outCmp);
+    //###########################################################
+
+    XmlOut outSync = out["Synchronize"];
+    ::writeConfig(mainCfg.syncCfg, mainCfg.deviceParallelOps, outSync);
+    //###########################################################
+
+    XmlOut outFilter = out["Filter"];
+    ::writeConfig(mainCfg.globalFilter, outFilter);
+
+    //###########################################################
+    XmlOut outFp = out["FolderPairs"];
+    //write folder pairs
+    ::writeConfig(mainCfg.firstPair, mainCfg.deviceParallelOps, outFp);
+
+    for (const LocalPairConfig& lpc : mainCfg.additionalPairs)
+        ::writeConfig(lpc, mainCfg.deviceParallelOps, outFp);
+
+    out["Errors"].attribute("Ignore", mainCfg.ignoreErrors);
+    out["Errors"].attribute("Retry",  mainCfg.autoRetryCount);
+    out["Errors"].attribute("Delay",  mainCfg.autoRetryDelay);
+
+    out["PostSyncCommand"](mainCfg.postSyncCommand);
+    out["PostSyncCommand"].attribute("Condition", mainCfg.postSyncCondition);
+
+    out["LogFolder"](mainCfg.altLogFolderPathPhrase);
+
+    out["EmailNotification"](mainCfg.emailNotifyAddress);
+    out["EmailNotification"].attribute("Condition", mainCfg.emailNotifyCondition);
+}
+
+
+void fff::readConfig(const XmlIn& in, GlobalSyncConfig& cfg, int formatVer)
+{
+    XmlIn in2 = in;
+
+    if (in["General"]) //TODO: remove old parameter after migration! 2020-12-03
+        in2 = in["General"];
+
+    in2["FailSafeFileCopy"         ].attribute("Enabled", cfg.failSafeFileCopy);
+    in2["CopyLockedFiles"          ].attribute("Enabled", cfg.copyLockedFiles);
+    in2["CopyFilePermissions"      ].attribute("Enabled", cfg.copyFilePermissions);
+    in2["FileTimeTolerance"        ].attribute("Seconds", cfg.fileTimeTolerance);
+    in2["RunWithBackgroundPriority"].attribute("Enabled", cfg.runWithBackgroundPriority);
+    in2["LockDirectoriesDuringSync"].attribute("Enabled", cfg.createLockFile);
+    in2["VerifyCopiedFiles"        ].attribute("Enabled", cfg.verifyFileCopy);
+    in2["LogFiles"                 ].attribute("MaxAge",  cfg.logfilesMaxAgeDays);
+    in2["LogFiles"                 ].attribute("Format",  cfg.logFormat);
+
+    if (in2["PerfMetrics"]) //optional: not written unless set
+    {
+        in2["PerfMetrics"].attribute("TraceFile",      cfg.perfTraceFilePath);
+        in2["PerfMetrics"].attribute("PrometheusFile", cfg.perfMetricsFilePath);
+    }
+
+    XmlIn inOpt = in2["OptionalDialogs"];
+    inOpt["WarnFolderNotExisting"         ].attribute("Show", cfg.warnDlgs.warnFolderNotExisting);
+    inOpt["WarnFoldersDifferInCase"       ].attribute("Show", cfg.warnDlgs.warnFoldersDifferInCase);
+    inOpt["WarnUnresolvedConflicts"       ].attribute("Show", cfg.warnDlgs.warnUnresolvedConflicts);
+    inOpt["WarnNotEnoughDiskSpace"        ].attribute("Show", cfg.warnDlgs.warnNotEnoughDiskSpace);
+    inOpt["WarnSignificantDifference"     ].attribute("Show", cfg.warnDlgs.warnSignificantDifference);
+    inOpt["WarnRecycleBinNotAvailable"    ].attribute("Show", cfg.warnDlgs.warnRecyclerMissing);
+    inOpt["WarnDependentFolderPair"       ].attribute("Show", cfg.warnDlgs.warnDependentFolderPair);
+    inOpt["WarnDependentBaseFolders"      ].attribute("Show", cfg.warnDlgs.warnDependentBaseFolders);
+    inOpt["WarnDirectoryLockFailed"       ].attribute("Show", cfg.warnDlgs.warnDirectoryLockFailed);
+    inOpt["WarnVersioningFolderPartOfSync"].attribute("Show", cfg.warnDlgs.warnVersioningFolderPartOfSync);
+
+    //TODO: remove after migration! 2022-08-26
+    if (formatVer < 25)
+        cfg.warnDlgs.warnDependentBaseFolders = true; //new semantics! should not be ignored
+}
+
+
+void fff::writeConfig(const GlobalSyncConfig& cfg, XmlOut& out)
+{
+    out["FailSafeFileCopy"         ].attribute("Enabled", cfg.failSafeFileCopy);
+    out["CopyLockedFiles"          ].attribute("Enabled", cfg.copyLockedFiles);
+    out["CopyFilePermissions"      ].attribute("Enabled", cfg.copyFilePermissions);
+    out["FileTimeTolerance"        ].attribute("Seconds", cfg.fileTimeTolerance);
+    out["RunWithBackgroundPriority"].attribute("Enabled", cfg.runWithBackgroundPriority);
+    out["LockDirectoriesDuringSync"].attribute("Enabled", cfg.createLockFile);
+    out["VerifyCopiedFiles"        ].attribute("Enabled", cfg.verifyFileCopy);
+    out["LogFiles"                 ].attribute("MaxAge",  cfg.logfilesMaxAgeDays);
+    out["LogFiles"                 ].attribute("Format",  cfg.logFormat);
+
+    if (!cfg.perfTraceFilePath.empty() || !cfg.perfMetricsFilePath.empty())
+    {
+        out["PerfMetrics"].attribute("TraceFile",      cfg.perfTraceFilePath);
+        out["PerfMetrics"].attribute("PrometheusFile", cfg.perfMetricsFilePath);
+    }
+
+    XmlOut outOpt = out["OptionalDialogs"];
+    outOpt["WarnFolderNotExisting"         ].attribute("Show", cfg.warnDlgs.warnFolderNotExisting);
+    outOpt["WarnFoldersDifferInCase"       ].attribute("Show", cfg.warnDlgs.warnFoldersDifferInCase);
+    outOpt["WarnUnresolvedConflicts"       ].attribute("Show", cfg.warnDlgs.warnUnresolvedConflicts);
+    outOpt["WarnNotEnoughDiskSpace"        ].attribute("Show", cfg.warnDlgs.warnNotEnoughDiskSpace);
+    outOpt["WarnSignificantDifference"     ].attribute("Show", cfg.warnDlgs.warnSignificantDifference);
+    outOpt["WarnRecycleBinNotAvailable"    ].attribute("Show", cfg.warnDlgs.warnRecyclerMissing);
+    outOpt["WarnDependentFolderPair"       ].attribute("Show", cfg.warnDlgs.warnDependentFolderPair);
+    outOpt["WarnDependentBaseFolders"      ].attribute("Show", cfg.warnDlgs.warnDependentBaseFolders);
+    outOpt["WarnDirectoryLockFailed"       ].attribute("Show", cfg.warnDlgs.warnDirectoryLockFailed);
+    outOpt["WarnVersioningFolderPartOfSync"].attribute("Show", cfg.warnDlgs.warnVersioningFolderPartOfSync);
+}
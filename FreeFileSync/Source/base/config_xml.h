@@ -0,0 +1,370 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#ifndef CONFIG_XML_H_3871450982374509823
+#define CONFIG_XML_H_3871450982374509823
+
+#include <zenxml/xml.h>
+#include "structures.h"
+
+
+namespace fff
+{
+//XML (de-)serialization of the sync settings shared by .ffs_gui/.ffs_batch files, GlobalSettings.xml and the headless ffs-cli
+//=> keep free of wxWidgets dependencies!
+void readConfig(const zen::XmlIn& in, FilterConfig& filter);
+void readConfig(const zen::XmlIn& in, MainConfiguration& mainCfg, int formatVer);
+void readConfig(const zen::XmlIn& in, GlobalSyncConfig& cfg, int formatVer); //in: GlobalSettings.xml root
+
+void writeConfig(const FilterConfig& filter, zen::XmlOut& out);
+void writeConfig(const MainConfiguration& mainCfg, zen::XmlOut& out);
+void writeConfig(const GlobalSyncConfig& cfg, zen::XmlOut& out);
+}
+
+
+namespace zen
+{
+template <> inline
+void writeText(const fff::CompareVariant& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::CompareVariant::timeSize:
+            output = "TimeAndSize";
+            break;
+        case fff::CompareVariant::content:
+            output = "Content";
+            break;
+        case fff::CompareVariant::size:
+            output = "Size";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::CompareVariant& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "TimeAndSize")
+        value = fff::CompareVariant::timeSize;
+    else if (tmp == "Content")
+        value = fff::CompareVariant::content;
+    else if (tmp == "Size")
+        value = fff::CompareVariant::size;
+    else
+        return false;
+    return true;
+}
+
+
+template <> inline
+void writeText(const fff::SyncDirection& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::SyncDirection::left:
+            output = "left";
+            break;
+        case fff::SyncDirection::right:
+            output = "right";
+            break;
+        case fff::SyncDirection::none:
+            output = "none";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::SyncDirection& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "left")
+        value = fff::SyncDirection::left;
+    else if (tmp == "right")
+        value = fff::SyncDirection::right;
+    else if (tmp == "none")
+        value = fff::SyncDirection::none;
+    else
+        return false;
+    return true;
+}
+
+
+template <> inline
+void writeText(const fff::ResultsNotification& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::ResultsNotification::always:
+            output = "Always";
+            break;
+        case fff::ResultsNotification::errorWarning:
+            output = "ErrorWarning";
+            break;
+        case fff::ResultsNotification::errorOnly:
+            output = "ErrorOnly";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::ResultsNotification& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "Always")
+        value = fff::ResultsNotification::always;
+    else if (tmp == "ErrorWarning")
+        value = fff::ResultsNotification::errorWarning;
+    else if (tmp == "ErrorOnly")
+        value = fff::ResultsNotification::errorOnly;
+    else
+        return false;
+    return true;
+}
+
+
+template <> inline
+void writeText(const fff::PostSyncCondition& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::PostSyncCondition::completion:
+            output = "Completion";
+            break;
+        case fff::PostSyncCondition::errors:
+            output = "Errors";
+            break;
+        case fff::PostSyncCondition::success:
+            output = "Success";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::PostSyncCondition& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "Completion")
+        value = fff::PostSyncCondition::completion;
+    else if (tmp == "Errors")
+        value = fff::PostSyncCondition::errors;
+    else if (tmp == "Success")
+        value = fff::PostSyncCondition::success;
+    else
+        return false;
+    return true;
+}
+
+
+template <> inline
+void writeText(const fff::DeletionVariant& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::DeletionVariant::permanent:
+            output = "Permanent";
+            break;
+        case fff::DeletionVariant::recycler:
+            output = "RecycleBin";
+            break;
+        case fff::DeletionVariant::versioning:
+            output = "Versioning";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::DeletionVariant& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "Permanent")
+        value = fff::DeletionVariant::permanent;
+    else if (tmp == "RecycleBin")
+        value = fff::DeletionVariant::recycler;
+    else if (tmp == "Versioning")
+        value = fff::DeletionVariant::versioning;
+    else
+        return false;
+    return true;
+}
+
+
+template <> inline
+void writeText(const fff::SymLinkHandling& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::SymLinkHandling::exclude:
+            output = "Exclude";
+            break;
+        case fff::SymLinkHandling::asLink:
+            output = "Direct";
+            break;
+        case fff::SymLinkHandling::follow:
+            output = "Follow";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::SymLinkHandling& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "Exclude")
+        value = fff::SymLinkHandling::exclude;
+    else if (tmp == "Direct")
+        value = fff::SymLinkHandling::asLink;
+    else if (tmp == "Follow")
+        value = fff::SymLinkHandling::follow;
+    else
+        return false;
+    return true;
+}
+
+
+template <> inline
+void writeText(const fff::UnitSize& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::UnitSize::none:
+            output = "None";
+            break;
+        case fff::UnitSize::byte:
+            output = "Byte";
+            break;
+        case fff::UnitSize::kb:
+            output = "KB";
+            break;
+        case fff::UnitSize::mb:
+            output = "MB";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::UnitSize& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "None")
+        value = fff::UnitSize::none;
+    else if (tmp == "Byte")
+        value = fff::UnitSize::byte;
+    else if (tmp == "KB")
+        value = fff::UnitSize::kb;
+    else if (tmp == "MB")
+        value = fff::UnitSize::mb;
+    else
+        return false;
+    return true;
+}
+
+
+template <> inline
+void writeText(const fff::UnitTime& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::UnitTime::none:
+            output = "None";
+            break;
+        case fff::UnitTime::today:
+            output = "Today";
+            break;
+        case fff::UnitTime::thisMonth:
+            output = "Month";
+            break;
+        case fff::UnitTime::thisYear:
+            output = "Year";
+            break;
+        case fff::UnitTime::lastDays:
+            output = "x-days";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::UnitTime& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "None")
+        value = fff::UnitTime::none;
+    else if (tmp == "Today")
+        value = fff::UnitTime::today;
+    else if (tmp == "Month")
+        value = fff::UnitTime::thisMonth;
+    else if (tmp == "Year")
+        value = fff::UnitTime::thisYear;
+    else if (tmp == "x-days")
+        value = fff::UnitTime::lastDays;
+    else
+        return false;
+    return true;
+}
+
+
+template <> inline
+void writeText(const fff::VersioningStyle& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::VersioningStyle::replace:
+            output = "Replace";
+            break;
+        case fff::VersioningStyle::timestampFolder:
+            output = "TimeStamp-Folder";
+            break;
+        case fff::VersioningStyle::timestampFile:
+            output = "TimeStamp-File";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::VersioningStyle& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "Replace")
+        value = fff::VersioningStyle::replace;
+    else if (tmp == "TimeStamp-Folder")
+        value = fff::VersioningStyle::timestampFolder;
+    else if (tmp == "TimeStamp-File")
+        value = fff::VersioningStyle::timestampFile;
+    else
+        return false;
+    return true;
+}
+
+
+template <> inline
+void writeText(const fff::LogFileFormat& value, std::string& output)
+{
+    switch (value)
+    {
+        case fff::LogFileFormat::html:
+            output = "HTML";
+            break;
+        case fff::LogFileFormat::text:
+            output = "Text";
+            break;
+    }
+}
+
+template <> inline
+bool readText(const std::string& input, fff::LogFileFormat& value)
+{
+    const std::string tmp = trimCpy(input);
+    if (tmp == "HTML")
+        value = fff::LogFileFormat::html;
+    else if (tmp == "Text")
+        value = fff::LogFileFormat::text;
+    else
+        return false;
+    return true;
+}
+}
+
+#endif //CONFIG_XML_H_3871450982374509823
@@ -795,6 +795,8 @@ std::pair<DbStreams::const_iterator,
 std::unordered_map<const BaseFolderPair*, SharedRef<const InSyncFolder>> fff::loadLastSynchronousState(const std::vector<const BaseFolderPair*>& baseFolders,
         PhaseCallback& callback /*throw X*/) //throw X
 {
+    PerfTraceSpan perfPhase("phase", "Load database");
+
     std::set<AbstractPath> dbFilePaths;
 
     for (const BaseFolderPair* baseFolder : baseFolders)
@@ -878,6 +880,8 @@ std::unordered_map<const BaseFolderPair*, SharedRef<const InSyncFolder>> fff::lo
 void fff::saveLastSynchronousState(const BaseFolderPair& baseFolder, bool transactionalCopy,
                                    PhaseCallback& callback /*throw X*/) //throw X
 {
+    PerfTraceSpan perfPhase("phase", "Save database");
+
     const AbstractPath dbPathL = getDatabaseFilePath<SelectSide::left >(baseFolder);
     const AbstractPath dbPathR = getDatabaseFilePath<SelectSide::right>(baseFolder);
 
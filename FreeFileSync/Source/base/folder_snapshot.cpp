@@ -0,0 +1,260 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#include "folder_snapshot.h"
+#include <zen/crc.h>
+#include <zen/file_access.h>
+#include <zen/file_io.h>
+#include <zen/zlib_wrap.h>
+#include "../afs/native.h"
+
+using namespace zen;
+using namespace fff;
+
+
+namespace
+{
+//-------------------------------------------------------------------------------------------------------------------------------
+const char SNAPSHOT_FILE_DESCR[] = "FreeFileSync Snapshot";
+const int SNAPSHOT_FILE_VERSION = 1; //2026-10-17
+//-------------------------------------------------------------------------------------------------------------------------------
+
+//one file per folder path (regardless of filter and symlink handling) => removeFolderSnapshot() invalidates all variants
+Zstring getSnapshotFilePath(const AbstractPath& folderPath, const SnapshotConfig& cfg)
+{
+    //path phrase may contain credentials => don't use as file name
+    const uint64_t pathHash = hashString<uint64_t>(AFS::getInitPathPhrase(folderPath));
+
+    return appendPath(cfg.snapshotFolderPath, printNumber<Zstring>(Zstr("%016llx"), static_cast<unsigned long long>(pathHash)) + Zstr(".ffs_snapshot"));
+}
+
+
+//snapshot content depends on traversal settings: verify before use
+std::string getTraversalFingerprint(const DirectoryKey& folderKey)
+{
+    return utfTo<std::string>(AFS::getDisplayPath(folderKey.folderPath)) + '\n' +
+           numberTo<std::string>(static_cast<int>(folderKey.handleSymlinks)) + '\n' +
+           utfTo<std::string>(folderKey.filter.ref().getFingerprint());
+}
+
+
+template <SelectSide side>
+class SnapshotGenerator
+{
+public:
+    static std::string execute(const BaseFolderPair& baseFolder)
+    {
+        SnapshotGenerator generator;
+        generator.recurse(baseFolder);
+        return std::move(generator.streamOut_.ref());
+    }
+
+private:
+    void recurse(const ContainerObject& conObj)
+    {
+        writeNumber<uint32_t>(streamOut_, static_cast<uint32_t>(std::count_if(conObj.files().begin(), conObj.files().end(),
+                                                                              [](const FilePair& file) { return !file.isEmpty<side>(); })));
+        for (const FilePair& file : conObj.files())
+            if (!file.isEmpty<side>())
+            {
+                writeItemName(file.getItemName<side>());
+                writeNumber<int64_t         >(streamOut_, file.getLastWriteTime<side>());
+                writeNumber<uint64_t        >(streamOut_, file.getFileSize<side>());
+                writeNumber<AFS::FingerPrint>(streamOut_, file.getFilePrint<side>());
+                writeNumber<int8_t          >(streamOut_, file.isFollowedSymlink<side>());
+            }
+
+        writeNumber<uint32_t>(streamOut_, static_cast<uint32_t>(std::count_if(conObj.symlinks().begin(), conObj.symlinks().end(),
+                                                                              [](const SymlinkPair& symlink) { return !symlink.isEmpty<side>(); })));
+        for (const SymlinkPair& symlink : conObj.symlinks())
+            if (!symlink.isEmpty<side>())
+            {
+                writeItemName(symlink.getItemName<side>());
+                writeNumber<int64_t>(streamOut_, symlink.getLastWriteTime<side>());
+            }
+
+        writeNumber<uint32_t>(streamOut_, static_cast<uint32_t>(std::count_if(conObj.subfolders().begin(), conObj.subfolders().end(),
+                                                                              [](const FolderPair& folder) { return !folder.isEmpty<side>(); })));
+        for (const FolderPair& folder : conObj.subfolders())
+            if (!folder.isEmpty<side>())
+            {
+                writeItemName(folder.getItemName<side>());
+                writeNumber<int8_t>(streamOut_, folder.isFollowedSymlink<side>());
+
+                recurse(folder);
+            }
+    }
+
+    void writeItemName(const Zstring& str) { writeContainer(streamOut_, utfTo<std::string>(str)); }
+
+    MemoryStreamOut streamOut_;
+};
+
+
+class SnapshotParser
+{
+public:
+    static void execute(const std::string& stream, FolderContainer& folderCont) //throw SysError
+    {
+        MemoryStreamIn streamIn(stream);
+        SnapshotParser parser(streamIn);
+        parser.recurse(folderCont); //throw SysErrorUnexpectedEos
+    }
+
+private:
+    explicit SnapshotParser(MemoryStreamIn& streamIn) : streamIn_(streamIn) {}
+
+    void recurse(FolderContainer& folderCont) //throw SysErrorUnexpectedEos
+    {
+        size_t fileCount = readNumber<uint32_t>(streamIn_);
+        while (fileCount-- != 0)
+        {
+            const Zstring itemName = readItemName();
+
+            FileAttributes attr;
+            attr.modTime           = readNumber<int64_t         >(streamIn_);
+            attr.fileSize          = readNumber<uint64_t        >(streamIn_);
+            attr.filePrint         = readNumber<AFS::FingerPrint>(streamIn_);
+            attr.isFollowedSymlink = readNumber<int8_t          >(streamIn_) != 0;
+            folderCont.addFile(itemName, attr);
+        }
+
+        size_t linkCount = readNumber<uint32_t>(streamIn_);
+        while (linkCount-- != 0)
+        {
+            const Zstring itemName = readItemName();
+            folderCont.addSymlink(itemName, {.modTime = static_cast<time_t>(readNumber<int64_t>(streamIn_))});
+        }
+
+        size_t folderCount = readNumber<uint32_t>(streamIn_);
+        while (folderCount-- != 0)
+        {
+            const Zstring itemName = readItemName();
+            const bool isFollowedSymlink = readNumber<int8_t>(streamIn_) != 0;
+
+            recurse(folderCont.addFolder(itemName, {.isFollowedSymlink = isFollowedSymlink}));
+        }
+    }
+
+    Zstring readItemName() { return utfTo<Zstring>(readContainer<std::string>(streamIn_)); } //throw SysErrorUnexpectedEos
+
+    MemoryStreamIn& streamIn_;
+};
+}
+
+
+bool fff::snapshotEnabled(const AbstractPath& folderPath, const SnapshotConfig& cfg)
+{
+    return !cfg.snapshotFolderPath.empty() && cfg.maxAge > std::chrono::seconds(0) &&
+           getNativeItemPath(folderPath).empty(); //traversing local folders is cheap enough
+}
+
+
+bool fff::snapshotSupported(const AbstractPath& folderPath, SelectSide side, const SyncDirectionConfig& dirCfg, const SnapshotConfig& cfg)
+{
+    auto isSyncTargetOnly = [&]
+    {
+        //sync.ffs_db-based directions detect changes on both sides => requires actual folder content
+        const DirectionByDiff* diffDirs = std::get_if<DirectionByDiff>(&dirCfg.dirs);
+        if (!diffDirs)
+            return false;
+
+        const SyncDirection readFromSide = side == SelectSide::left ? SyncDirection::right : SyncDirection::left; //copy *from* "side"
+        return diffDirs->leftOnly   != readFromSide &&
+               diffDirs->rightOnly  != readFromSide &&
+               diffDirs->leftNewer  != readFromSide &&
+               diffDirs->rightNewer != readFromSide;
+    };
+
+    return snapshotEnabled(folderPath, cfg) && isSyncTargetOnly();
+}
+
+
+bool fff::loadFolderSnapshot(const DirectoryKey& folderKey, const SnapshotConfig& cfg, FolderContainer& folderCont) //throw FileError
+{
+    const Zstring filePath = getSnapshotFilePath(folderKey.folderPath, cfg);
+
+    if (!itemExists(filePath)) //throw FileError
+        return false;
+
+    const std::string byteStream = getFileContent(filePath, nullptr /*notifyUnbufferedIO*/); //throw FileError
+    try
+    {
+        MemoryStreamIn memStreamIn(byteStream);
+
+        char formatDescr[sizeof(SNAPSHOT_FILE_DESCR)] = {};
+        readArray(memStreamIn, formatDescr, sizeof(formatDescr)); //throw SysErrorUnexpectedEos
+
+        if (!std::equal(SNAPSHOT_FILE_DESCR, SNAPSHOT_FILE_DESCR + sizeof(SNAPSHOT_FILE_DESCR), formatDescr))
+            throw SysError(_("File content is corrupted.") + L" (invalid header)");
+
+        if (readNumber<int32_t>(memStreamIn) != SNAPSHOT_FILE_VERSION) //throw SysErrorUnexpectedEos
+            return false; //just a cache: rebuild after next sync
+
+        assert(byteStream.size() >= sizeof(uint32_t)); //obviously in this context!
+        MemoryStreamOut crcStreamOut;
+        writeNumber<uint32_t>(crcStreamOut, getCrc32(byteStream.begin(), byteStream.end() - sizeof(uint32_t)));
+
+        if (!endsWith(byteStream, crcStreamOut.ref()))
+            throw SysError(_("File content is corrupted.") + L" (invalid checksum)");
+
+        const time_t saveTime = readNumber<int64_t>(memStreamIn); //throw SysErrorUnexpectedEos
+        const time_t now = std::time(nullptr);
+        if (now < saveTime || //system clock changed?
+            now - saveTime >= cfg.maxAge.count())
+            return false;
+
+        if (readContainer<std::string>(memStreamIn) != getTraversalFingerprint(folderKey)) //throw SysErrorUnexpectedEos
+            return false;
+
+        SnapshotParser::execute(decompress(readContainer<std::string>(memStreamIn)), folderCont); //throw SysError
+        return true;
+    }
+    catch (const SysError& e)
+    {
+        throw FileError(replaceCpy(_("Cannot read file %x."), L"%x", fmtPath(filePath)), e.toString());
+    }
+}
+
+
+void fff::saveFolderSnapshot(const DirectoryKey& folderKey, const BaseFolderPair& baseFolder, SelectSide side, const SnapshotConfig& cfg) //throw FileError
+{
+    assert(folderKey.folderPath == (side == SelectSide::left ? baseFolder.getAbstractPath<SelectSide::left>() : baseFolder.getAbstractPath<SelectSide::right>()));
+    const Zstring filePath = getSnapshotFilePath(folderKey.folderPath, cfg);
+
+    const std::string stream = side == SelectSide::left ?
+                               SnapshotGenerator<SelectSide::left >::execute(baseFolder) :
+                               SnapshotGenerator<SelectSide::right>::execute(baseFolder);
+    MemoryStreamOut memStreamOut;
+    writeArray(memStreamOut, SNAPSHOT_FILE_DESCR, sizeof(SNAPSHOT_FILE_DESCR));
+    writeNumber<int32_t>(memStreamOut, SNAPSHOT_FILE_VERSION);
+    writeNumber<int64_t>(memStreamOut, std::time(nullptr));
+    writeContainer(memStreamOut, getTraversalFingerprint(folderKey));
+    try
+    {
+        writeContainer(memStreamOut, compress(stream, 3 /*level: see db_file.cpp*/)); //throw SysError
+    }
+    catch (const SysError& e)
+    {
+        throw FileError(replaceCpy(_("Cannot write file %x."), L"%x", fmtPath(filePath)), e.toString());
+    }
+    writeNumber<uint32_t>(memStreamOut, getCrc32(memStreamOut.ref()));
+
+    createDirectoryIfMissingRecursion(cfg.snapshotFolderPath); //throw FileError
+    setFileContent(filePath, memStreamOut.ref(), nullptr /*notifyUnbufferedIO*/); //throw FileError
+}
+
+
+void fff::removeFolderSnapshot(const AbstractPath& folderPath, const SnapshotConfig& cfg) //throw FileError
+{
+    assert(snapshotEnabled(folderPath, cfg));
+
+    //writing to a folder also changes the content of all parent folders
+    for (std::optional<AbstractPath> itemPath = folderPath; itemPath; itemPath = AFS::getParentPath(*itemPath))
+        if (const Zstring filePath = getSnapshotFilePath(*itemPath, cfg);
+            itemExists(filePath)) //throw FileError
+            removeFilePlain(filePath); //throw FileError
+}
@@ -0,0 +1,46 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#ifndef FOLDER_SNAPSHOT_H_7302854196730485
+#define FOLDER_SNAPSHOT_H_7302854196730485
+
+#include <chrono>
+#include "parallel_scan.h"
+
+
+namespace fff
+{
+/*  persisted listing of a remote base folder (SFTP, FTP, Google Drive) as left behind by the last successful sync
+    => comparison skips traversal of folders only FreeFileSync writes to, e.g. backup targets
+    - snapshot is used only if folder path, filter and symlink handling match and it is younger than "maxAge" (= periodic full verification)
+    - only for sides the sync directions exclusively write to (mirror/update target): a stale snapshot of a two-way or source side
+      would hide changes made by others => no conflict detection, edits would be overwritten silently!
+    - NOT detected: changes made by other applications (or by syncs without snapshot support) before the snapshot expires! => opt-in only
+    - NOT detected: writes to a base folder *inside* another (nested) snapshot folder => don't combine nested remote base folders
+    - local folders are always traversed: cheap enough                                                                                      */
+struct SnapshotConfig
+{
+    Zstring snapshotFolderPath; //empty: disabled
+    std::chrono::seconds maxAge{0};
+};
+
+//remote folder and snapshots enabled: invalidate snapshot before writing to the folder, regardless of sync directions
+bool snapshotEnabled(const AbstractPath& folderPath, const SnapshotConfig& cfg);
+//...but load and save only for sync targets
+bool snapshotSupported(const AbstractPath& folderPath, SelectSide side, const SyncDirectionConfig& dirCfg, const SnapshotConfig& cfg);
+
+//false if not existing, expired or saved for a different filter/symlink handling
+bool loadFolderSnapshot(const DirectoryKey& folderKey, const SnapshotConfig& cfg, FolderContainer& folderCont); //throw FileError
+
+//call only after the base folder was synchronized without errors: BaseFolderPair then reflects the current folder content
+void saveFolderSnapshot(const DirectoryKey& folderKey, const BaseFolderPair& baseFolder, SelectSide side, const SnapshotConfig& cfg); //throw FileError
+
+//invalidate *before* writing to the folder: sync may fail half-way, other jobs may write using different filter settings
+//=> also removes snapshots of parent folders
+void removeFolderSnapshot(const AbstractPath& folderPath, const SnapshotConfig& cfg); //throw FileError
+}
+
+#endif //FOLDER_SNAPSHOT_H_7302854196730485
@@ -11,6 +11,7 @@
     #include <sys/stat.h>
     #include <zen/sys_error.h>
     #include <zen/basic_math.h>
+    #include <zen/file_path.h>
     #include <xBRZ/src/xbrz_tools.h>
 
 
@@ -157,6 +158,125 @@ ImageHolder imageHolderFromGicon(GIcon& gicon, int maxSize) //throw SysError
     //we may have to shrink (e.g. GTK3, openSUSE): "an icon theme may have icons that differ slightly from their nominal sizes"
     return copyToImageHolder(*pixBuf, maxSize); //throw SysError
 }
+
+
+//freedesktop.org thumbnail cache: https://specifications.freedesktop.org/thumbnail-spec/latest/
+//=> decode large images only once, even across restarts; shared with file managers
+struct ThumbnailCacheItem
+{
+    Zstring thumbPath;
+    std::string fileUri;
+    std::string fileMTime;
+    int pixelSize = 0;
+};
+
+
+std::optional<ThumbnailCacheItem> getThumbnailCacheItem(const Zstring& filePath, const struct stat& fileInfo, int maxSize) //throw SysError
+{
+    const auto [cacheDirName, pixelSize] = [&]() -> std::pair<const Zchar*, int>
+    {
+        if (maxSize <= 128) return {Zstr("normal"), 128};
+        if (maxSize <= 256) return {Zstr("large"),  256};
+        return {nullptr, 0};
+    }();
+    if (!cacheDirName)
+        return {};
+
+    const Zstring thumbRootPath = appendPath(::g_get_user_cache_dir(), Zstr("thumbnails"));
+    if (startsWith(filePath, thumbRootPath + FILE_NAME_SEPARATOR)) //no thumbnails of thumbnails!
+        return {};
+
+    GError* error = nullptr;
+    ZEN_ON_SCOPE_EXIT(if (error) ::g_error_free(error));
+
+    gchar* const fileUri = ::g_filename_to_uri(filePath.c_str(), nullptr /*hostname*/, &error);
+    if (!fileUri)
+        throw SysError(formatGlibError("g_filename_to_uri", error));
+    ZEN_ON_SCOPE_EXIT(::g_free(fileUri));
+
+    gchar* const uriMd5 = ::g_compute_checksum_for_string(G_CHECKSUM_MD5, fileUri, -1);
+    if (!uriMd5)
+        throw SysError(formatSystemError("g_compute_checksum_for_string", L"", L"Unexpected failure."));
+    ZEN_ON_SCOPE_EXIT(::g_free(uriMd5));
+
+    return ThumbnailCacheItem
+    {
+        .thumbPath = appendPath(appendPath(thumbRootPath, cacheDirName), Zstring(uriMd5) + Zstr(".png")),
+        .fileUri   = fileUri,
+        .fileMTime = numberTo<std::string>(fileInfo.st_mtime),
+        .pixelSize = pixelSize,
+    };
+}
+
+
+//return nullptr if not existing or outdated
+GdkPixbuf* loadCachedThumbnail(const ThumbnailCacheItem& item)
+{
+    GdkPixbuf* const pixBuf = ::gdk_pixbuf_new_from_file(item.thumbPath.c_str(), nullptr /*GError** error*/);
+    if (!pixBuf)
+        return nullptr;
+
+    const gchar* const thumbUri   = ::gdk_pixbuf_get_option(pixBuf, "tEXt::Thumb::URI"); //no ownership transfer!
+    const gchar* const thumbMTime = ::gdk_pixbuf_get_option(pixBuf, "tEXt::Thumb::MTime");
+
+    if (thumbUri && thumbMTime && item.fileUri == thumbUri && item.fileMTime == thumbMTime)
+        return pixBuf;
+
+    ::g_object_unref(pixBuf);
+    return nullptr;
+}
+
+
+//return thumbnail of size "item.pixelSize" (caller takes ownership) after saving it to the cache
+GdkPixbuf* createCachedThumbnail(const GdkPixbuf& pixBuf, const ThumbnailCacheItem& item) //throw SysError
+{
+    ImageHolder thumbImg = copyToImageHolder(pixBuf, item.pixelSize); //throw SysError
+
+    //GdkPixbuf expects interleaved RGBA
+    const int width  = thumbImg.getWidth();
+    const int height = thumbImg.getHeight();
+
+    GdkPixbuf* const thumbBuf = ::gdk_pixbuf_new(GDK_COLORSPACE_RGB, true /*has_alpha*/, 8 /*bits_per_sample*/, width, height);
+    if (!thumbBuf)
+        throw SysError(formatSystemError("gdk_pixbuf_new", L"", L"Not enough memory."));
+    ZEN_ON_SCOPE_FAIL(::g_object_unref(thumbBuf));
+    {
+        const int stride = ::gdk_pixbuf_get_rowstride(thumbBuf);
+        unsigned char* const trgBytes = ::gdk_pixbuf_get_pixels(thumbBuf);
+        const unsigned char* rgb   = thumbImg.getRgb();
+        const unsigned char* alpha = thumbImg.getAlpha();
+
+        for (int y = 0; y < height; ++y)
+            for (unsigned char* ptr = trgBytes + y * stride; ptr != trgBytes + y * stride + 4 * width; ptr += 4)
+            {
+                ptr[0] = *rgb++;
+                ptr[1] = *rgb++;
+                ptr[2] = *rgb++;
+                ptr[3] = *alpha++;
+            }
+    }
+
+    GError* error = nullptr;
+    ZEN_ON_SCOPE_EXIT(if (error) ::g_error_free(error));
+
+    gchar* pngBuf = nullptr;
+    gsize pngSize = 0;
+    if (!::gdk_pixbuf_save_to_buffer(thumbBuf, &pngBuf, &pngSize, "png", &error,
+                                     "tEXt::Thumb::URI",   item.fileUri  .c_str(),
+                                     "tEXt::Thumb::MTime", item.fileMTime.c_str(), nullptr))
+        throw SysError(formatGlibError("gdk_pixbuf_save_to_buffer", error));
+    ZEN_ON_SCOPE_EXIT(::g_free(pngBuf));
+
+    if (const std::optional<Zstring> parentPath = getParentFolderPath(item.thumbPath))
+        if (::g_mkdir_with_parents(parentPath->c_str(), 0700) != 0)
+            THROW_LAST_SYS_ERROR("g_mkdir_with_parents");
+
+    //write to temporary file + rename: never leave partially written thumbnails
+    if (!::g_file_set_contents_full(item.thumbPath.c_str(), pngBuf, pngSize, G_FILE_SET_CONTENTS_CONSISTENT, 0600, &error))
+        throw SysError(formatGlibError("g_file_set_contents_full", error));
+
+    return thumbBuf;
+}
 }
 
 
@@ -265,6 +385,20 @@ ImageHolder fff::getThumbnailImage(const Zstring& filePath, int maxSize) //throw
     if (!S_ISREG(fileInfo.st_mode)) //skip blocking file types, e.g. named pipes, see file_io.cpp
         throw SysError(_("Unsupported item type.") + L" [" + printNumber<std::wstring>(L"0%06o", fileInfo.st_mode & S_IFMT) + L']');
 
+    std::optional<ThumbnailCacheItem> cacheItem;
+    try
+    {
+        cacheItem = getThumbnailCacheItem(filePath, fileInfo, maxSize); //throw SysError
+    }
+    catch (SysError&) {} //thumbnail cache is optional
+
+    if (cacheItem)
+        if (GdkPixbuf* const thumbBuf = loadCachedThumbnail(*cacheItem))
+        {
+            ZEN_ON_SCOPE_EXIT(::g_object_unref(thumbBuf));
+            return copyToImageHolder(*thumbBuf, maxSize); //throw SysError
+        }
+
     GError* error = nullptr;
     ZEN_ON_SCOPE_EXIT(if (error) ::g_error_free(error));
 
@@ -273,6 +407,16 @@ ImageHolder fff::getThumbnailImage(const Zstring& filePath, int maxSize) //throw
         throw SysError(formatGlibError("gdk_pixbuf_new_from_file", error));
     ZEN_ON_SCOPE_EXIT(::g_object_unref(pixBuf));
 
+    //don't cache small images: decoding is cheap
+    if (cacheItem && std::max(::gdk_pixbuf_get_width(pixBuf), ::gdk_pixbuf_get_height(pixBuf)) > cacheItem->pixelSize)
+        try
+        {
+            GdkPixbuf* const thumbBuf = createCachedThumbnail(*pixBuf, *cacheItem); //throw SysError
+            ZEN_ON_SCOPE_EXIT(::g_object_unref(thumbBuf));
+            return copyToImageHolder(*thumbBuf, maxSize); //throw SysError; same result as when loading from cache later
+        }
+        catch (SysError&) {} //e.g. read-only home directory => fall back to full image
+
     return copyToImageHolder(*pixBuf, maxSize); //throw SysError
 
 }
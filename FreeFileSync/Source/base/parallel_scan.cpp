@@ -406,6 +406,7 @@ DirCallback::HandleError DirCallback::reportError(const ErrorInfo& errorInfo, co
 
 
 std::map<DirectoryKey, DirectoryValue> fff::parallelFolderScan(const std::set<DirectoryKey>& foldersToRead,
+                                                               const std::map<AfsDevice, size_t>& deviceParallelOps,
                                                                const TravErrorCb& onError, const TravStatusCb& onStatusUpdate,
                                                                std::chrono::milliseconds cbInterval)
 {
@@ -434,7 +435,7 @@ std::map<DirectoryKey, DirectoryValue> fff::parallelFolderScan(const std::set<Di
         Zstring threadName = Zstr("Compare[") + numberTo<Zstring>(threadIdx + 1) + Zstr('/') + numberTo<Zstring>(perDeviceFolders.size()) + Zstr("] ") +
                              utfTo<Zstring>(AFS::getDisplayPath({afsDevice, AfsPath()}));
 
-        const size_t parallelOps = 1;
+        const size_t parallelOps = getDeviceParallelOps(deviceParallelOps, afsDevice); //currently used by Google Drive only
         std::map<DirectoryKey, DirectoryValue*> workload;
 
         for (const DirectoryKey& key : dirKeys)
@@ -47,6 +47,7 @@ using TravErrorCb  = std::function<PhaseCallback::Response(const PhaseCallback::
 using TravStatusCb = std::function<void(const std::wstring& statusLine, int itemsTotal)>;
 
 std::map<DirectoryKey, DirectoryValue> parallelFolderScan(const std::set<DirectoryKey>& foldersToRead,
+                                                          const std::map<AfsDevice, size_t>& deviceParallelOps,
                                                           const TravErrorCb& onError, const TravStatusCb& onStatusUpdate, //NOT optional
                                                           std::chrono::milliseconds cbInterval);
 }
@@ -24,6 +24,17 @@ std::strong_ordering fff::operator<=>(const FilterRef& lhs, const FilterRef& rhs
 }
 
 
+FilterRef fff::combineFilters(const FilterRef& first, const FilterRef& second)
+{
+    if (first.ref().isNull())
+        return second;
+    if (second.ref().isNull())
+        return first;
+
+    return zen::makeSharedRef<CombinedFilter>(first, second);
+}
+
+
 void NameFilter::parseFilterPhrase(const Zstring& filterPhrase, FilterSet& filter)
 {
     //normalize filter: 1. ignore Unicode normalization form 2. ignore case
@@ -108,6 +119,17 @@ void NameFilter::MaskMatcher::insert(const Zstring& mask)
 }
 
 
+void NameFilter::MaskMatcher::addFingerprint(Zstring& output) const
+{
+    //std::set => sorted: independent from insertion order
+    for (const Zstring& mask : realMasks_)
+        output += mask + Zstr('\n'); //masks never contain line breaks: see parseFilterPhrase()
+
+    for (const Zstring& relPath : relPathsCmp_)
+        output += relPath + Zstr('\n');
+}
+
+
 namespace
 {
 //"true" if path or any parent path matches the mask
@@ -291,6 +313,20 @@ bool NameFilter::passDirFilter(const Zstring& relDirPath, bool* childItemMightMa
 }
 
 
+bool NameFilter::exclusionMightMatch(const Zstring& relDirPath) const
+{
+    assert(!startsWith(relDirPath, FILE_NAME_SEPARATOR));
+
+    //normalize input: 1. ignore Unicode normalization form 2. ignore case
+    const Zstring& pathFmt = getUpperCase(relDirPath);
+
+    return excludeFilter.folderMasks.matches(pathFmt) || //folder (and all child items) excluded
+           excludeFilter.fileMasks  .matches(pathFmt) || //file masks also match on any parent folder, see passFileFilter()
+           excludeFilter.fileMasks  .matchesBegin(pathFmt) || //might match a file or folder in subdirectory
+           excludeFilter.folderMasks.matchesBegin(pathFmt);   //
+}
+
+
 bool NameFilter::isNull(const Zstring& includePhrase, const Zstring& excludePhrase)
 {
     return trimCpy(includePhrase) == Zstr("*") && //harmonize with ui/folder_pair.cpp tooltip
@@ -306,6 +342,19 @@ bool NameFilter::isNull() const
 }
 
 
+Zstring NameFilter::getFingerprint() const
+{
+    Zstring output = Zstr("name");
+    for (const MaskMatcher* masks : {&includeFilter.fileMasks, &includeFilter.folderMasks,
+                                     &excludeFilter.fileMasks, &excludeFilter.folderMasks})
+    {
+        output += FILTER_ITEM_SEPARATOR;
+        masks->addFingerprint(output);
+    }
+    return output;
+}
+
+
 std::strong_ordering NameFilter::compareSameType(const PathFilter& other) const
 {
     assert(typeid(*this) == typeid(other)); //always given in this context!
@@ -44,6 +44,9 @@ public:
 
     virtual FilterRef copyFilterAddingExclusion(const Zstring& excludePhrase) const = 0;
 
+    //deterministic: equal filters <=> equal fingerprint (e.g. persisted as key, see folder_snapshot.h)
+    virtual Zstring getFingerprint() const = 0;
+
 private:
     friend std::strong_ordering operator<=>(const FilterRef& lhs, const FilterRef& rhs);
 
@@ -62,6 +65,7 @@ public:
     bool passDirFilter(const Zstring& relDirPath, bool* childItemMightMatch) const override;
     bool isNull() const override { return true; }
     FilterRef copyFilterAddingExclusion(const Zstring& excludePhrase) const override;
+    Zstring getFingerprint() const override { return Zstr("null"); }
 
 private:
     std::strong_ordering compareSameType(const PathFilter& other) const override { assert(typeid(*this) == typeid(other)); return std::strong_ordering::equal; }
@@ -81,9 +85,12 @@ public:
     bool isNull() const override;
     static bool isNull(const Zstring& includePhrase, const Zstring& excludePhrase); //*fast* check without expensive NameFilter construction!
     FilterRef copyFilterAddingExclusion(const Zstring& excludePhrase) const override;
+    Zstring getFingerprint() const override;
+
+    //perf: "false" if exclusion matches neither the folder nor any item inside => sub tree can be skipped when only adding exclusions
+    bool exclusionMightMatch(const Zstring& relDirPath) const;
 
 private:
-    friend class CombinedFilter;
     std::strong_ordering compareSameType(const PathFilter& other) const override;
 
     class MaskMatcher
@@ -92,6 +99,7 @@ private:
         void insert(const Zstring& mask); //expected: upper-case + Unicode-normalized!
         bool matches(const ZstringView relPath) const;
         bool matchesBegin(const ZstringView relPath) const;
+        void addFingerprint(Zstring& output) const;
 
         inline friend std::strong_ordering operator<=>(const MaskMatcher& lhs, const MaskMatcher& rhs)
         {
@@ -129,18 +137,19 @@ private:
 class CombinedFilter : public PathFilter //combine two filters to match if and only if both match
 {
 public:
-    CombinedFilter(const NameFilter& first, const NameFilter& second) : first_(first), second_(second) { assert(!first.isNull() && !second.isNull()); } //if either is null, then wy use CombinedFilter?
+    CombinedFilter(const FilterRef& first, const FilterRef& second) : first_(first), second_(second) { assert(!first.ref().isNull() && !second.ref().isNull()); } //if either is null, then wy use CombinedFilter?
 
     bool passFileFilter(const Zstring& relFilePath) const override;
     bool passDirFilter(const Zstring& relDirPath, bool* childItemMightMatch) const override;
     bool isNull() const override;
     FilterRef copyFilterAddingExclusion(const Zstring& excludePhrase) const override;
+    Zstring getFingerprint() const override;
 
 private:
     std::strong_ordering compareSameType(const PathFilter& other) const override;
 
-    const NameFilter first_;
-    const NameFilter second_;
+    const FilterRef first_;
+    const FilterRef second_;
 };
 
 
@@ -179,20 +188,20 @@ FilterRef NameFilter::copyFilterAddingExclusion(const Zstring& excludePhrase) co
 inline
 bool CombinedFilter::passFileFilter(const Zstring& relFilePath) const
 {
-    return first_ .passFileFilter(relFilePath) && //short-circuit behavior
-           second_.passFileFilter(relFilePath);
+    return first_ .ref().passFileFilter(relFilePath) && //short-circuit behavior
+           second_.ref().passFileFilter(relFilePath);
 }
 
 
 inline
 bool CombinedFilter::passDirFilter(const Zstring& relDirPath, bool* childItemMightMatch) const
 {
-    if (first_.passDirFilter(relDirPath, childItemMightMatch))
-        return second_.passDirFilter(relDirPath, childItemMightMatch);
+    if (first_.ref().passDirFilter(relDirPath, childItemMightMatch))
+        return second_.ref().passDirFilter(relDirPath, childItemMightMatch);
     else
     {
         if (childItemMightMatch && *childItemMightMatch)
-            second_.passDirFilter(relDirPath, childItemMightMatch);
+            second_.ref().passDirFilter(relDirPath, childItemMightMatch);
         return false;
     }
 }
@@ -201,17 +210,21 @@ bool CombinedFilter::passDirFilter(const Zstring& relDirPath, bool* childItemMig
 inline
 bool CombinedFilter::isNull() const
 {
-    return first_.isNull() && second_.isNull();
+    return first_.ref().isNull() && second_.ref().isNull();
 }
 
 
 inline
 FilterRef CombinedFilter::copyFilterAddingExclusion(const Zstring& excludePhrase) const
 {
-    NameFilter tmp(first_);
-    tmp.addExclusion(excludePhrase);
+    return zen::makeSharedRef<CombinedFilter>(first_.ref().copyFilterAddingExclusion(excludePhrase), second_);
+}
 
-    return zen::makeSharedRef<CombinedFilter>(tmp, second_);
+
+inline
+Zstring CombinedFilter::getFingerprint() const
+{
+    return Zstr("and(") + first_.ref().getFingerprint() + FILTER_ITEM_SEPARATOR + second_.ref().getFingerprint() + Zstr(')');
 }
 
 
@@ -223,11 +236,11 @@ std::strong_ordering CombinedFilter::compareSameType(const PathFilter& other) co
     const CombinedFilter& lhs = *this;
     const CombinedFilter& rhs = static_cast<const CombinedFilter&>(other);
 
-    if (const std::strong_ordering cmp = lhs.first_.compareSameType(rhs.first_);
+    if (const std::strong_ordering cmp = lhs.first_ <=> rhs.first_;
         cmp != std::strong_ordering::equal)
         return cmp;
 
-    return lhs.second_.compareSameType(rhs.second_);
+    return lhs.second_ <=> rhs.second_;
 }
 
 
@@ -250,7 +263,8 @@ FilterRef constructFilter(const Zstring& includePhrase,
         if (NameFilter::isNull(includePhrase2, Zstring()))
             return zen::makeSharedRef<NameFilter>(includePhrase, excludePhrase + Zstr('\n') + excludePhrase2);
         else
-            return zen::makeSharedRef<CombinedFilter>(NameFilter(includePhrase, excludePhrase + Zstr('\n') + excludePhrase2), NameFilter(includePhrase2, Zstring()));
+            return zen::makeSharedRef<CombinedFilter>(zen::makeSharedRef<NameFilter>(includePhrase, excludePhrase + Zstr('\n') + excludePhrase2),
+                                                      zen::makeSharedRef<NameFilter>(includePhrase2, Zstring()));
     }
 }
 }
@@ -184,6 +184,47 @@ SyncDirectionConfig fff::getDefaultSyncCfg(SyncVariant syncVar)
 }
 
 
+std::vector<unsigned int> fff::fromTimeShiftPhrase(const std::wstring_view timeShiftPhrase)
+{
+    std::vector<unsigned int> minutes;
+
+    split2(timeShiftPhrase, [](wchar_t c) { return c == L',' || c == L';' || c == L' '; }, //delimiters
+    [&minutes](const std::wstring_view block)
+    {
+        if (!block.empty())
+        {
+            std::wstring part(block);
+            replace(part, L'-', L""); //there is no negative shift => treat as positive!
+
+            const unsigned int timeShift = stringTo<unsigned int>(beforeFirst(part, L':', IfNotFoundReturn::all)) * 60 +
+                                           stringTo<unsigned int>(afterFirst (part, L':', IfNotFoundReturn::none));
+            if (timeShift > 0)
+                minutes.push_back(timeShift);
+        }
+    });
+    removeDuplicates(minutes);
+    return minutes;
+}
+
+
+std::wstring fff::toTimeShiftPhrase(const std::vector<unsigned int>& ignoreTimeShiftMinutes)
+{
+    std::wstring phrase;
+    for (const unsigned int timeShift : ignoreTimeShiftMinutes)
+    {
+        if (!phrase.empty())
+            phrase += L", ";
+
+        phrase += numberTo<std::wstring>(timeShift / 60);
+
+        if (const unsigned int shiftRem = timeShift % 60;
+            shiftRem != 0)
+            phrase += L':' + printNumber<std::wstring>(L"%02d", static_cast<int>(shiftRem));
+    }
+    return phrase;
+}
+
+
 size_t fff::getDeviceParallelOps(const std::map<AfsDevice, size_t>& deviceParallelOps, const AfsDevice& afsDevice)
 {
     auto it = deviceParallelOps.find(afsDevice);
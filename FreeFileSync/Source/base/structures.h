@@ -11,6 +11,7 @@
 #include <vector>
 #include <chrono>
 #include <zen/zstring.h>
+#include <zen/file_access.h>
 #include "../afs/abstract.h"
 
 
@@ -186,6 +187,10 @@ struct CompConfig
 inline
 bool effectivelyEqual(const CompConfig& lhs, const CompConfig& rhs) { return lhs == rhs; } //no change in behavior
 
+//convert "ignoreTimeShiftMinutes" into compact format:
+std::vector<unsigned int> fromTimeShiftPhrase(const std::wstring_view timeShiftPhrase);
+std::wstring              toTimeShiftPhrase  (const std::vector<unsigned int>& ignoreTimeShiftMinutes);
+
 
 enum class DeletionVariant
 {
@@ -388,6 +393,33 @@ struct WarningDialogs
 
     bool operator==(const WarningDialogs&) const = default;
 };
+
+
+enum class LogFileFormat
+{
+    html,
+    text
+};
+
+
+//GlobalSettings.xml: settings needed for comparison/synchronization => shared by GlobalConfig (GUI) and ffs-cli
+struct GlobalSyncConfig
+{
+    bool failSafeFileCopy = true;
+    bool copyLockedFiles  = false; //safer default: avoid copies of partially written files
+    bool copyFilePermissions = false;
+
+    unsigned int fileTimeTolerance = zen::FAT_FILE_TIME_PRECISION_SEC; //default 2s: FAT vs NTFS
+    bool runWithBackgroundPriority = false;
+    bool createLockFile = true;
+    bool verifyFileCopy = false;
+    int logfilesMaxAgeDays = 30; //<= 0 := no limit; for log files under %AppData%\FreeFileSync\Logs
+    LogFileFormat logFormat = LogFileFormat::html;
+    Zstring perfTraceFilePath;   //optional, batch mode: Chrome trace-event JSON (macros supported, e.g. %time%)
+    Zstring perfMetricsFilePath; //optional, batch mode: Prometheus text format, e.g. for node_exporter's textfile collector
+
+    WarningDialogs warnDlgs;
+};
 }
 
 #endif //STRUCTURES_H_8210478915019450901745
@@ -376,7 +376,8 @@ std::vector<FolderPairSyncCfg> fff::extractSyncCfg(const MainConfiguration& main
             syncCfg.versioningStyle,
             syncCfg.versionMaxAgeDays,
             syncCfg.versionCountMin,
-            syncCfg.versionCountMax
+            syncCfg.versionCountMax,
+            mainCfg.deviceParallelOps
         });
     }
     return output;
@@ -1107,7 +1108,8 @@ void DeletionHandler::removeDirWithCallback(const AbstractPath& folderPath, cons
 class Workload
 {
 public:
-    Workload(size_t threadCount, AsyncCallback& acb) : acb_(acb), workload_(threadCount) { assert(threadCount > 0); }
+    Workload(size_t threadCount, AsyncCallback& acb, std::atomic<size_t>& activeWorkloads) :
+        acb_(acb), activeWorkloads_(activeWorkloads), workload_(threadCount) { assert(threadCount > 0); }
 
     using WorkItem  = std::function<void() /*throw ThreadStopRequest*/>;
     using WorkItems = RingBuffer<WorkItem>; //FIFO!
@@ -1152,7 +1154,8 @@ public:
                 else //wait...
                 {
                     if (++idleThreads_ == workload_.size())
-                        acb_.notifyAllDone(); //noexcept
+                        if (--activeWorkloads_ == 0) //idle Workload never gets new work: only its own threads add items
+                            acb_.notifyAllDone(); //noexcept
                     ZEN_ON_SCOPE_EXIT(--idleThreads_);
 
                     auto haveNewWork = [&] { return !pendingWorkload_.empty() || std::any_of(workload_.begin(), workload_.end(), [](const WorkItems& wi) { return !wi.empty(); }); };
@@ -1182,6 +1185,7 @@ private:
     Workload& operator=(const Workload&) = delete;
 
     AsyncCallback& acb_;
+    std::atomic<size_t>& activeWorkloads_; //one Workload per folder pair synchronized in parallel
 
     std::mutex lockWork_;
     std::condition_variable conditionNewWork_;
@@ -1213,11 +1217,14 @@ public:
         DeletionHandler& delHandlerRight;
     };
 
-    static void runSync(SyncCtx& syncCtx, BaseFolderPair& baseFolder, PhaseCallback& cb)
+    using SyncTask = std::pair<SyncCtx*, BaseFolderPair*>;
+
+    //folder pairs must be independent (no same or nested folders): synchronized in parallel, one worker thread each
+    static void runSync(const std::vector<SyncTask>& folderPairs, PhaseCallback& cb)
     {
-        runPass(PassNo::zero, syncCtx, baseFolder, cb); //prepare file moves
-        runPass(PassNo::one,  syncCtx, baseFolder, cb); //delete files (or overwrite big ones with smaller ones)
-        runPass(PassNo::two,  syncCtx, baseFolder, cb); //copy rest
+        runPass(PassNo::zero, folderPairs, cb); //prepare file moves
+        runPass(PassNo::one,  folderPairs, cb); //delete files (or overwrite big ones with smaller ones)
+        runPass(PassNo::two,  folderPairs, cb); //copy rest
     }
 
 private:
@@ -1246,7 +1253,7 @@ private:
     static bool needZeroPass(const FilePair& file);
     static bool needZeroPass(const FolderPair& folder);
 
-    static void runPass(PassNo pass, SyncCtx& syncCtx, BaseFolderPair& baseFolder, PhaseCallback& cb); //throw X
+    static void runPass(PassNo pass, const std::vector<SyncTask>& folderPairs, PhaseCallback& cb); //throw X
 
     RingBuffer<Workload::WorkItems> getFolderLevelWorkItems(PassNo pass, ContainerObject& parentFolder, Workload& workload);
 
@@ -1321,39 +1328,53 @@ Callback     =============       --------------------
                                  --------------------
 
 Notes: - All threads share a single mutex, unlocked only during file I/O => do NOT require file_hierarchy.cpp classes to be thread-safe (i.e. internally synchronized)!
+       - Independent folder pairs run in parallel (limited per device): one Workload + worker thread per folder pair, sharing the mutex and the Async Callback
        - Workload holds (folder-level-) items in buckets associated with each worker thread (FTP scenario: avoid CWDs)
        - If a worker is idle, its Workload bucket is empty and no more pending buckets available: steal from other threads (=> take half of largest bucket)
        - Maximize opportunity for parallelization ASAP: Workload buckets serve folder-items *before* files/symlinks => reduce risk of work-stealing
        - Memory consumption: work items may grow indefinitely; however: test case "C:\" ~80MB per 1 million work items
 */
 
-void FolderPairSyncer::runPass(PassNo pass, SyncCtx& syncCtx, BaseFolderPair& baseFolder, PhaseCallback& cb) //throw X
+void FolderPairSyncer::runPass(PassNo pass, const std::vector<SyncTask>& folderPairs, PhaseCallback& cb) //throw X
 {
-    std::mutex singleThread; //only a single worker thread may run at a time, except for parallel file I/O
+    PerfTraceSpan perfPass("phase", pass == PassNo::zero ? "Sync pass 0: prepare moves" :
+                           pass == PassNo::one  ? "Sync pass 1: delete" : "Sync pass 2: create, update");
+    assert(!folderPairs.empty());
+
+    std::mutex singleThread; //only a single worker thread may run at a time, except for parallel file I/O: shared by *all* folder pairs!
 
-    AsyncCallback acb;                                //
-    FolderPairSyncer fps(syncCtx, singleThread, acb); //manage life time: enclose InterruptibleThread's!!!
-    Workload workload(1, acb);
-    workload.addWorkItems(fps.getFolderLevelWorkItems(pass, baseFolder, workload)); //initial workload: set *before* threads get access!
+    AsyncCallback acb;                                                //
+    std::atomic<size_t> activeWorkloads = folderPairs.size();         //
+    std::vector<std::unique_ptr<FolderPairSyncer>> fps;               //manage life time: enclose InterruptibleThread's!!!
+    std::vector<std::unique_ptr<Workload>> workloads;                 //
+    for (const auto& [syncCtx, baseFolder] : folderPairs)
+    {
+        fps      .push_back(std::unique_ptr<FolderPairSyncer>(new FolderPairSyncer(*syncCtx, singleThread, acb)));
+        workloads.push_back(std::make_unique<Workload>(1, acb, activeWorkloads));
+        workloads.back()->addWorkItems(fps.back()->getFolderLevelWorkItems(pass, *baseFolder, *workloads.back())); //initial workload: set *before* threads get access!
+    }
 
     std::vector<InterruptibleThread> worker;
     ZEN_ON_SCOPE_EXIT( for (InterruptibleThread& wt : worker) wt.requestStop(); ); //stop *all* at the same time before join!
 
-    size_t threadIdx = 0;
-    Zstring threadName = Zstr("Sync");
-        worker.emplace_back([threadIdx, &singleThread, &acb, &workload, threadName = std::move(threadName)]
+    for (size_t folderIdx = 0; folderIdx < workloads.size(); ++folderIdx)
+    {
+        size_t threadIdx = 0;
+        Zstring threadName = Zstr("Sync");
+        worker.emplace_back([folderIdx, threadIdx, &singleThread, &acb, &workload = *workloads[folderIdx], threadName = std::move(threadName)]
         {
             setCurrentThreadName(threadName);
 
             while (/*blocking call:*/ std::function<void()> workItem = workload.getNext(threadIdx)) //throw ThreadStopRequest
             {
-                acb.notifyTaskBegin(0 /*prio*/); //same prio, while processing only one folder pair at a time
+                acb.notifyTaskBegin(folderIdx /*prio*/); //status line: prefer first folder pair
                 ZEN_ON_SCOPE_EXIT(acb.notifyTaskEnd());
 
                 std::lock_guard dummy(singleThread); //protect ALL accesses to "fps" and workItem execution!
                 workItem(); //throw ThreadStopRequest
             }
         });
+    }
     acb.waitUntilDone(UI_UPDATE_INTERVAL / 2 /*every ~25 ms*/, cb); //throw X
 }
 
@@ -2429,6 +2450,7 @@ void fff::synchronize(const std::chrono::system_clock::time_point& syncStartTime
                       ProcessCallback& callback /*throw X*/) //throw X
 {
     //PERF_START;
+    PerfTraceSpan perfPhase("phase", "Synchronize");
 
     if (syncConfig.size() != folderCmp.size())
         throw std::logic_error(std::string(__FILE__) + '[' + numberTo<std::string>(__LINE__) + "] Contract violation!");
@@ -2874,113 +2896,199 @@ void fff::synchronize(const std::chrono::system_clock::time_point& syncStartTime
 
     try
     {
-        //loop through all directory pairs
-        for (size_t folderIndex = 0; folderIndex < folderCmp.size(); ++folderIndex)
+        //per-device concurrency limit: the maximum "parallel operations" configured by any folder pair (default: 1)
+        std::map<AfsDevice, size_t> deviceParallelOps;
+        for (const FolderPairSyncCfg& folderPairCfg : syncConfig)
+            for (const auto& [afsDevice, parallelOps] : folderPairCfg.deviceParallelOps)
+            {
+                size_t& parallelOpsMax = deviceParallelOps[afsDevice];
+                parallelOpsMax = std::max(parallelOpsMax, parallelOps);
+            }
+
+        //loop through all directory pairs: consecutive independent folder pairs are synchronized in parallel
+        //- at most getDeviceParallelOps() folder pairs per device run at the same time
+        //- dependent folder pairs (same or nested base or versioning folders) are never run together => keep their order
+        //- LIMITATION: AfsDevice is coarse: native paths on Linux/macOS mostly share the root device "/", even if located on different disks
+        //  => with the default of 1 parallel operation, folder pairs on local disks are synchronized one after the other
+        for (size_t folderIndex = 0; folderIndex < folderCmp.size();)
         {
-            BaseFolderPair&          baseFolder     = folderCmp[folderIndex].ref();
-            const FolderPairSyncCfg& folderPairCfg  = syncConfig[folderIndex];
-            const SyncStatistics&    folderPairStat = folderPairStats[folderIndex];
+            std::vector<size_t> groupIndexes;
+            std::vector<AbstractPath> groupFolderPaths;
+            std::map<AfsDevice, size_t> groupDeviceUse;
+            for (; folderIndex < folderCmp.size(); ++folderIndex)
+                if (!skipFolderPair[folderIndex]) //folder pairs may be skipped after fatal errors were found
+                {
+                    const BaseFolderPair& baseFolder = folderCmp[folderIndex].ref();
 
-            if (skipFolderPair[folderIndex]) //folder pairs may be skipped after fatal errors were found
-                continue;
+                    std::vector<AbstractPath> folderPaths{baseFolder.getAbstractPath<SelectSide::left >(),
+                                                          baseFolder.getAbstractPath<SelectSide::right>()};
+                    if (const AbstractPath versioningFolderPath = createAbstractPath(syncConfig[folderIndex].versioningFolderPhrase);
+                        !AFS::isNullPath(versioningFolderPath))
+                        folderPaths.push_back(versioningFolderPath);
 
-            //------------------------------------------------------------------------------------------
-            //checking a second time: 1. a long time may have passed since syncing the previous folder pairs!
-            //                        2. expected to be run directly *before* createBaseFolder()!
-            if (!checkBaseFolderStatus<SelectSide::left >(baseFolder, callback) ||
-                !checkBaseFolderStatus<SelectSide::right>(baseFolder, callback))
-                continue;
+                    std::set<AfsDevice> devices;
+                    for (const AbstractPath& folderPath : folderPaths)
+                        devices.insert(folderPath.afsDevice);
+
+                    const bool deviceLimitReached = std::any_of(devices.begin(), devices.end(), [&](const AfsDevice& device)
+                    { return groupDeviceUse[device] >= getDeviceParallelOps(deviceParallelOps, device); });
+
+                    const bool dependsOnGroup = std::any_of(folderPaths.begin(), folderPaths.end(), [&](const AbstractPath& folderPath)
+                    {
+                        return std::any_of(groupFolderPaths.begin(), groupFolderPaths.end(), [&](const AbstractPath& groupPath)
+                        { return !!getPathDependency(folderPath, groupPath); });
+                    });
+
+                    if (!groupIndexes.empty() && (deviceLimitReached || dependsOnGroup))
+                        break;
+
+                    for (const AfsDevice& device : devices)
+                        ++groupDeviceUse[device];
+                    append(groupFolderPaths, folderPaths);
+                    groupIndexes.push_back(folderIndex);
+                }
 
-            //create base folders if not yet existing
-            if (folderPairStat.createCount() > 0 || folderPairCfg.saveSyncDB) //else: temporary network drop leading to deletions already caught by "sourceFolderMissing" check!
-                if (!createBaseFolder<SelectSide::left >(baseFolder, copyFilePermissions, callback) || //+ detect temporary network drop!!
-                    !createBaseFolder<SelectSide::right>(baseFolder, copyFilePermissions, callback))   //
+            std::vector<size_t> activeIndexes;
+            for (const size_t i : groupIndexes)
+            {
+                BaseFolderPair&          baseFolder     = folderCmp[i].ref();
+                const FolderPairSyncCfg& folderPairCfg  = syncConfig[i];
+                const SyncStatistics&    folderPairStat = folderPairStats[i];
+
+                //------------------------------------------------------------------------------------------
+                //checking a second time: 1. a long time may have passed since syncing the previous folder pairs!
+                //                        2. expected to be run directly *before* createBaseFolder()!
+                if (!checkBaseFolderStatus<SelectSide::left >(baseFolder, callback) ||
+                    !checkBaseFolderStatus<SelectSide::right>(baseFolder, callback))
                     continue;
 
+                //create base folders if not yet existing
+                if (folderPairStat.createCount() > 0 || folderPairCfg.saveSyncDB) //else: temporary network drop leading to deletions already caught by "sourceFolderMissing" check!
+                    if (!createBaseFolder<SelectSide::left >(baseFolder, copyFilePermissions, callback) || //+ detect temporary network drop!!
+                        !createBaseFolder<SelectSide::right>(baseFolder, copyFilePermissions, callback))   //
+                        continue;
+
+                activeIndexes.push_back(i);
+            }
+
             //------------------------------------------------------------------------------------------
             //update database even when sync is cancelled (or "nothing to sync"):
+            size_t dbSavedCount = 0;
             auto guardDbSave = makeGuard<ScopeGuardRunMode::onFail>([&]
             {
-                if (folderPairCfg.saveSyncDB)
-                    saveLastSynchronousState(baseFolder, failSafeFileCopy,
-                                             callbackNoThrow);
+                for (size_t j = dbSavedCount; j < activeIndexes.size(); ++j)
+                    if (syncConfig[activeIndexes[j]].saveSyncDB)
+                        saveLastSynchronousState(folderCmp[activeIndexes[j]].ref(), failSafeFileCopy,
+                                                 callbackNoThrow);
             });
 
             //------------------------------------------------------------------------------------------
             //execute synchronization recursively
-            if (getCUD(folderPairStat) > 0)
+            struct FolderPairSyncState
             {
-                callback.logMessage(_("Synchronizing folder pair:") + L' ' + getVariantNameWithSymbol(folderPairCfg.syncVar) + L'\n' + //throw X
-                                    TAB_SPACE + AFS::getDisplayPath(baseFolder.getAbstractPath<SelectSide::left >()) + L'\n' +
-                                    TAB_SPACE + AFS::getDisplayPath(baseFolder.getAbstractPath<SelectSide::right>()), PhaseCallback::MsgType::info);
-
-                //guarantee removal of invalid entries (where element is empty on both sides)
-                ZEN_ON_SCOPE_EXIT(baseFolder.removeDoubleEmpty());
+                size_t folderIndex;
+                AbstractPath versioningFolderPath;
+                DeletionHandler delHandlerL;
+                DeletionHandler delHandlerR;
+                std::optional<FolderPairSyncer::SyncCtx> syncCtx; //referencing delHandlerL/R
+            };
+            std::vector<std::unique_ptr<FolderPairSyncState>> syncStates; //DeletionHandler is not movable
 
-                bool copyPermissionsFp = false;
-                tryReportingError([&]
+            for (const size_t i : activeIndexes)
+                if (getCUD(folderPairStats[i]) > 0)
                 {
-                    copyPermissionsFp = copyFilePermissions && //copy permissions only if asked for and supported by *both* sides!
-                    AFS::supportPermissionCopy(baseFolder.getAbstractPath<SelectSide::left>(),
-                                               baseFolder.getAbstractPath<SelectSide::right>()); //throw FileError
-                }, callback); //throw X
-
-                const AbstractPath versioningFolderPath = createAbstractPath(folderPairCfg.versioningFolderPhrase);
-
-                DeletionHandler delHandlerL(baseFolder.getAbstractPath<SelectSide::left>(),
-                                            recyclerMissingReportOnce,
-                                            warnings.warnRecyclerMissing,
-                                            folderPairCfg.handleDeletion,
-                                            versioningFolderPath,
-                                            folderPairCfg.versioningStyle,
-                                            std::chrono::system_clock::to_time_t(syncStartTime));
-
-                DeletionHandler delHandlerR(baseFolder.getAbstractPath<SelectSide::right>(),
-                                            recyclerMissingReportOnce,
-                                            warnings.warnRecyclerMissing,
-                                            folderPairCfg.handleDeletion,
-                                            versioningFolderPath,
-                                            folderPairCfg.versioningStyle,
-                                            std::chrono::system_clock::to_time_t(syncStartTime));
+                    BaseFolderPair&          baseFolder    = folderCmp[i].ref();
+                    const FolderPairSyncCfg& folderPairCfg = syncConfig[i];
+
+                    callback.logMessage(_("Synchronizing folder pair:") + L' ' + getVariantNameWithSymbol(folderPairCfg.syncVar) + L'\n' + //throw X
+                                        TAB_SPACE + AFS::getDisplayPath(baseFolder.getAbstractPath<SelectSide::left >()) + L'\n' +
+                                        TAB_SPACE + AFS::getDisplayPath(baseFolder.getAbstractPath<SelectSide::right>()), PhaseCallback::MsgType::info);
+
+                    bool copyPermissionsFp = false;
+                    tryReportingError([&]
+                    {
+                        copyPermissionsFp = copyFilePermissions && //copy permissions only if asked for and supported by *both* sides!
+                        AFS::supportPermissionCopy(baseFolder.getAbstractPath<SelectSide::left>(),
+                                                   baseFolder.getAbstractPath<SelectSide::right>()); //throw FileError
+                    }, callback); //throw X
+
+                    const AbstractPath versioningFolderPath = createAbstractPath(folderPairCfg.versioningFolderPhrase);
+
+                    auto syncState = std::unique_ptr<FolderPairSyncState>(new FolderPairSyncState
+                    {
+                        i, versioningFolderPath,
+                        DeletionHandler(baseFolder.getAbstractPath<SelectSide::left>(),
+                                        recyclerMissingReportOnce,
+                                        warnings.warnRecyclerMissing,
+                                        folderPairCfg.handleDeletion,
+                                        versioningFolderPath,
+                                        folderPairCfg.versioningStyle,
+                                        std::chrono::system_clock::to_time_t(syncStartTime)),
+                        DeletionHandler(baseFolder.getAbstractPath<SelectSide::right>(),
+                                        recyclerMissingReportOnce,
+                                        warnings.warnRecyclerMissing,
+                                        folderPairCfg.handleDeletion,
+                                        versioningFolderPath,
+                                        folderPairCfg.versioningStyle,
+                                        std::chrono::system_clock::to_time_t(syncStartTime)),
+                        std::nullopt
+                    });
+                    syncState->syncCtx.emplace(FolderPairSyncer::SyncCtx
+                    {
+                        verifyCopiedFiles, copyPermissionsFp, failSafeFileCopy,
+                        syncState->delHandlerL, syncState->delHandlerR,
+                    });
+                    syncStates.push_back(std::move(syncState));
+                }
+
+            if (!syncStates.empty())
+            {
+                //guarantee removal of invalid entries (where element is empty on both sides)
+                ZEN_ON_SCOPE_EXIT(for (const std::unique_ptr<FolderPairSyncState>& ss : syncStates) folderCmp[ss->folderIndex].ref().removeDoubleEmpty());
 
                 //always (try to) clean up, even if synchronization is aborted!
                 auto guardDelCleanup = makeGuard<ScopeGuardRunMode::onFail>([&]
                 {
-                    delHandlerL.tryCleanup(callbackNoThrow);
-                    delHandlerR.tryCleanup(callbackNoThrow);
+                    for (const std::unique_ptr<FolderPairSyncState>& ss : syncStates)
+                    {
+                        ss->delHandlerL.tryCleanup(callbackNoThrow);
+                        ss->delHandlerR.tryCleanup(callbackNoThrow);
+                    }
                 });
 
+                std::vector<FolderPairSyncer::SyncTask> syncTasks;
+                for (const std::unique_ptr<FolderPairSyncState>& ss : syncStates)
+                    syncTasks.emplace_back(&*ss->syncCtx, &folderCmp[ss->folderIndex].ref());
 
-                FolderPairSyncer::SyncCtx syncCtx =
-                {
-                    verifyCopiedFiles, copyPermissionsFp, failSafeFileCopy,
-                    delHandlerL, delHandlerR,
-                };
-                FolderPairSyncer::runSync(syncCtx, baseFolder, callback);
+                FolderPairSyncer::runSync(syncTasks, callback);
 
                 //(try to gracefully) clean up temporary Recycle Bin folders and versioning
-                delHandlerL.tryCleanup(callback); //throw X
-                delHandlerR.tryCleanup(callback); //
+                for (const std::unique_ptr<FolderPairSyncState>& ss : syncStates)
+                {
+                    ss->delHandlerL.tryCleanup(callback); //throw X
+                    ss->delHandlerR.tryCleanup(callback); //
+                }
                 guardDelCleanup.dismiss();
 
-                if (folderPairCfg.handleDeletion == DeletionVariant::versioning &&
-                    folderPairCfg.versioningStyle != VersioningStyle::replace)
-                    versionLimitFolders.insert(
-                {
-                    versioningFolderPath,
-                    folderPairCfg.versionMaxAgeDays,
-                    folderPairCfg.versionCountMin,
-                    folderPairCfg.versionCountMax
-                });
+                for (const std::unique_ptr<FolderPairSyncState>& ss : syncStates)
+                    if (const FolderPairSyncCfg& folderPairCfg = syncConfig[ss->folderIndex];
+                        folderPairCfg.handleDeletion == DeletionVariant::versioning &&
+                        folderPairCfg.versioningStyle != VersioningStyle::replace)
+                        versionLimitFolders.insert(
+                    {
+                        ss->versioningFolderPath,
+                        folderPairCfg.versionMaxAgeDays,
+                        folderPairCfg.versionCountMin,
+                        folderPairCfg.versionCountMax
+                    });
             }
 
             //(try to gracefully) write database file
-            if (folderPairCfg.saveSyncDB)
-            {
-                saveLastSynchronousState(baseFolder, failSafeFileCopy,
-                                         callback /*throw X*/); //throw X
-                guardDbSave.dismiss(); //[!] dismiss *after* "graceful" try: user might cancel during DB write: ensure DB is still written
-            }
+            for (; dbSavedCount < activeIndexes.size(); ++dbSavedCount)
+                if (syncConfig[activeIndexes[dbSavedCount]].saveSyncDB)
+                    saveLastSynchronousState(folderCmp[activeIndexes[dbSavedCount]].ref(), failSafeFileCopy,
+                                             callback /*throw X*/); //throw X
+            guardDbSave.dismiss(); //[!] dismiss *after* "graceful" try: user might cancel during DB write: ensure DB is still written
         }
         //-----------------------------------------------------------------------------------------------------
 
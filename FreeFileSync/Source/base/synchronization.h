@@ -83,6 +83,7 @@ struct FolderPairSyncCfg
     int versionMaxAgeDays;
     int versionCountMin;
     int versionCountMax;
+    std::map<AfsDevice, size_t> deviceParallelOps; //max. folder pairs synchronized in parallel per device
 };
 std::vector<FolderPairSyncCfg> extractSyncCfg(const MainConfiguration& mainCfg);
 
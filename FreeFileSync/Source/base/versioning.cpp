@@ -479,7 +479,7 @@ void fff::applyVersioningLimit(const std::set<VersioningLimitFolder>& folderLimi
         callback.updateStatus(textScanning + statusLine); //throw X
     };
 
-    const std::map<DirectoryKey, DirectoryValue> folderBuf = parallelFolderScan(foldersToRead,
+    const std::map<DirectoryKey, DirectoryValue> folderBuf = parallelFolderScan(foldersToRead, {} /*deviceParallelOps*/,
     [&](const PhaseCallback::ErrorInfo& errorInfo) { return callback.reportError(errorInfo); } /*throw X*/,
     onStatusUpdate /*throw X*/, UI_UPDATE_INTERVAL / 2); //every ~25 ms
 
@@ -0,0 +1,401 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#include "benchmark.h"
+#include <bit>
+#include <random>
+#include <iostream>
+#include <zen/file_access.h>
+#include <zen/file_io.h>
+#include <zen/json.h>
+#include <zen/perf.h>
+#include <zen/scope_guard.h>
+#include <zenxml/xml.h>
+#include "../base/comparison.h"
+#include "../base/db_file.h"
+#include "../base/synchronization.h"
+#include "../status_handler.h"
+#include "../version/version.h"
+
+using namespace zen;
+using namespace fff;
+
+
+namespace
+{
+//std::mt19937_64 output is fully specified by the standard, but std::uniform_int_distribution is not => roll our own
+class SyntheticTree
+{
+public:
+    SyntheticTree(const BenchmarkConfig& cfg) : cfg_(cfg), rng_(cfg.seed) {}
+
+    void generate(const Zstring& baseFolderPath) //throw FileError
+    {
+        createDirectory(baseFolderPath); //throw FileError, ErrorTargetExisting
+        generateFolder(baseFolderPath, 0); //throw FileError
+    }
+
+    void modifyFiles() //throw FileError
+    {
+        for (const Zstring& filePath : filePaths_)
+            if (static_cast<int>(rng_() % 100) < cfg_.modifiedPercent)
+            {
+                const std::string content = generateContent();
+                setFileContent(filePath, content, nullptr /*notifyUnbufferedIO*/); //throw FileError
+                //keep current modification time: newer than generated time stamps => "different" for all compare variants
+                ++stats_.items;
+                stats_.bytes += content.size();
+            }
+    }
+
+    ProgressStats getStats() const { return stats_; }
+    const std::vector<Zstring>& getFilePaths() const { return filePaths_; }
+
+private:
+    void generateFolder(const Zstring& folderPath, size_t level) //throw FileError
+    {
+        for (size_t i = 0; i < cfg_.filesPerFolder; ++i)
+        {
+            const Zstring filePath = appendPath(folderPath, generateName(i) + Zstr(".dat"));
+            const std::string content = generateContent();
+
+            setFileContent(filePath, content, nullptr /*notifyUnbufferedIO*/); //throw FileError
+            //fixed time stamps: results must not depend on time of day; 2020-01-01 + up to one year
+            setFileTime(filePath, 1577836800 + static_cast<time_t>(rng_() % (365 * 24 * 3600)), ProcSymlink::follow); //throw FileError
+
+            filePaths_.push_back(filePath);
+            ++stats_.items;
+            stats_.bytes += content.size();
+        }
+
+        if (level < cfg_.depth)
+            for (size_t i = 0; i < cfg_.fanOut; ++i)
+            {
+                const Zstring subFolderPath = appendPath(folderPath, generateName(i));
+                createDirectory(subFolderPath); //throw FileError, ErrorTargetExisting
+                ++stats_.items;
+
+                generateFolder(subFolderPath, level + 1); //throw FileError
+            }
+    }
+
+    Zstring generateName(size_t idx)
+    {
+        //mix of 2-, 3- and 4-byte UTF-8 sequences
+        static const char* const unicodeChars[] = { "ä", "ö", "ü", "ß", "é", "ñ", "ж", "Ω", "€", "日", "本", "語", "한", "😀" };
+        static const char asciiChars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 _-";
+
+        const size_t nameLen = cfg_.nameLengthMin + (cfg_.nameLengthMax > cfg_.nameLengthMin ? rng_() % (cfg_.nameLengthMax - cfg_.nameLengthMin + 1) : 0);
+
+        std::string name;
+        for (size_t i = 0; i < nameLen; ++i)
+            if (static_cast<int>(rng_() % 100) < cfg_.unicodePercent)
+                name += unicodeChars[rng_() % std::size(unicodeChars)];
+            else
+                name += asciiChars[rng_() % (std::size(asciiChars) - 1)];
+
+        //unique within parent folder; avoid leading/trailing space
+        return utfTo<Zstring>('n' + name + '_' + numberTo<std::string>(idx));
+    }
+
+    std::string generateContent()
+    {
+        //log-uniform: pick number of significant bits first
+        const uint64_t sizeRange = cfg_.fileSizeMax - cfg_.fileSizeMin;
+        const int sizeBits = std::bit_width(sizeRange);
+        const int bits = static_cast<int>(rng_() % (sizeBits + 1));
+        const uint64_t sizeMax = bits < sizeBits ? (uint64_t(1) << bits) - 1 : sizeRange;
+        const uint64_t fileSize = cfg_.fileSizeMin + (sizeMax == 0 ? 0 : rng_() % (sizeMax + 1));
+
+        std::string content(fileSize, '\0');
+        for (size_t pos = 0; pos < content.size(); pos += sizeof(uint64_t))
+        {
+            const uint64_t val = rng_();
+            std::memcpy(&content[pos], &val, std::min(sizeof(val), content.size() - pos));
+        }
+        return content;
+    }
+
+    const BenchmarkConfig& cfg_;
+    std::mt19937_64 rng_;
+    std::vector<Zstring> filePaths_;
+    ProgressStats stats_;
+};
+
+
+//nobody's watching: stop on first error, ignore warnings
+class BenchmarkStatusHandler : public StatusHandler
+{
+public:
+    void logMessage(const std::wstring& msg, MsgType type) override
+    {
+        if (type == MsgType::error)
+            errorMsg_ = msg;
+        requestUiUpdate(false /*force*/); //throw CancelProcess
+    }
+
+    void reportWarning(const std::wstring& msg, bool& warningActive) override { requestUiUpdate(false /*force*/); } //throw CancelProcess
+
+    Response reportError(const ErrorInfo& errorInfo) override
+    {
+        errorMsg_ = errorInfo.msg;
+        cancelProcessNow(CancelReason::firstError); //throw CancelProcess
+    }
+
+    void reportFatalError(const std::wstring& msg) override
+    {
+        errorMsg_ = msg;
+        cancelProcessNow(CancelReason::firstError); //throw CancelProcess
+    }
+
+    ErrorStats getErrorStats() const override { return {.errorCount = errorMsg_.empty() ? 0 : 1, .warningCount = 0}; }
+
+    void forceUiUpdateNoThrow() override {}
+
+    const std::wstring& getErrorMessage() const { return errorMsg_; }
+
+private:
+    std::wstring errorMsg_;
+};
+
+
+JsonValue toJson(const std::string& phaseName, std::chrono::nanoseconds elapsed, const ProgressStats& stats)
+{
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+
+    JsonValue jphase(JsonValue::Type::object);
+    jphase.objectVal.emplace("phase",   JsonValue(phaseName));
+    jphase.objectVal.emplace("seconds", JsonValue(seconds));
+    jphase.objectVal.emplace("items",   JsonValue(static_cast<int64_t>(stats.items)));
+    jphase.objectVal.emplace("bytes",   JsonValue(stats.bytes));
+    if (seconds > 0)
+    {
+        jphase.objectVal.emplace("itemsPerSec", JsonValue(stats.items / seconds));
+        jphase.objectVal.emplace("bytesPerSec", JsonValue(stats.bytes / seconds));
+    }
+    return jphase;
+}
+}
+
+
+std::string fff::runBenchmark(const BenchmarkConfig& cfg) //throw FileError
+{
+    const Zstring leftPath     = appendPath(cfg.workFolderPath, Zstr("Source"));
+    const Zstring rightPath    = appendPath(cfg.workFolderPath, Zstr("Target"));
+    const Zstring versionsPath = appendPath(cfg.workFolderPath, Zstr("Versions"));
+
+    createDirectoryIfMissingRecursion(cfg.workFolderPath); //throw FileError
+
+    for (const Zstring& folderPath : {leftPath, rightPath, versionsPath})
+        if (itemExists(folderPath)) //throw FileError
+            throw FileError(replaceCpy(_("Cannot create directory %x."), L"%x", fmtPath(folderPath)), L"Item already existing."); //we're going to delete it!
+
+    ZEN_ON_SCOPE_EXIT
+    (
+        for (const Zstring& folderPath : {leftPath, rightPath, versionsPath})
+            try
+            {
+                if (itemExists(folderPath)) //throw FileError
+                    removeDirectoryPlainRecursion(folderPath); //throw FileError
+            }
+            catch (const FileError& e) { std::cerr << utfTo<std::string>(e.toString()) << std::endl; }
+    );
+
+    JsonValue jphases(JsonValue::Type::array);
+
+    auto runPhase = [&](const std::string& phaseName, const std::function<ProgressStats(BenchmarkStatusHandler& statusHandler)>& runTask) //throw FileError
+    {
+        std::cerr << phaseName << std::endl;
+
+        BenchmarkStatusHandler statusHandler;
+        StopWatch timer;
+        ProgressStats stats;
+        try
+        {
+            stats = runTask(statusHandler); //throw CancelProcess
+        }
+        catch (CancelProcess&) {}
+
+        if (statusHandler.taskCancelled())
+            throw FileError(replaceCpy<std::wstring>(L"Benchmark phase %x failed.", L"%x", utfTo<std::wstring>(phaseName)), statusHandler.getErrorMessage());
+
+        jphases.arrayVal.push_back(toJson(phaseName, timer.elapsed(), stats));
+    };
+
+    //-------------------------------------------------------------------
+    SyntheticTree tree(cfg);
+    {
+        std::cerr << "generate" << std::endl;
+        StopWatch timer;
+        tree.generate(leftPath); //throw FileError
+        createDirectory(rightPath); //throw FileError, ErrorTargetExisting
+        jphases.arrayVal.push_back(toJson("generate", timer.elapsed(), tree.getStats()));
+    }
+
+    MainConfiguration mainCfg;
+    mainCfg.firstPair.folderPathPhraseLeft  = leftPath;
+    mainCfg.firstPair.folderPathPhraseRight = rightPath;
+    mainCfg.syncCfg.directionCfg = getDefaultSyncCfg(SyncVariant::mirror); //mirror: don't measure sync.ffs_db access implicitly
+    mainCfg.syncCfg.deletionVariant = DeletionVariant::permanent;
+
+    WarningDialogs warnDlgs;
+    FolderComparison cmpResult;
+
+    auto runCompare = [&](const std::string& phaseName, CompareVariant cmpVar) //throw FileError
+    {
+        mainCfg.cmpCfg.compareVar = cmpVar;
+
+        runPhase(phaseName, [&](BenchmarkStatusHandler& statusHandler)
+        {
+            std::unique_ptr<LockHolder> dirLocks;
+            cmpResult = compare(warnDlgs,
+                                FAT_FILE_TIME_PRECISION_SEC,
+                                nullptr /*requestPassword*/,
+                                false /*runWithBackgroundPriority*/,
+                                false /*createDirLocks*/,
+                                dirLocks,
+                                extractCompareCfg(mainCfg),
+                                statusHandler); //throw CancelProcess
+            return statusHandler.getCurrentStats();
+        }); //throw FileError
+    };
+
+    auto runSync = [&](const std::string& phaseName) //throw FileError
+    {
+        runPhase(phaseName, [&](BenchmarkStatusHandler& statusHandler)
+        {
+            synchronize(std::chrono::system_clock::now(),
+                        false /*verifyCopiedFiles*/,
+                        false /*copyLockedFiles*/,
+                        false /*copyFilePermissions*/,
+                        true  /*failSafeFileCopy*/,
+                        false /*runWithBackgroundPriority*/,
+                        extractSyncCfg(mainCfg),
+                        cmpResult,
+                        warnDlgs,
+                        statusHandler); //throw CancelProcess
+            return statusHandler.getCurrentStats();
+        }); //throw FileError
+    };
+
+    runCompare("scan", CompareVariant::timeSize); //target folder still empty: traversal of source dominates
+    runSync("sync_create");
+
+    //identical trees:
+    runCompare("compare_size",    CompareVariant::size);
+    runCompare("compare_content", CompareVariant::content);
+    runCompare("compare_time",    CompareVariant::timeSize); //keep last: use for database phases
+
+    const ProgressStats dbStats{static_cast<int>(tree.getStats().items), 0};
+
+    runPhase("db_save", [&](BenchmarkStatusHandler& statusHandler)
+    {
+        saveLastSynchronousState(cmpResult[0].ref(), true /*transactionalCopy*/, statusHandler); //throw CancelProcess
+        return dbStats;
+    }); //throw FileError
+
+    runPhase("db_load", [&](BenchmarkStatusHandler& statusHandler)
+    {
+        /*const auto lastSyncStates =*/ loadLastSynchronousState({&cmpResult[0].ref()}, statusHandler); //throw CancelProcess
+        return dbStats;
+    }); //throw FileError
+
+    //GlobalSettings.xml-like document: one history entry per file
+    {
+        XmlDoc doc("FreeFileSync");
+        doc.root().setAttribute("XmlType", "GLOBAL");
+        XmlOut out(doc);
+        for (const Zstring& filePath : tree.getFilePaths())
+        {
+            XmlOut outItem = out["History"].addChild("Item");
+            outItem.attribute("LastSync", 1577836800);
+            outItem.attribute("Result", "Success");
+            outItem(filePath);
+        }
+
+        std::string stream;
+        const ProgressStats xmlStats{static_cast<int>(tree.getFilePaths().size()), 0};
+
+        runPhase("xml_serialize", [&](BenchmarkStatusHandler& statusHandler)
+        {
+            stream = serializeXml(doc);
+            return ProgressStats{xmlStats.items, static_cast<int64_t>(stream.size())};
+        }); //throw FileError
+
+        runPhase("xml_parse", [&](BenchmarkStatusHandler& statusHandler)
+        {
+            try
+            {
+                /*const XmlDoc docParsed =*/ parseXml(stream); //throw XmlParsingError
+            }
+            catch (XmlParsingError&) { assert(false); }
+            return ProgressStats{xmlStats.items, static_cast<int64_t>(stream.size())};
+        }); //throw FileError
+    }
+
+    //item name handling during compare and filtering: mixed ASCII/non-ASCII names as generated
+    {
+        std::vector<Zstring> itemNames;
+        for (const Zstring& filePath : tree.getFilePaths())
+            itemNames.push_back(getItemName(filePath));
+
+        int64_t nameBytes = 0;
+        for (const Zstring& itemName : itemNames)
+            nameBytes += itemName.size();
+
+        const ProgressStats nameStats{static_cast<int>(itemNames.size()), nameBytes};
+        const size_t repeatCount = 100; //string ops are fast: get measurable timings
+
+        runPhase("string_upper_case", [&](BenchmarkStatusHandler& statusHandler)
+        {
+            size_t checkSum = 0; //prevent optimizing away
+            for (size_t i = 0; i < repeatCount; ++i)
+                for (const Zstring& itemName : itemNames)
+                    checkSum += getUpperCase(itemName).size() + getUnicodeNormalForm(itemName).size();
+            assert(checkSum > 0);
+            return ProgressStats{nameStats.items * static_cast<int>(repeatCount), nameStats.bytes * static_cast<int64_t>(repeatCount)};
+        }); //throw FileError
+
+        runPhase("string_sort_nocase", [&](BenchmarkStatusHandler& statusHandler)
+        {
+            for (size_t i = 0; i < repeatCount; ++i)
+            {
+                std::vector<Zstring> sorted = itemNames;
+                std::sort(sorted.begin(), sorted.end(), [](const Zstring& lhs, const Zstring& rhs) { return compareNoCase(lhs, rhs) < 0; });
+            }
+            return ProgressStats{nameStats.items * static_cast<int>(repeatCount), nameStats.bytes * static_cast<int64_t>(repeatCount)};
+        }); //throw FileError
+    }
+
+    //overwritten files are moved to the versioning folder
+    tree.modifyFiles(); //throw FileError
+    mainCfg.syncCfg.deletionVariant = DeletionVariant::versioning;
+    mainCfg.syncCfg.versioningFolderPhrase = versionsPath;
+    mainCfg.syncCfg.versioningStyle = VersioningStyle::timestampFile;
+
+    runCompare("compare_modified", CompareVariant::timeSize);
+    runSync("sync_versioning");
+
+    //-------------------------------------------------------------------
+    JsonValue jconfig(JsonValue::Type::object);
+    jconfig.objectVal.emplace("depth",           JsonValue(static_cast<int64_t>(cfg.depth)));
+    jconfig.objectVal.emplace("fanOut",          JsonValue(static_cast<int64_t>(cfg.fanOut)));
+    jconfig.objectVal.emplace("filesPerFolder",  JsonValue(static_cast<int64_t>(cfg.filesPerFolder)));
+    jconfig.objectVal.emplace("fileSizeMin",     JsonValue(static_cast<int64_t>(cfg.fileSizeMin)));
+    jconfig.objectVal.emplace("fileSizeMax",     JsonValue(static_cast<int64_t>(cfg.fileSizeMax)));
+    jconfig.objectVal.emplace("nameLengthMin",   JsonValue(static_cast<int64_t>(cfg.nameLengthMin)));
+    jconfig.objectVal.emplace("nameLengthMax",   JsonValue(static_cast<int64_t>(cfg.nameLengthMax)));
+    jconfig.objectVal.emplace("unicodePercent",  JsonValue(cfg.unicodePercent));
+    jconfig.objectVal.emplace("modifiedPercent", JsonValue(cfg.modifiedPercent));
+    jconfig.objectVal.emplace("seed",            JsonValue(numberTo<std::string>(cfg.seed))); //uint64_t: don't lose precision in JSON parsers
+
+    JsonValue jresult(JsonValue::Type::object);
+    jresult.objectVal.emplace("version", JsonValue(ffsVersion));
+    jresult.objectVal.emplace("config",  std::move(jconfig));
+    jresult.objectVal.emplace("phases",  std::move(jphases));
+
+    return serializeJson(jresult);
+}
@@ -0,0 +1,41 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#ifndef BENCHMARK_H_3409871520938475
+#define BENCHMARK_H_3409871520938475
+
+#include <zen/file_error.h>
+
+
+namespace fff
+{
+//deterministic synthetic folder hierarchy: same seed and parameters => same item names, sizes and file content
+struct BenchmarkConfig
+{
+    Zstring workFolderPath; //must be empty or not existing: generated items are deleted after the run!
+
+    size_t depth          = 3; //folder levels below the base folder
+    size_t fanOut         = 4; //sub folders per folder
+    size_t filesPerFolder = 20;
+
+    uint64_t fileSizeMin = 0;           //log-uniform distribution:
+    uint64_t fileSizeMax = 1024 * 1024; //many small files, few big ones
+
+    size_t nameLengthMin = 4;
+    size_t nameLengthMax = 32;
+    int unicodePercent = 20; //probability of non-ASCII characters in item names
+
+    int modifiedPercent = 10; //files changed before the versioning run
+    uint64_t seed = 0;
+};
+
+/*  run all phases on a local folder (or tmpfs) and return machine-readable results (JSON):
+    generate | compare (scan into empty target) | sync (create) | compare time/size/content (identical trees) |
+    database save/load | XML serialize/parse | item name upper case/sort | sync with versioning (modified files)   */
+std::string runBenchmark(const BenchmarkConfig& cfg); //throw FileError
+}
+
+#endif //BENCHMARK_H_3409871520938475
@@ -0,0 +1,254 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#include "console_status_handler.h"
+#include <csignal>
+#include <iostream>
+#include <zen/extra_log.h>
+#include <zen/format_unit.h>
+
+using namespace zen;
+using namespace fff;
+
+
+namespace
+{
+//console output is not a progress dialog: don't spam stdout at 20 FPS
+constexpr std::chrono::seconds CONSOLE_STATUS_INTERVAL(1);
+
+volatile std::sig_atomic_t cancelRequestedAsync = 0;
+
+
+std::wstring getPhaseLabel(ProcessPhase phase)
+{
+    switch (phase)
+    {
+        case ProcessPhase::none:
+            return _("Initializing...");
+        case ProcessPhase::scan:
+            return _("Scanning...");
+        case ProcessPhase::binaryCompare:
+            return _("Comparing content...");
+        case ProcessPhase::sync:
+            return _("Synchronizing...");
+    }
+    assert(false);
+    return std::wstring();
+}
+}
+
+
+ConsoleStatusHandler::ConsoleStatusHandler(const std::wstring& jobName,
+                                           const std::chrono::system_clock::time_point& startTime,
+                                           bool ignoreErrors,
+                                           size_t autoRetryCount,
+                                           std::chrono::seconds autoRetryDelay) :
+    jobName_(jobName),
+    startTime_(startTime),
+    ignoreErrors_(ignoreErrors),
+    autoRetryCount_(autoRetryCount),
+    autoRetryDelay_(autoRetryDelay) {}
+
+
+void ConsoleStatusHandler::requestCancelAsync()
+{
+    cancelRequestedAsync = 1;
+}
+
+
+void ConsoleStatusHandler::logAndPrint(const std::wstring& msg, MessageType type, time_t time)
+{
+    logMsg(errorLog_.ref(), msg, type, time);
+
+    const std::string& line = formatMessage({time, type, utfTo<Zstringc>(msg)});
+    if (type == MSG_TYPE_INFO)
+        std::cout << line << std::flush;
+    else
+        std::cerr << line << std::flush;
+}
+
+
+std::pair<ProgressStats, ProgressStats> ConsoleStatusHandler::getSyncStats() const
+{
+    std::pair<ProgressStats, ProgressStats> stats{statsProcessedPrevSync_, statsTotalPrevSync_};
+    if (currentPhase() == ProcessPhase::sync)
+    {
+        stats.first .items += getCurrentStats().items;
+        stats.first .bytes += getCurrentStats().bytes;
+        stats.second.items += getTotalStats  ().items;
+        stats.second.bytes += getTotalStats  ().bytes;
+    }
+    return stats;
+}
+
+
+ConsoleStatusHandler::Result ConsoleStatusHandler::prepareResult()
+{
+    const auto totalTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - startTime_);
+
+    //append "extra" log for sync errors that could not otherwise be reported:
+    if (const ErrorLog extraLog = fetchExtraLog();
+        !extraLog.empty())
+    {
+        for (const LogEntry& entry : extraLog)
+            std::cerr << formatMessage(entry);
+
+        errorLog_.ref().append(extraLog);
+        errorLog_.ref().sortByTime();
+    }
+
+    const auto [statsProcessed, statsTotal] = getSyncStats();
+
+    //determine post-sync status irrespective of further errors during tear-down
+    assert(!syncResult_);
+    syncResult_ = [&]
+    {
+        if (taskCancelled())
+        {
+            logAndPrint(_("Stopped"), MSG_TYPE_ERROR); //= user cancel or "stop on first error"
+            return TaskResult::cancelled;
+        }
+        const ErrorLogStats logCount = getStats(errorLog_.ref());
+        if (logCount.errors > 0)
+            return TaskResult::error;
+        else if (logCount.warnings > 0)
+            return TaskResult::warning;
+
+        if (statsTotal == ProgressStats())
+            logAndPrint(_("Nothing to synchronize"), MSG_TYPE_INFO);
+        return TaskResult::success;
+    }();
+
+    assert(*syncResult_ == TaskResult::cancelled || currentPhase() == ProcessPhase::sync);
+
+    const ProcessSummary summary
+    {
+        startTime_, *syncResult_, {jobName_},
+        statsProcessed,
+        statsTotal,
+        totalTime
+    };
+
+    std::cout << utfTo<std::string>(getSyncResultLabel(*syncResult_) + L" (" +
+                                    _P("1 item", "%x items", summary.statsProcessed.items) + L", " +
+                                    formatFilesizeShort(summary.statsProcessed.bytes) + L", " +
+                                    utfTo<std::wstring>(formatTimeSpan(std::chrono::duration_cast<std::chrono::seconds>(totalTime).count())) + L')') << std::endl;
+
+    return {summary, errorLog_};
+}
+
+
+void ConsoleStatusHandler::initNewPhase(int itemsTotal, int64_t bytesTotal, ProcessPhase phaseID)
+{
+    if (currentPhase() == ProcessPhase::sync)
+        std::tie(statsProcessedPrevSync_, statsTotalPrevSync_) = getSyncStats();
+
+    StatusHandler::initNewPhase(itemsTotal, bytesTotal, phaseID);
+
+    std::cout << utfTo<std::string>(getPhaseLabel(phaseID)) << std::endl;
+    statusPrinted_.clear();
+
+    requestUiUpdate(true /*force*/); //throw CancelProcess
+}
+
+
+void ConsoleStatusHandler::logMessage(const std::wstring& msg, MsgType type)
+{
+    logAndPrint(msg, [&]
+    {
+        switch (type)
+        {
+            case MsgType::info:    return MSG_TYPE_INFO;
+            case MsgType::warning: return MSG_TYPE_WARNING;
+            case MsgType::error:   return MSG_TYPE_ERROR;
+        }
+        assert(false);
+        return MSG_TYPE_ERROR;
+    }());
+    requestUiUpdate(false /*force*/); //throw CancelProcess
+}
+
+
+void ConsoleStatusHandler::reportWarning(const std::wstring& msg, bool& warningActive)
+{
+    logAndPrint(msg, MSG_TYPE_WARNING);
+
+    //no one to confirm => same as BatchErrorHandling::cancel; inactive warning ("Don't show this warning again") => log only
+    if (warningActive && !ignoreErrors_)
+        cancelProcessNow(CancelReason::firstError); //throw CancelProcess
+
+    requestUiUpdate(false /*force*/); //throw CancelProcess
+}
+
+
+ProcessCallback::Response ConsoleStatusHandler::reportError(const ErrorInfo& errorInfo)
+{
+    //log actual fail time (not "now"!)
+    const time_t failTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now() -
+                                                                 std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::steady_clock::now() - errorInfo.failTime));
+    //auto-retry
+    if (errorInfo.retryNumber < autoRetryCount_)
+    {
+        logAndPrint(errorInfo.msg + L"\n-> " + _("Automatic retry"), MSG_TYPE_INFO, failTime);
+        delayAndCountDown(errorInfo.failTime + autoRetryDelay_ - std::chrono::steady_clock::now(),
+                          [&, statusPrefix  = _("Automatic retry") +
+                                              (errorInfo.retryNumber == 0 ? L"" : L' ' + formatNumber(errorInfo.retryNumber + 1)) + SPACED_DASH,
+                           statusPostfix = SPACED_DASH + _("Error") + L": " + replaceCpy(errorInfo.msg, L'\n', L' ')](const std::wstring& timeRemMsg)
+        { this->updateStatus(statusPrefix + timeRemMsg + statusPostfix); }); //throw CancelProcess
+        return ProcessCallback::retry;
+    }
+
+    logAndPrint(errorInfo.msg, MSG_TYPE_ERROR, failTime);
+
+    if (!ignoreErrors_)
+        cancelProcessNow(CancelReason::firstError); //throw CancelProcess
+
+    return ProcessCallback::ignore;
+}
+
+
+void ConsoleStatusHandler::reportFatalError(const std::wstring& msg)
+{
+    logAndPrint(msg, MSG_TYPE_ERROR);
+
+    if (!ignoreErrors_)
+        cancelProcessNow(CancelReason::firstError); //throw CancelProcess
+}
+
+
+Statistics::ErrorStats ConsoleStatusHandler::getErrorStats() const
+{
+    const ErrorLogStats logCount = getStats(errorLog_.ref()); //constant time
+    return {.errorCount = logCount.errors, .warningCount = logCount.warnings};
+}
+
+
+void ConsoleStatusHandler::forceUiUpdateNoThrow()
+{
+    if (cancelRequestedAsync && !taskCancelled())
+    {
+        userRequestCancel(); //=> CancelProcess thrown by requestUiUpdate()
+        std::cerr << utfTo<std::string>(_("Stop requested...")) << std::endl;
+    }
+
+    if (const auto now = std::chrono::steady_clock::now();
+        now >= lastStatusPrint_ + CONSOLE_STATUS_INTERVAL)
+        if (const std::wstring& statusText = currentStatusText();
+            statusText != statusPrinted_ && !statusText.empty())
+        {
+            lastStatusPrint_ = now;
+            statusPrinted_ = statusText;
+
+            std::wstring progress;
+            if (const ProgressStats statsTotal = getTotalStats();
+                statsTotal.items >= 0) //unknown during scan
+                progress = L'[' + formatNumber(getCurrentStats().items) + L'/' + formatNumber(statsTotal.items) + L"] ";
+            else
+                progress = L'[' + formatNumber(getCurrentStats().items) + L"] ";
+
+            std::cout << utfTo<std::string>(progress + statusText) << std::endl;
+        }
+}
@@ -0,0 +1,70 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#ifndef CONSOLE_STATUS_HANDLER_H_4038175203845702
+#define CONSOLE_STATUS_HANDLER_H_4038175203845702
+
+#include <zen/error_log.h>
+#include "../status_handler.h"
+
+
+namespace fff
+{
+//headless counterpart of BatchStatusHandler: no dialogs => nobody to ask!
+//- log messages are echoed: infos to stdout, warnings and errors to stderr
+//- warnings: like errors without auto-retry; warnings disabled via "Don't show this warning again" are only logged
+//- errors: auto-retry, then either ignore (MainConfiguration::ignoreErrors) or cancel
+class ConsoleStatusHandler : public StatusHandler
+{
+public:
+    ConsoleStatusHandler(const std::wstring& jobName, //should not be empty for a batch job!
+                         const std::chrono::system_clock::time_point& startTime,
+                         bool ignoreErrors,
+                         size_t autoRetryCount,
+                         std::chrono::seconds autoRetryDelay); //noexcept!!
+
+    void     initNewPhase    (int itemsTotal, int64_t bytesTotal, ProcessPhase phaseID) override; //
+    void     logMessage      (const std::wstring& msg, MsgType type)                    override; //
+    void     reportWarning   (const std::wstring& msg, bool& warningActive)             override; //throw CancelProcess
+    Response reportError     (const ErrorInfo& errorInfo)                               override; //
+    void     reportFatalError(const std::wstring& msg)                                  override; //
+    ErrorStats getErrorStats() const override;
+
+    void forceUiUpdateNoThrow() override; //noexcept
+
+    struct Result
+    {
+        ProcessSummary summary;
+        zen::SharedRef<zen::ErrorLog> errorLog;
+    };
+    Result prepareResult();
+
+
+    static void requestCancelAsync(); //async-signal-safe: e.g. SIGINT, SIGTERM
+
+private:
+    void logAndPrint(const std::wstring& msg, zen::MessageType type, time_t time = std::time(nullptr));
+    std::pair<ProgressStats /*processed*/, ProgressStats /*total*/> getSyncStats() const;
+
+    const std::wstring jobName_;
+    const std::chrono::system_clock::time_point startTime_;
+    const bool ignoreErrors_;
+    const size_t autoRetryCount_;
+    const std::chrono::seconds autoRetryDelay_;
+
+    zen::SharedRef<zen::ErrorLog> errorLog_ = zen::makeSharedRef<zen::ErrorLog>();
+    std::optional<TaskResult> syncResult_;
+
+    //bounded-memory mode: one sync phase per partition => report the sum
+    ProgressStats statsProcessedPrevSync_{0, 0};
+    ProgressStats statsTotalPrevSync_    {0, 0};
+
+    std::wstring statusPrinted_;
+    std::chrono::steady_clock::time_point lastStatusPrint_;
+};
+}
+
+#endif //CONSOLE_STATUS_HANDLER_H_4038175203845702
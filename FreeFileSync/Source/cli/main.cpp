@@ -0,0 +1,597 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#include <csignal>
+#include <iostream>
+#include <zen/file_access.h>
+#include <zen/file_io.h>
+#include <zen/perf.h>
+#include <zen/process_exec.h>
+#include <zen/resolve_path.h>
+#include <zenxml/xml.h>
+#include "benchmark.h"
+#include "console_status_handler.h"
+#include "subtree_partition.h"
+#include "../base/comparison.h"
+#include "../base/config_xml.h"
+#include "../base/status_handler_impl.h"
+#include "../base/synchronization.h"
+#include "../afs/concrete.h"
+#include "../ffs_paths.h"
+#include "../log_file.h"
+
+using namespace zen;
+using namespace fff;
+
+/*  ffs-cli: run .ffs_batch jobs without wxWidgets/GTK, e.g. on servers without X
+    - no dialogs: warnings and errors are ignored/cancel (errors: after auto-retry) according to the job's "Errors" settings
+    - no translations: English only
+    - "Batch" element (progress dialog, error dialog, post-sync action) is ignored
+    - multiple jobs: compared and synchronized one after the other, separate logs: see compareAndSyncJob()
+    - "-Partition": bounded memory for huge folder trees: compare and sync subtrees of limited item count one after the other (no sync.ffs_db)
+    - "-RemoteSnapshot <hours>": skip scanning SFTP/FTP/Google Drive mirror/update targets only written by FreeFileSync: see folder_snapshot.h
+    - "-Benchmark <folder>": measure scan/compare/sync/database throughput on a generated folder hierarchy    */
+
+namespace
+{
+//subset of GlobalConfig required for batch runs: config.h depends on wxWidgets
+struct CliGlobalConfig : GlobalSyncConfig
+{
+    Zstring logFolderPhrase = getLogFolderDefaultPath();
+};
+
+
+std::string getConfigType(const XmlDoc& doc)
+{
+    std::string type;
+    if (doc.root().getName() == "FreeFileSync")
+        doc.root().getAttribute("XmlType", type);
+    return type;
+}
+
+
+std::pair<MainConfiguration, std::wstring /*warningMsg*/> readJobConfig(const Zstring& filePath) //throw FileError
+{
+    const XmlDoc doc = loadXml(filePath); //throw FileError
+
+    //.ffs_gui and .ffs_batch share the same main configuration at root level
+    if (const std::string cfgType = getConfigType(doc);
+        cfgType != "BATCH" && cfgType != "GUI")
+        throw FileError(replaceCpy(_("File %x does not contain a valid configuration."), L"%x", fmtPath(filePath)));
+
+    int formatVer = 0;
+    /*bool success =*/ doc.root().getAttribute("XmlFormat", formatVer);
+
+    XmlIn in(doc);
+    MainConfiguration mainCfg;
+    readConfig(in, mainCfg, formatVer);
+
+    std::wstring warningMsg;
+    if (const std::wstring& errors = in.getErrors();
+        !errors.empty())
+        warningMsg = replaceCpy(_("Configuration file %x is incomplete. The missing elements have been set to their default values."), L"%x", fmtPath(filePath)) + L"\n\n" +
+                     _("The following XML elements could not be read:") + L'\n' + errors;
+
+    return {mainCfg, warningMsg};
+}
+
+
+CliGlobalConfig readGlobalConfig(const Zstring& filePath) //throw FileError
+{
+    const XmlDoc doc = loadXml(filePath); //throw FileError
+
+    if (getConfigType(doc) != "GLOBAL")
+        throw FileError(replaceCpy(_("File %x does not contain a valid configuration."), L"%x", fmtPath(filePath)));
+
+    int formatVer = 0;
+    /*bool success =*/ doc.root().getAttribute("XmlFormat", formatVer);
+
+    XmlIn in(doc);
+    //unlike the GUI, don't complain about missing elements: the settings file is only borrowed
+    CliGlobalConfig cfg;
+    readConfig(in, cfg, formatVer); //same as GUI: see config.cpp
+
+    if (Zstring logFolderPhrase;
+        in["LogFolder"](logFolderPhrase) && !trimCpy(logFolderPhrase).empty())
+        cfg.logFolderPhrase = resolvePortablePath(logFolderPhrase); //same as GUI: see config.cpp
+
+    return cfg;
+}
+
+
+struct BatchJob
+{
+    Zstring cfgFilePath;
+    MainConfiguration mainCfg;
+    std::wstring cfgWarningMsg;
+};
+
+
+std::wstring getJobName(const Zstring& cfgFilePath)
+{
+    return utfTo<std::wstring>(beforeLast(getItemName(cfgFilePath), Zstr('.'), IfNotFoundReturn::all));
+}
+
+
+FfsExitCode finishJob(const MainConfiguration& mainCfg, ConsoleStatusHandler& statusHandler, ConsoleStatusHandler::Result& r, const CliGlobalConfig& globalCfg)
+{
+    AbstractPath logFolderPath = createAbstractPath(mainCfg.altLogFolderPathPhrase); //optional
+    if (AFS::isNullPath(logFolderPath))
+        logFolderPath = createAbstractPath(globalCfg.logFolderPhrase);
+
+    const AbstractPath logFilePath = AFS::appendRelPath(logFolderPath, generateLogFileName(globalCfg.logFormat, r.summary));
+
+    auto notifyStatusNoThrow = [&](std::wstring&& msg) { try { statusHandler.updateStatus(std::move(msg)); /*throw CancelProcess*/ } catch (CancelProcess&) {} };
+
+    if (statusHandler.taskCancelled() && *statusHandler.taskCancelled() == CancelReason::user)
+        ; /* user cancelled => don't run post sync command
+                            => don't send email notification */
+    else
+    {
+        //--------------------- post sync command ----------------------
+        if (const Zstring cmdLine = trimCpy(expandMacros(mainCfg.postSyncCommand));
+            !cmdLine.empty())
+            if (mainCfg.postSyncCondition == PostSyncCondition::completion ||
+                (mainCfg.postSyncCondition == PostSyncCondition::errors) == (r.summary.result == TaskResult::cancelled ||
+                                                                             r.summary.result == TaskResult::error))
+                try
+                {
+                    //no GUI to keep responsive => wait for the command to finish
+                    if (const auto& [exitCode, output] = consoleExecute(cmdLine, std::nullopt /*timeoutMs*/); //throw SysError, (SysErrorTimeOut)
+                        exitCode != 0)
+                        throw SysError(formatSystemError("", replaceCpy(_("Exit code %x"), L"%x", numberTo<std::wstring>(exitCode)), utfTo<std::wstring>(output)));
+
+                    logMsg(r.errorLog.ref(), _("Executing command:") + L' ' + utfTo<std::wstring>(cmdLine) + L" [" + replaceCpy(_("Exit code %x"), L"%x", L"0") + L']', MSG_TYPE_INFO);
+                }
+                catch (const SysError& e)
+                {
+                    logMsg(r.errorLog.ref(), replaceCpy(_("Command %x failed."), L"%x", fmtPath(cmdLine)) + L"\n\n" + e.toString(), MSG_TYPE_ERROR);
+                    std::cerr << utfTo<std::string>(e.toString()) << std::endl;
+                }
+
+        //--------------------- email notification ----------------------
+        if (const std::string notifyEmail = trimCpy(mainCfg.emailNotifyAddress);
+            !notifyEmail.empty())
+            if (mainCfg.emailNotifyCondition == ResultsNotification::always ||
+                (mainCfg.emailNotifyCondition == ResultsNotification::errorWarning && (r.summary.result == TaskResult::cancelled ||
+                                                                                       r.summary.result == TaskResult::error ||
+                                                                                       r.summary.result == TaskResult::warning)) ||
+                (mainCfg.emailNotifyCondition == ResultsNotification::errorOnly && (r.summary.result == TaskResult::cancelled ||
+                                                                                    r.summary.result == TaskResult::error)))
+                try
+                {
+                    logMsg(r.errorLog.ref(), replaceCpy(_("Sending email notification to %x"), L"%x", utfTo<std::wstring>(notifyEmail)), MSG_TYPE_INFO);
+                    sendLogAsEmail(notifyEmail, r.summary, r.errorLog.ref(), logFilePath, notifyStatusNoThrow); //throw FileError
+                }
+                catch (const FileError& e)
+                {
+                    logMsg(r.errorLog.ref(), e.toString(), MSG_TYPE_ERROR);
+                    std::cerr << utfTo<std::string>(e.toString()) << std::endl;
+                }
+    }
+
+    //--------------------- save log file ----------------------
+    try
+    {
+        saveLogFile(logFilePath, r.summary, r.errorLog.ref(), globalCfg.logfilesMaxAgeDays, globalCfg.logFormat, {} /*logsToKeepPaths*/, notifyStatusNoThrow); //throw FileError
+        std::cout << utfTo<std::string>(AFS::getDisplayPath(logFilePath)) << std::endl;
+    }
+    catch (const FileError& e)
+    {
+        logMsg(r.errorLog.ref(), e.toString(), MSG_TYPE_ERROR); //affect exit code
+        std::cerr << utfTo<std::string>(e.toString()) << std::endl;
+    }
+
+    //----------------------------------------------------------------------
+    FfsExitCode exitCode = FfsExitCode::success;
+    switch (r.summary.result)
+    {
+        case TaskResult::success:   raiseExitCode(exitCode, FfsExitCode::success); break;
+        case TaskResult::warning:   raiseExitCode(exitCode, FfsExitCode::warning); break;
+        case TaskResult::error:     raiseExitCode(exitCode, FfsExitCode::error  ); break;
+        case TaskResult::cancelled: raiseExitCode(exitCode, FfsExitCode::cancelled); break;
+    }
+
+    //email sending, or saving log file failed? at least this should affect the exit code:
+    if (const ErrorLogStats& logStats = getStats(r.errorLog.ref());
+        logStats.errors > 0)
+        raiseExitCode(exitCode, FfsExitCode::error);
+    else if (logStats.warnings > 0)
+        raiseExitCode(exitCode, FfsExitCode::warning);
+
+    return exitCode;
+}
+
+
+bool isSameOrNestedPath(const AbstractPath& lhs, const AbstractPath& rhs)
+{
+    auto isSameOrParent = [](const AbstractPath& parentPath, const AbstractPath& itemPath)
+    {
+        for (std::optional<AbstractPath> path = itemPath; path; path = AFS::getParentPath(*path))
+            if (*path == parentPath)
+                return true;
+        return false;
+    };
+    return isSameOrParent(lhs, rhs) || isSameOrParent(rhs, lhs);
+}
+
+
+//folders written by more than one folder pair of any job (including nested base folders): a snapshot would miss the other pair's changes
+bool isSharedBaseFolder(const AbstractPath& folderPath, const std::vector<AbstractPath>& allBaseFolderPaths)
+{
+    size_t useCount = 0;
+    for (const AbstractPath& otherPath : allBaseFolderPaths)
+        if (isSameOrNestedPath(folderPath, otherPath))
+            ++useCount;
+    return useCount > 1;
+}
+
+
+//remote folder snapshots, see folder_snapshot.h: invalidate before sync...
+void removeFolderSnapshots(const FolderComparison& jobCmp, const std::vector<FolderPairCfg>& fpCfgList, ConsoleStatusHandler& statusHandler) //throw CancelProcess
+{
+    assert(jobCmp.size() == fpCfgList.size());
+    for (size_t i = 0; i < jobCmp.size(); ++i)
+        for (const AbstractPath& folderPath : {jobCmp[i].ref().getAbstractPath<SelectSide::left>(), jobCmp[i].ref().getAbstractPath<SelectSide::right>()})
+            if (snapshotEnabled(folderPath, fpCfgList[i].snapshotCfg))
+                tryReportingError([&] { removeFolderSnapshot(folderPath, fpCfgList[i].snapshotCfg); /*throw FileError*/ }, statusHandler); //throw CancelProcess
+}
+
+
+//...and save after a sync without errors: only then does the BaseFolderPair reflect the folder content
+void saveFolderSnapshots(const FolderComparison& jobCmp, const std::vector<FolderPairCfg>& fpCfgList, const std::vector<AbstractPath>& allBaseFolderPaths,
+                         ConsoleStatusHandler& statusHandler) //throw CancelProcess
+{
+    assert(jobCmp.size() == fpCfgList.size());
+    if (statusHandler.taskCancelled() || statusHandler.getErrorStats().errorCount > 0)
+        return;
+
+    for (size_t i = 0; i < jobCmp.size(); ++i)
+    {
+        const BaseFolderPair& baseFolder = jobCmp[i].ref();
+        const FolderPairCfg& fpCfg = fpCfgList[i];
+
+        for (const SelectSide side : {SelectSide::left, SelectSide::right})
+            if (const AbstractPath folderPath = side == SelectSide::left ? baseFolder.getAbstractPath<SelectSide::left>() : baseFolder.getAbstractPath<SelectSide::right>();
+                snapshotSupported(folderPath, side, fpCfg.directionCfg, fpCfg.snapshotCfg) && !isSharedBaseFolder(folderPath, allBaseFolderPaths))
+                try
+                {
+                    saveFolderSnapshot({folderPath, fpCfg.filter.nameFilter, fpCfg.handleSymlinks}, baseFolder, side, fpCfg.snapshotCfg); //throw FileError
+                }
+                catch (const FileError& e) { statusHandler.logMessage(e.toString(), PhaseCallback::MsgType::warning); } //throw CancelProcess
+    }
+}
+
+
+/*  run one or more jobs in a single process: each job is compared right before its own synchronization
+    - comparison errors, directory locks and the comparison result belong to the job: released before the next job starts
+    - (S)FTP/Google Drive sessions are pooled process-wide: later jobs reuse the connections of earlier ones
+    - jobs are *not* run in separate threads: comparison and synchronization expect the main thread (e.g. DirLock, DeletionHandler)  */
+void compareAndSyncJob(const BatchJob& job, ConsoleStatusHandler& statusHandler, const std::vector<AbstractPath>& allBaseFolderPaths,
+                       const CliGlobalConfig& globalCfg, const SnapshotConfig& snapshotCfg, const std::chrono::system_clock::time_point& syncStartTime)
+{
+    WarningDialogs warnDlgs = globalCfg.warnDlgs;
+    try
+    {
+        if (!job.cfgWarningMsg.empty())
+            statusHandler.logMessage(job.cfgWarningMsg, PhaseCallback::MsgType::warning); //throw CancelProcess
+
+        std::vector<FolderPairCfg> fpCfgList = extractCompareCfg(job.mainCfg);
+        for (FolderPairCfg& fpCfg : fpCfgList)
+            fpCfg.snapshotCfg = snapshotCfg;
+
+        //batch mode: place directory locks on directories during both comparison AND synchronization
+        std::unique_ptr<LockHolder> dirLocks;
+
+        FolderComparison cmpResult = compare(warnDlgs,
+                                             globalCfg.fileTimeTolerance,
+                                             nullptr /*requestPassword: no one to ask*/,
+                                             globalCfg.runWithBackgroundPriority,
+                                             globalCfg.createLockFile,
+                                             dirLocks,
+                                             fpCfgList,
+                                             statusHandler); //throw CancelProcess
+        if (cmpResult.empty())
+            return;
+
+        removeFolderSnapshots(cmpResult, fpCfgList, statusHandler); //throw CancelProcess
+
+        synchronize(syncStartTime,
+                    globalCfg.verifyFileCopy,
+                    globalCfg.copyLockedFiles,
+                    globalCfg.copyFilePermissions,
+                    globalCfg.failSafeFileCopy,
+                    globalCfg.runWithBackgroundPriority,
+                    extractSyncCfg(job.mainCfg),
+                    cmpResult,
+                    warnDlgs,
+                    statusHandler); //throw CancelProcess
+
+        saveFolderSnapshots(cmpResult, fpCfgList, allBaseFolderPaths, statusHandler); //throw CancelProcess
+    }
+    catch (CancelProcess&) {}
+}
+
+
+//bounded-memory mode: compare and sync one subtree after the other, see partitionBySubtree()
+void compareAndSyncPartitioned(const BatchJob& job, ConsoleStatusHandler& statusHandler, size_t partitionItemsMax,
+                               const CliGlobalConfig& globalCfg, const std::chrono::system_clock::time_point& syncStartTime)
+{
+    WarningDialogs warnDlgs = globalCfg.warnDlgs;
+    try
+    {
+        if (!job.cfgWarningMsg.empty())
+            statusHandler.logMessage(job.cfgWarningMsg, PhaseCallback::MsgType::warning); //throw CancelProcess
+
+        const std::vector<FolderPairCfg>     fpCfgList   = extractCompareCfg(job.mainCfg);
+        const std::vector<FolderPairSyncCfg> syncCfgList = extractSyncCfg   (job.mainCfg);
+        assert(fpCfgList.size() == syncCfgList.size());
+
+        //each partition would load and save the *full* sync.ffs_db: memory is not bounded, I/O grows with partition count
+        for (const FolderPairCfg& fpCfg : fpCfgList)
+            if (std::get_if<DirectionByChange>(&fpCfg.directionCfg.dirs))
+            {
+                statusHandler.reportFatalError(replaceCpy(_("%x does not support synchronization with a database file (sync.ffs_db), e.g. two-way. Run the job without this option."),
+                                                          L"%x", L"-Partition")); //throw CancelProcess
+                return; //even if errors are ignored: don't sync at all
+            }
+
+        //partition *all* folder pairs before syncing any: don't leave the job half-synced if one can't be partitioned
+        std::vector<std::vector<FolderPairCfg>> fpPartitions;
+        for (const FolderPairCfg& fpCfg : fpCfgList)
+            try
+            {
+                fpPartitions.push_back(partitionBySubtree(fpCfg, partitionItemsMax)); //throw FileError
+            }
+            catch (const FileError& e)
+            {
+                statusHandler.reportFatalError(e.toString()); //throw CancelProcess
+                return; //even if errors are ignored: a regular comparison might not fit into memory
+            }
+
+        for (size_t i = 0; i < fpCfgList.size(); ++i)
+        {
+            const std::vector<FolderPairCfg>& partitions = fpPartitions[i];
+
+            for (const FolderPairCfg& partition : partitions)
+            {
+                std::unique_ptr<LockHolder> dirLocks;
+
+                FolderComparison cmpResult = compare(warnDlgs,
+                                                     globalCfg.fileTimeTolerance,
+                                                     nullptr /*requestPassword: no one to ask*/,
+                                                     globalCfg.runWithBackgroundPriority,
+                                                     globalCfg.createLockFile,
+                                                     dirLocks,
+                                                     {partition},
+                                                     statusHandler); //throw CancelProcess
+                if (!cmpResult.empty())
+                    synchronize(syncStartTime,
+                                globalCfg.verifyFileCopy,
+                                globalCfg.copyLockedFiles,
+                                globalCfg.copyFilePermissions,
+                                globalCfg.failSafeFileCopy,
+                                globalCfg.runWithBackgroundPriority,
+                                {syncCfgList[i]},
+                                cmpResult,
+                                warnDlgs,
+                                statusHandler); //throw CancelProcess
+            } //free memory before next partition!
+        }
+    }
+    catch (CancelProcess&) {}
+}
+
+
+//run one or more jobs in a single process: separate status, log file, post sync command, email and exit code per job
+FfsExitCode runJobs(const std::vector<BatchJob>& jobs, const CliGlobalConfig& globalCfg, size_t partitionItemsMax /*0: no partitioning*/, const SnapshotConfig& snapshotCfg)
+{
+    assert(!jobs.empty());
+    const std::chrono::system_clock::time_point syncStartTime = std::chrono::system_clock::now();
+
+    if (!globalCfg.perfTraceFilePath.empty() || !globalCfg.perfMetricsFilePath.empty())
+        startPerfTrace();
+
+    std::vector<std::unique_ptr<ConsoleStatusHandler>> jobHandlers;
+    for (const BatchJob& job : jobs)
+        jobHandlers.push_back(std::make_unique<ConsoleStatusHandler>(getJobName(job.cfgFilePath),
+                                                                     syncStartTime,
+                                                                     job.mainCfg.ignoreErrors,
+                                                                     job.mainCfg.autoRetryCount,
+                                                                     job.mainCfg.autoRetryDelay));
+    std::vector<AbstractPath> allBaseFolderPaths; //see saveFolderSnapshots()
+    for (const BatchJob& job : jobs)
+        for (const FolderPairCfg& fpCfg : extractCompareCfg(job.mainCfg))
+            for (const Zstring& folderPathPhrase : {fpCfg.folderPathPhraseLeft_, fpCfg.folderPathPhraseRight_})
+                if (const AbstractPath folderPath = createAbstractPath(folderPathPhrase);
+                    !AFS::isNullPath(folderPath))
+                    allBaseFolderPaths.push_back(folderPath);
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        if (jobs.size() > 1)
+            std::cout << utfTo<std::string>(L"[" + getJobName(jobs[i].cfgFilePath) + L"]") << std::endl;
+
+        if (partitionItemsMax > 0)
+            compareAndSyncPartitioned(jobs[i], *jobHandlers[i], partitionItemsMax, globalCfg, syncStartTime);
+        else
+            compareAndSyncJob(jobs[i], *jobHandlers[i], allBaseFolderPaths, globalCfg, snapshotCfg, syncStartTime);
+    }
+
+    std::vector<ConsoleStatusHandler::Result> results;
+    for (std::unique_ptr<ConsoleStatusHandler>& handler : jobHandlers)
+        results.push_back(handler->prepareResult());
+
+    //--------------------- export perf trace and metrics ----------------------
+    auto savePerfData = [&](const Zstring& filePathPhrase, const std::function<std::string()>& getContent)
+    {
+        if (const Zstring filePath = trimCpy(expandMacros(filePathPhrase));
+            !filePath.empty())
+            try
+            {
+                setFileContent(filePath, getContent(), nullptr /*notifyUnbufferedIO*/); //throw FileError
+            }
+            catch (const FileError& e)
+            {
+                for (ConsoleStatusHandler::Result& r : results)
+                    logMsg(r.errorLog.ref(), e.toString(), MSG_TYPE_WARNING);
+            }
+    };
+    savePerfData(globalCfg.perfTraceFilePath,   getPerfTraceChromeJson);
+    savePerfData(globalCfg.perfMetricsFilePath, getPerfMetricsPrometheus);
+
+    //----------------------------------------------------------------------
+    FfsExitCode exitCode = FfsExitCode::success;
+    for (size_t i = 0; i < jobs.size(); ++i)
+        raiseExitCode(exitCode, finishJob(jobs[i].mainCfg, *jobHandlers[i], results[i], globalCfg));
+
+    return exitCode;
+}
+
+
+//ffs-cli -Benchmark <work folder> [-Depth 3] [-FanOut 4] [-Files 20] [-MinSize 0] [-MaxSize 1048576]
+//                                  [-MinNameLen 4] [-MaxNameLen 32] [-Unicode 20] [-Modified 10] [-Seed 0]
+int runBenchmarkCommand(int argc, char* argv[])
+{
+    auto printUsage = [&]
+    {
+        std::cerr << "Usage: " << utfTo<std::string>(getItemName(argv[0])) << " -Benchmark <work folder> [-Depth n] [-FanOut n] [-Files n] [-MinSize bytes] [-MaxSize bytes] "
+                  "[-MinNameLen n] [-MaxNameLen n] [-Unicode percent] [-Modified percent] [-Seed n]" << std::endl;
+        return static_cast<int>(FfsExitCode::exception);
+    };
+    if (argc < 3)
+        return printUsage();
+
+    BenchmarkConfig cfg;
+    cfg.workFolderPath = getResolvedFilePath(utfTo<Zstring>(argv[2]));
+
+    for (int i = 3; i < argc; i += 2)
+    {
+        if (i + 1 >= argc)
+            return printUsage();
+
+        const std::string_view optName = argv[i];
+        const std::string_view optVal  = argv[i + 1];
+
+        if      (equalAsciiNoCase(optName, "-Depth"     )) cfg.depth           = stringTo<size_t  >(optVal);
+        else if (equalAsciiNoCase(optName, "-FanOut"    )) cfg.fanOut          = stringTo<size_t  >(optVal);
+        else if (equalAsciiNoCase(optName, "-Files"     )) cfg.filesPerFolder  = stringTo<size_t  >(optVal);
+        else if (equalAsciiNoCase(optName, "-MinSize"   )) cfg.fileSizeMin     = stringTo<uint64_t>(optVal);
+        else if (equalAsciiNoCase(optName, "-MaxSize"   )) cfg.fileSizeMax     = stringTo<uint64_t>(optVal);
+        else if (equalAsciiNoCase(optName, "-MinNameLen")) cfg.nameLengthMin   = stringTo<size_t  >(optVal);
+        else if (equalAsciiNoCase(optName, "-MaxNameLen")) cfg.nameLengthMax   = stringTo<size_t  >(optVal);
+        else if (equalAsciiNoCase(optName, "-Unicode"   )) cfg.unicodePercent  = stringTo<int     >(optVal);
+        else if (equalAsciiNoCase(optName, "-Modified"  )) cfg.modifiedPercent = stringTo<int     >(optVal);
+        else if (equalAsciiNoCase(optName, "-Seed"      )) cfg.seed            = stringTo<uint64_t>(optVal);
+        else
+            return printUsage();
+    }
+    if (cfg.fileSizeMin > cfg.fileSizeMax || cfg.nameLengthMin > cfg.nameLengthMax)
+        return printUsage();
+
+    try
+    {
+        std::cout << runBenchmark(cfg) << std::endl; //throw FileError
+        return static_cast<int>(FfsExitCode::success);
+    }
+    catch (const FileError& e)
+    {
+        std::cerr << utfTo<std::string>(e.toString()) << std::endl;
+        return static_cast<int>(FfsExitCode::exception);
+    }
+}
+}
+
+
+int main(int argc, char* argv[])
+{
+    initExtraLog([](const ErrorLog& log)
+    {
+        for (const LogEntry& entry : log) //don't call functions depending on global state (which might be destroyed already!)
+            std::cerr << formatMessage(entry);
+    });
+
+    for (const int sigNum : {SIGINT, SIGTERM}) //"graceful" exit requested: cancel and still write the log file
+        if (::signal(sigNum, [](int /*unused*/) { ConsoleStatusHandler::requestCancelAsync(); }) == SIG_ERR)
+            std::cerr << utfTo<std::string>(formatSystemError("signal", getLastError())) << std::endl;
+
+    initAfs({getResourceDirPath(), getConfigDirPath()});
+    ZEN_ON_SCOPE_EXIT(teardownAfs());
+
+    if (argc >= 2 && equalAsciiNoCase(std::string_view(argv[1]), "-Benchmark"))
+        return runBenchmarkCommand(argc, argv);
+
+    //ffs-cli [-Partition [<max items>] | -RemoteSnapshot <max age hours>] <job1.ffs_batch> [<job2.ffs_batch> ...] [GlobalSettings.xml]
+    std::vector<Zstring> jobFilePaths;
+    Zstring globalCfgFilePath;
+    size_t partitionItemsMax = 0;
+    SnapshotConfig snapshotCfg;
+    bool badArgument = false;
+    for (int i = 1; i < argc; ++i)
+        if (const Zstring arg = utfTo<Zstring>(argv[i]);
+            equalAsciiNoCase(arg, Zstr("-Partition")))
+        {
+            partitionItemsMax = 1'000'000;
+            if (i + 1 < argc) //optional: <max items>
+                if (const std::string_view nextArg = argv[i + 1];
+                    !nextArg.empty() && std::all_of(nextArg.begin(), nextArg.end(), [](char c) { return isDigit(c); }))
+                {
+                    partitionItemsMax = stringTo<size_t>(nextArg);
+                    ++i;
+                    if (partitionItemsMax == 0)
+                        badArgument = true;
+                }
+        }
+        else if (equalAsciiNoCase(arg, Zstr("-RemoteSnapshot")) && i + 1 < argc)
+        {
+            snapshotCfg.snapshotFolderPath = appendPath(getConfigDirPath(), Zstr("Snapshots"));
+            snapshotCfg.maxAge = std::chrono::hours(stringTo<int>(std::string_view(argv[++i])));
+            if (snapshotCfg.maxAge <= std::chrono::seconds(0))
+                badArgument = true;
+        }
+        else if (startsWith(arg, Zstr('-')))
+            badArgument = true;
+        else if (endsWithAsciiNoCase(arg, Zstr(".xml")))
+            globalCfgFilePath = arg;
+        else
+            jobFilePaths.push_back(arg);
+
+    if (partitionItemsMax > 0 && !snapshotCfg.snapshotFolderPath.empty()) //partitions share base folders: one snapshot per folder would be overwritten
+        badArgument = true;
+
+    if (jobFilePaths.empty() || badArgument)
+    {
+        std::cerr << "Usage: " << utfTo<std::string>(getItemName(argv[0])) << " [-Partition [<max items>] | -RemoteSnapshot <max age hours>] <job.ffs_batch> [<job2.ffs_batch> ...] [GlobalSettings.xml]\n"
+                  "  -Partition       compare and sync one subtree after the other, at most <max items> each (default: 1000000);\n"
+                  "                   fails if a folder can't be split that far; not for two-way sync (sync.ffs_db)\n"
+                  "  -RemoteSnapshot  reuse the listing of SFTP/FTP/Google Drive folders left by the last sync instead of scanning them:\n"
+                  "                   only for mirror/update targets that no one but FreeFileSync writes to.\n"
+                  "                   Snapshots of base folders nested inside each other are not invalidated across runs: don't combine them!" << std::endl;
+        return static_cast<int>(FfsExitCode::exception);
+    }
+
+    try
+    {
+        CliGlobalConfig globalCfg;
+        if (!globalCfgFilePath.empty())
+            globalCfg = readGlobalConfig(getResolvedFilePath(globalCfgFilePath)); //throw FileError
+
+        std::vector<BatchJob> jobs;
+        for (const Zstring& filePath : jobFilePaths)
+        {
+            const Zstring cfgFilePath = getResolvedFilePath(filePath);
+            auto [mainCfg, warningMsg] = readJobConfig(cfgFilePath); //throw FileError
+            jobs.push_back({cfgFilePath, std::move(mainCfg), std::move(warningMsg)});
+        }
+
+        return static_cast<int>(runJobs(jobs, globalCfg, partitionItemsMax, snapshotCfg));
+    }
+    catch (const FileError& e)
+    {
+        std::cerr << utfTo<std::string>(e.toString()) << std::endl;
+        return static_cast<int>(FfsExitCode::exception);
+    }
+}
@@ -0,0 +1,190 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#include "subtree_partition.h"
+#include <zen/format_unit.h>
+#include "../afs/concrete.h"
+
+using namespace zen;
+using namespace fff;
+
+
+namespace
+{
+//filter phrases have no escaping => folder name must match itself only
+bool canUseAsFilterPhrase(const Zstring& folderName)
+{
+    return !folderName.empty() &&
+           trimCpy(folderName) == folderName &&
+           !contains(folderName, Zstr('*')) &&
+           !contains(folderName, Zstr('?')) &&
+           !contains(folderName, Zstr(':')) &&
+           !contains(folderName, Zstr('\\')) &&
+           !contains(folderName, Zstr('\n')) &&
+           !contains(folderName, FILTER_ITEM_SEPARATOR);
+}
+
+
+FolderPairCfg copyWithFilter(const FolderPairCfg& fpCfg, const FilterRef& nameFilter)
+{
+    return
+    {
+        fpCfg.folderPathPhraseLeft_, fpCfg.folderPathPhraseRight_,
+        fpCfg.compareVar,
+        fpCfg.handleSymlinks,
+        fpCfg.ignoreTimeShiftMinutes,
+        NormalizedFilter(nameFilter, fpCfg.filter.timeSizeFilter),
+        fpCfg.directionCfg
+    };
+}
+
+
+struct FolderContent
+{
+    size_t itemCount = 0; //files, folders and symlinks directly inside (sum of both sides)
+    std::map<Zstring /*upper case*/, Zstring> subfolderNames; //filter is case-insensitive => so must be the partitions
+    std::vector<Zstring> subfolderNamesNoPhrase; //can't be expressed as a filter phrase
+};
+
+
+FolderContent getFolderContent(const std::vector<AbstractPath>& baseFolderPaths, const Zstring& relPath, const PathFilter& filter) //throw FileError
+{
+    FolderContent content;
+
+    for (const AbstractPath& baseFolderPath : baseFolderPaths)
+        if (const AbstractPath folderPath = AFS::appendRelPath(baseFolderPath, relPath);
+            const std::optional<AFS::ItemType> type = AFS::getItemTypeIfExists(folderPath)) //throw FileError
+            if (*type != AFS::ItemType::file) //not existing: e.g. initial sync or folder on other side only
+                AFS::traverseFolder(folderPath, //throw FileError
+                [&](const AFS::FileInfo& fi)
+                {
+                    if (filter.passFileFilter(appendPath(relPath, fi.itemName)))
+                        ++content.itemCount;
+                },
+                [&](const AFS::FolderInfo& fi)
+                {
+                    bool childItemMightMatch = true;
+                    if (!filter.passDirFilter(appendPath(relPath, fi.itemName), &childItemMightMatch) && !childItemMightMatch)
+                        return; //excluded by user: nothing to do
+
+                    ++content.itemCount;
+                    if (canUseAsFilterPhrase(fi.itemName))
+                        content.subfolderNames.emplace(getUpperCase(fi.itemName), fi.itemName);
+                    else if (std::find(content.subfolderNamesNoPhrase.begin(), content.subfolderNamesNoPhrase.end(), fi.itemName) == content.subfolderNamesNoPhrase.end())
+                        content.subfolderNamesNoPhrase.push_back(fi.itemName);
+                },
+                [&](const AFS::SymlinkInfo& si)
+                {
+                    if (filter.passFileFilter(appendPath(relPath, si.itemName)))
+                        ++content.itemCount;
+                });
+    return content;
+}
+
+
+//depth-first: memory ~ folder depth; stop counting once "itemCountMax" is exceeded
+size_t countSubtreeItems(const std::vector<AbstractPath>& baseFolderPaths, const Zstring& relPath, const PathFilter& filter, size_t itemCountMax) //throw FileError
+{
+    const FolderContent content = getFolderContent(baseFolderPaths, relPath, filter); //throw FileError
+    size_t itemCount = content.itemCount;
+
+    auto countSubfolder = [&](const Zstring& folderName)
+    {
+        if (itemCount <= itemCountMax)
+            itemCount += countSubtreeItems(baseFolderPaths, appendPath(relPath, folderName), filter, itemCountMax - itemCount); //throw FileError
+    };
+    for (const auto& [folderNameUpper, folderName] : content.subfolderNames)
+        countSubfolder(folderName);
+    for (const Zstring& folderName : content.subfolderNamesNoPhrase)
+        countSubfolder(folderName);
+
+    return itemCount;
+}
+
+
+//"relPath" partition first: creates/deletes the folder before its subtree partitions are synced
+void partitionFolder(const FolderPairCfg& fpCfg, const std::vector<AbstractPath>& baseFolderPaths, const Zstring& relPath, size_t itemCountMax,
+                     std::vector<FolderPairCfg>& partitions) //throw FileError
+{
+    const FilterRef& nameFilter = fpCfg.filter.nameFilter;
+
+    const FolderContent content = getFolderContent(baseFolderPaths, relPath, nameFilter.ref()); //throw FileError
+
+    //items directly inside the folder + subtrees that can't be expressed as filter phrase: can't be split any further
+    size_t restCount = content.itemCount;
+    for (const Zstring& folderName : content.subfolderNamesNoPhrase)
+        if (restCount <= itemCountMax)
+            restCount += countSubtreeItems(baseFolderPaths, appendPath(relPath, folderName), nameFilter.ref(), itemCountMax - restCount); //throw FileError
+
+    if (restCount > itemCountMax)
+        throw FileError(replaceCpy(replaceCpy(_("Cannot split %x into partitions of at most %y items."),
+                                              L"%x", fmtPath(AFS::getDisplayPath(AFS::appendRelPath(baseFolderPaths[0], relPath)))),
+                                   L"%y", formatNumber(itemCountMax)),
+                        _("The folder contains too many items that can't be split into subfolder partitions."));
+
+    Zstring restExcluded;
+    std::vector<FolderPairCfg> subPartitions;
+
+    Zstring bundleIncluded; //small subtrees: combine into one partition
+    size_t bundleCount = 0;
+    auto flushBundle = [&]
+    {
+        if (!bundleIncluded.empty())
+            subPartitions.push_back(copyWithFilter(fpCfg, combineFilters(nameFilter, makeSharedRef<NameFilter>(bundleIncluded, Zstring()))));
+        bundleIncluded.clear();
+        bundleCount = 0;
+    };
+
+    for (const auto& [folderNameUpper, folderName] : content.subfolderNames)
+    {
+        const Zstring subRelPath = appendPath(relPath, folderName);
+        const size_t subtreeCount = countSubtreeItems(baseFolderPaths, subRelPath, nameFilter.ref(), itemCountMax); //throw FileError
+
+        if (restCount + subtreeCount <= itemCountMax)
+        {
+            restCount += subtreeCount; //keep in "relPath" partition
+            continue;
+        }
+
+        const Zstring filterPhrase = FILE_NAME_SEPARATOR + subRelPath + FILE_NAME_SEPARATOR;
+        restExcluded += filterPhrase + Zstr('\n');
+
+        if (subtreeCount > itemCountMax)
+            partitionFolder(fpCfg, baseFolderPaths, subRelPath, itemCountMax, subPartitions); //throw FileError
+        else
+        {
+            if (bundleCount + subtreeCount > itemCountMax)
+                flushBundle();
+            bundleIncluded += filterPhrase + Zstr('\n');
+            bundleCount += subtreeCount;
+        }
+    }
+    flushBundle();
+
+    const Zstring restIncluded = relPath.empty() ? Zstring(Zstr("*")) : FILE_NAME_SEPARATOR + relPath + FILE_NAME_SEPARATOR;
+    partitions.push_back(copyWithFilter(fpCfg, combineFilters(nameFilter, makeSharedRef<NameFilter>(restIncluded, restExcluded))));
+
+    for (const FolderPairCfg& subPartition : subPartitions)
+        partitions.push_back(subPartition); //FolderPairCfg is not assignable => no zen::append()
+}
+}
+
+
+std::vector<FolderPairCfg> fff::partitionBySubtree(const FolderPairCfg& fpCfg, size_t itemCountMax) //throw FileError
+{
+    std::vector<AbstractPath> baseFolderPaths;
+    for (const Zstring& folderPathPhrase : {fpCfg.folderPathPhraseLeft_, fpCfg.folderPathPhraseRight_})
+        if (const AbstractPath folderPath = createAbstractPath(folderPathPhrase);
+            !AFS::isNullPath(folderPath))
+            baseFolderPaths.push_back(folderPath);
+
+    if (baseFolderPaths.empty())
+        return {fpCfg}; //nothing to traverse => nothing to partition
+
+    std::vector<FolderPairCfg> partitions;
+    partitionFolder(fpCfg, baseFolderPaths, Zstring(), itemCountMax, partitions); //throw FileError
+    return partitions;
+}
@@ -0,0 +1,30 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#ifndef SUBTREE_PARTITION_H_1850973245092834
+#define SUBTREE_PARTITION_H_1850973245092834
+
+#include "../base/comparison.h"
+
+
+namespace fff
+{
+/*  bounded-memory mode for huge folder trees: split a folder pair into subtree partitions of at most "itemCountMax" items
+    => compare and sync one partition after the other: peak memory ~ biggest partition instead of whole tree
+
+    - same base folders for all partitions, only the hard filter differs:
+        1. items directly inside a folder + all subfolders that can't be expressed as a filter phrase + small subfolders that still fit
+        2. subfolders exceeding the budget: split recursively; remaining small subfolders are bundled into partitions up to the budget
+    - item count = sum of both sides, respecting the folder pair's filter (conservative: comparison merges items existing on both sides)
+    - throws FileError if a folder can't be split within the budget (e.g. too many files directly inside one folder)
+    - partition sizes are counted by extra traversals: oversized subtrees are traversed once more per nesting level
+    - NOT for folder pairs using sync.ffs_db (e.g. two-way): each partition would load and save the full database
+      => memory would not be bounded => rejected by ffs-cli
+    - moves across partitions are not detected => (conservatively) synced as deletion + creation          */
+std::vector<FolderPairCfg> partitionBySubtree(const FolderPairCfg& fpCfg, size_t itemCountMax); //throw FileError
+}
+
+#endif //SUBTREE_PARTITION_H_1850973245092834
@@ -12,6 +12,7 @@
 #include <wx+/darkmode.h>
 #include "localization.h"
 #include "log_file.h"
+#include "ffs_paths.h"
 #include "base/structures.h"
 #include "ui/file_grid_attr.h"
 #include "ui/tree_grid_attr.h" //RTS: avoid tree grid's "file_hierarchy.h" dependency!
@@ -115,7 +116,6 @@ struct ViewFilterDefault
 
 
 Zstring getGlobalConfigDefaultPath();
-Zstring getLogFolderDefaultPath();
 
 struct DpiLayout
 {
@@ -142,31 +142,20 @@ struct DpiLayout
 };
 
 
-struct GlobalConfig
+struct GlobalConfig : GlobalSyncConfig
 {
     GlobalConfig();
 
     //---------------------------------------------------------------------
-    //Shared (GUI/BATCH) settings
+    //Shared (GUI/BATCH) settings: see GlobalSyncConfig
     wxLanguage programLanguage = getDefaultLanguage();
     zen::ColorTheme appColorTheme = zen::ColorTheme::System;
-    bool failSafeFileCopy = true;
-    bool copyLockedFiles  = false; //safer default: avoid copies of partially written files
-    bool copyFilePermissions = false;
-
-    unsigned int fileTimeTolerance = zen::FAT_FILE_TIME_PRECISION_SEC; //default 2s: FAT vs NTFS
-    bool runWithBackgroundPriority = false;
-    bool createLockFile = true;
-    bool verifyFileCopy = false;
-    int logfilesMaxAgeDays = 30; //<= 0 := no limit; for log files under %AppData%\FreeFileSync\Logs
-    LogFileFormat logFormat = LogFileFormat::html;
 
     Zstring soundFileCompareFinished;
     Zstring soundFileSyncFinished;
     Zstring soundFileAlertPending;
 
     ConfirmationDialogs confirmDlgs;
-    WarningDialogs warnDlgs;
 
     //---------------------------------------------------------------------
 
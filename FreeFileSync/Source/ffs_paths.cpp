@@ -89,6 +89,24 @@ Zstring fff::getConfigDirPath()
 }
 
 
+Zstring fff::getLogFolderDefaultPath() { return appendPath(getConfigDirPath(), Zstr("Logs")); }
+
+
+Zstring fff::resolvePortablePath(const Zstring& portablePathPhrase)
+{
+    const Zstring& pathTrm = trimCpy(portablePathPhrase);
+
+    if (startsWith(pathTrm, Zstr("%ffs_path%")))
+        return appendPath(getInstallDirPath(), afterFirst(pathTrm, FILE_NAME_SEPARATOR, IfNotFoundReturn::none)); //caveat: appendPath() requires relPath!
+
+    //TODO: remove parameter migration after some time! 2022-06-14
+    if (startsWith(pathTrm, Zstr("%ffs_resource%")))
+        return appendPath(getResourceDirPath(), afterFirst(pathTrm, FILE_NAME_SEPARATOR, IfNotFoundReturn::none));
+
+    return portablePathPhrase;
+}
+
+
 //this function is called by RealTimeSync!!!
 Zstring fff::getFreeFileSyncLauncherPath() //throw FileError
 {
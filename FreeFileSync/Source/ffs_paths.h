@@ -19,9 +19,14 @@ Zstring getResourceDirPath();
 Zstring getConfigDirPath();
 //------------------------------------------------------------------------------
 
+Zstring getLogFolderDefaultPath(); //GUI and ffs-cli
+
 
 Zstring getInstallDirPath();
 
+//expand "%ffs_path%" placeholder of portable installations
+Zstring resolvePortablePath(const Zstring& portablePathPhrase);
+
 Zstring getFreeFileSyncLauncherPath(); //throw FileError
 //full path to application launcher C:\...\FreeFileSync.exe
 }
@@ -5,9 +5,11 @@
 // *****************************************************************************
 
 #include "icon_buffer.h"
-#include <map>
+#include <list>
 #include <variant>
+#include <unordered_map>
 #include <zen/thread.h> //includes <std/thread.hpp>
+#include <zen/scope_guard.h>
 #include <wx+/dc.h>
 #include <wx+/image_resources.h>
 #include <wx+/std_button_layout.h>
@@ -23,6 +25,8 @@ namespace
 {
 const size_t BUFFER_SIZE_MAX = 1000; //maximum number of icons to hold in buffer: must be big enough to hold visible icons + preload buffer!
 
+const size_t WORKER_THREAD_COUNT_MAX = 4; //thumbnail decoding is CPU-bound, file icons are not => don't go overboard
+
 
 }
 
@@ -95,11 +99,27 @@ public:
         assert(!runningOnMainThread());
         std::unique_lock dummy(lockFiles_);
 
-        interruptibleWait(conditionNewWork_, dummy, [this] { return !workLoad_.empty(); }); //throw ThreadStopRequest
+        for (;;)
+        {
+            interruptibleWait(conditionNewWork_, dummy, [this] { return !workLoad_.empty(); }); //throw ThreadStopRequest
+
+            AbstractPath filePath = workLoad_.    back(); //yes, no strong exception guarantee (std::bad_alloc)
+            /**/                    workLoad_.pop_back(); //
+
+            //another worker is already loading this icon => skip: it will be in the buffer soon
+            if (std::find(inProgress_.begin(), inProgress_.end(), filePath) == inProgress_.end())
+            {
+                inProgress_.push_back(filePath);
+                return filePath;
+            }
+        }
+    }
 
-        AbstractPath filePath = workLoad_.    back(); //yes, no strong exception guarantee (std::bad_alloc)
-        /**/                    workLoad_.pop_back(); //
-        return filePath;
+    //context of worker thread: call *after* Buffer::insert()
+    void markDone(const AbstractPath& filePath)
+    {
+        std::lock_guard dummy(lockFiles_);
+        std::erase(inProgress_, filePath);
     }
 
 private:
@@ -107,6 +127,7 @@ private:
     std::mutex                lockFiles_;
     std::condition_variable   conditionNewWork_; //signal event: data for processing available
     std::vector<AbstractPath> workLoad_; //processes last elements of vector first!
+    std::vector<AbstractPath> inProgress_; //at most one item per worker thread
 };
 
 
@@ -117,7 +138,7 @@ public:
     bool hasIcon(const AbstractPath& filePath) const
     {
         std::lock_guard dummy(lockIconList_);
-        return iconList.contains(filePath);
+        return iconMap_.contains(filePath);
     }
 
     //- must be called by main thread only! => wxImage is NOT thread-safe like an int (non-atomic ref-count!!!)
@@ -127,13 +148,13 @@ public:
         assert(runningOnMainThread());
         std::lock_guard dummy(lockIconList_);
 
-        auto it = iconList.find(filePath);
-        if (it == iconList.end())
+        auto it = iconMap_.find(filePath);
+        if (it == iconMap_.end())
             return {};
 
-        markAsHot(it);
+        markAsHot(it->second);
 
-        IconData& idata = refData(it);
+        IconData& idata = it->second->second;
 
         if (ImageHolder* ih = std::get_if<ImageHolder>(&idata.iconHolder))
         {
@@ -161,13 +182,14 @@ public:
     {
         std::lock_guard dummy(lockIconList_);
 
-        //thread safety: moving ImageHolder is free from side effects, but ~wxImage() is NOT! => do NOT delete items from iconList here!
-        const auto [it, inserted] = iconList.try_emplace(filePath);
+        //thread safety: moving ImageHolder is free from side effects, but ~wxImage() is NOT! => do NOT delete items from buffer here!
+        const auto [it, inserted] = iconMap_.try_emplace(filePath);
         assert(inserted);
         if (inserted)
         {
-            refData(it).iconHolder = std::move(ih);
-            priorityListPushBack(it);
+            priorityList_.emplace_back(filePath, IconData());
+            priorityList_.back().second.iconHolder = std::move(ih);
+            it->second = std::prev(priorityList_.end());
         }
     }
 
@@ -178,81 +200,16 @@ public:
         assert(runningOnMainThread());
         std::lock_guard dummy(lockIconList_);
 
-        while (iconList.size() > BUFFER_SIZE_MAX)
+        while (iconMap_.size() > BUFFER_SIZE_MAX)
         {
-            auto itDelPos = firstInsertPos_;
-            priorityListPopFront();
-            iconList.erase(itDelPos); //remove oldest element
+            iconMap_.erase(priorityList_.front().first); //remove oldest element
+            priorityList_.pop_front();                   //
         }
     }
 
 private:
-    struct IconData;
-    using FileIconMap = std::map<AbstractPath, IconData>;
-    IconData& refData(FileIconMap::iterator it) { return it->second; }
-
-    //call while holding lock:
-    void priorityListPopFront()
-    {
-        assert(firstInsertPos_!= iconList.end());
-        firstInsertPos_ = refData(firstInsertPos_).next;
-
-        if (firstInsertPos_ != iconList.end())
-            refData(firstInsertPos_).prev = iconList.end();
-        else //priority list size > BUFFER_SIZE_MAX in this context, but still for completeness:
-            lastInsertPos_ = iconList.end();
-    }
-
-    //call while holding lock:
-    void priorityListPushBack(FileIconMap::iterator it)
-    {
-        if (lastInsertPos_ == iconList.end())
-        {
-            assert(firstInsertPos_ == iconList.end());
-            firstInsertPos_ = lastInsertPos_ = it;
-            refData(it).prev = refData(it).next = iconList.end();
-        }
-        else
-        {
-            refData(it).next = iconList.end();
-            refData(it).prev = lastInsertPos_;
-            refData(lastInsertPos_).next = it;
-            lastInsertPos_ = it;
-        }
-    }
-
-    //call while holding lock:
-    void markAsHot(FileIconMap::iterator it) //mark existing buffer entry as if newly inserted
-    {
-        assert(it != iconList.end());
-        if (refData(it).next != iconList.end())
-        {
-            if (refData(it).prev != iconList.end())
-            {
-                refData(refData(it).prev).next = refData(it).next; //remove somewhere from the middle
-                refData(refData(it).next).prev = refData(it).prev; //
-            }
-            else
-            {
-                assert(it == firstInsertPos_);
-                priorityListPopFront();
-            }
-            priorityListPushBack(it);
-        }
-        else
-        {
-            if (refData(it).prev != iconList.end())
-                assert(it == lastInsertPos_); //nothing to do
-            else
-                assert(iconList.size() == 1 && it == firstInsertPos_ && it == lastInsertPos_); //nothing to do
-        }
-    }
-
     struct IconData
     {
-        IconData() {}
-        IconData(IconData&& tmp) noexcept : iconHolder(std::move(tmp.iconHolder)), iconImg(std::move(tmp.iconImg)), prev(tmp.prev), next(tmp.next) {}
-
         std::variant<ImageHolder, FileIconHolder> iconHolder; //native icon representation: may be used by any thread
 
         std::unique_ptr<wxImage> iconImg; //use ONLY from main thread!
@@ -260,15 +217,18 @@ private:
         //- prohibit implicit calls to wxImage()
         //- prohibit calls to ~wxImage() and transitively ~IconData()
         //- prohibit even wxImage() default constructor - better be safe than sorry!
-
-        FileIconMap::iterator prev; //store list sorted by time of insertion into buffer
-        FileIconMap::iterator next; //
     };
 
+    struct PathHash { size_t operator()(const AbstractPath& ap) const { return std::hash<Zstring>()(ap.afsPath.value); } }; //devices are rarely mixed: let operator== sort them out
+
+    using PriorityList = std::list<std::pair<AbstractPath, IconData>>; //sorted by time of last access: LRU at the front, MRU at the back
+
+    //call while holding lock:
+    void markAsHot(PriorityList::iterator it) { priorityList_.splice(priorityList_.end(), priorityList_, it); } //mark existing buffer entry as if newly inserted
+
     mutable std::mutex lockIconList_;
-    FileIconMap iconList; //shared resource; Zstring is thread-safe like an int
-    FileIconMap::iterator firstInsertPos_ = iconList.end();
-    FileIconMap::iterator lastInsertPos_  = iconList.end();
+    PriorityList priorityList_; //shared resource; AbstractPath is thread-safe like an int
+    std::unordered_map<AbstractPath, PriorityList::iterator, PathHash> iconMap_; //list iterators remain valid until erased => O(1) lookup + LRU update
 };
 
 //################################################################################################################################################
@@ -282,7 +242,7 @@ struct IconBuffer::Impl
     WorkLoad workload; //manage life time: enclose InterruptibleThread's (until joined)!!!
     Buffer   buffer;   //
 
-    InterruptibleThread worker;
+    std::vector<InterruptibleThread> workers;
     //-------------------------
     //-------------------------
     std::unordered_map<Zstring, wxImage, StringHashAsciiNoCase, StringEqualAsciiNoCase> extensionIcons; //no item count limit!? Test case C:\ ~ 3800 unique file extensions
@@ -291,7 +251,10 @@ struct IconBuffer::Impl
 
 IconBuffer::IconBuffer(IconSize sz) : pimpl_(std::make_unique<Impl>()), iconSizeType_(sz)
 {
-    pimpl_->worker = InterruptibleThread([&workload = pimpl_->workload, &buffer = pimpl_->buffer, sz]
+    const size_t threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, WORKER_THREAD_COUNT_MAX);
+
+    for (size_t i = 0; i < threadCount; ++i)
+        pimpl_->workers.emplace_back([&workload = pimpl_->workload, &buffer = pimpl_->buffer, sz]
     {
         setCurrentThreadName(Zstr("Icon Buffer"));
 
@@ -299,6 +262,7 @@ IconBuffer::IconBuffer(IconSize sz) : pimpl_(std::make_unique<Impl>()), iconSize
         {
             //start work: blocks until next icon to load is retrieved:
             const AbstractPath itemPath = workload.extractNext(); //throw ThreadStopRequest
+            ZEN_ON_SCOPE_EXIT(workload.markDone(itemPath));
 
             if (!buffer.hasIcon(itemPath)) //perf: workload may contain duplicate entries?
                 buffer.insert(itemPath, getDisplayIcon(itemPath, sz));
@@ -310,8 +274,12 @@ IconBuffer::IconBuffer(IconSize sz) : pimpl_(std::make_unique<Impl>()), iconSize
 IconBuffer::~IconBuffer()
 {
     setWorkload({}); //make sure interruption point is always reached! needed???
-    pimpl_->worker.requestStop(); //end thread life time *before*
-    pimpl_->worker.join();        //IconBuffer::Impl member clean up!
+
+    for (InterruptibleThread& worker : pimpl_->workers)
+        worker.requestStop(); //end thread life time *before*
+
+    for (InterruptibleThread& worker : pimpl_->workers)
+        worker.join();        //IconBuffer::Impl member clean up!
 }
 
 
@@ -88,9 +88,31 @@ FFSTranslation::FFSTranslation(const std::string& lngStream, bool haveRtlLayout)
 }
 
 
+//header is at the beginning of the file => don't decompress all translations just to list them
+std::string readLngHeader(wxInputStream& stream)
+{
+    std::string headerStream;
+    char buffer[1024];
+    while (!contains(headerStream, "<source>")) //header ends where the first translation item begins
+    {
+        const size_t bytesRead = stream.Read(buffer, sizeof(buffer)).LastRead();
+        if (bytesRead == 0)
+            break;
+        headerStream.append(buffer, bytesRead);
+    }
+    return headerStream;
+}
+
+
 std::vector<TranslationInfo> loadTranslations(const Zstring& zipPath) //throw FileError
 {
-    std::vector<std::pair<Zstring /*file path*/, std::string /*byte stream*/>> streams;
+    struct LngFile
+    {
+        Zstring filePath;
+        std::string headerStream;
+        std::function<std::string()> getLngStream; //throw FileError
+    };
+    std::vector<LngFile> lngFiles;
     [&]
     {
         std::string rawStream;
@@ -109,14 +131,20 @@ std::vector<TranslationInfo> loadTranslations(const Zstring& zipPath) //throw Fi
                 if (endsWith(fi.fullPath, Zstr(".lng")))
                 {
                     std::string stream = getFileContent(fi.fullPath, nullptr /*notifyUnbufferedIO*/); //throw FileError
-                    streams.emplace_back(fi.fullPath, std::move(stream));
+                    lngFiles.push_back({fi.fullPath, std::move(stream), [filePath = fi.fullPath]
+                    {
+                        return getFileContent(filePath, nullptr /*notifyUnbufferedIO*/); //throw FileError
+                    }});
                 }
             }, nullptr, nullptr); //throw FileError
             return;
         }
         //-------------------------------------------------------------
 
-        wxMemoryInputStream byteStream(rawStream.c_str(), rawStream.size()); //does not take ownership
+        //keep the compressed stream only: decompress the selected translation on demand
+        auto zipStreamShared = std::make_shared<const std::string>(std::move(rawStream));
+
+        wxMemoryInputStream byteStream(zipStreamShared->c_str(), zipStreamShared->size()); //does not take ownership
         wxZipInputStream zipStream(byteStream, wxConvUTF8);
 
         while (const auto& entry = std::unique_ptr<wxZipEntry>(zipStream.GetNextEntry())) //take ownership!
@@ -126,11 +154,23 @@ std::vector<TranslationInfo> loadTranslations(const Zstring& zipPath) //throw Fi
                                                                     L"%x", fmtPath(zipPath)),
                                            L"%y", fmtPath(utfTo<std::wstring>(entry->GetName()))));
 
-            if (std::string stream(entry->GetSize(), '\0');
-                zipStream.ReadAll(stream.data(), stream.size()))
-                streams.emplace_back(zipPath + Zstr(':') + utfTo<Zstring>(entry->GetName()), std::move(stream));
-            else
-                assert(false);
+            const Zstring filePath = zipPath + Zstr(':') + utfTo<Zstring>(entry->GetName());
+
+            lngFiles.push_back({filePath, readLngHeader(zipStream), [zipStreamShared, entryName = entry->GetName(), filePath]
+            {
+                wxMemoryInputStream byteStream2(zipStreamShared->c_str(), zipStreamShared->size());
+                wxZipInputStream zipStream2(byteStream2, wxConvUTF8);
+
+                while (const auto& entry2 = std::unique_ptr<wxZipEntry>(zipStream2.GetNextEntry())) //take ownership!
+                    if (entry2->GetName() == entryName)
+                    {
+                        if (std::string stream(entry2->GetSize(), '\0');
+                            zipStream2.ReadAll(stream.data(), stream.size()))
+                            return stream;
+                        break;
+                    }
+                throw FileError(replaceCpy(_("Cannot read file %x."), L"%x", fmtPath(filePath)));
+            }});
         }
     }();
     //--------------------------------------------------------------------
@@ -145,14 +185,14 @@ std::vector<TranslationInfo> loadTranslations(const Zstring& zipPath) //throw Fi
             .translatorName = L"Zenju",
             .languageFlag   = "flag_usa",
             .lngFileName    = Zstr(""),
-            .lngStream      = "",
+            .getLngStream   = nullptr,
         }
     };
 
-    for (/*const*/ auto& [filePath, stream] : streams)
+    for (/*const*/ auto& [filePath, headerStream, getLngStream] : lngFiles)
         try
         {
-            const lng::TransHeader lngHeader = lng::parseHeader(stream); //throw ParsingError
+            const lng::TransHeader lngHeader = lng::parseHeader(headerStream); //throw ParsingError
             assert(!lngHeader.languageName  .empty());
             assert(!lngHeader.translatorName.empty());
             assert(!lngHeader.locale        .empty());
@@ -169,7 +209,7 @@ std::vector<TranslationInfo> loadTranslations(const Zstring& zipPath) //throw Fi
                 .translatorName = utfTo<std::wstring>(lngHeader.translatorName),
                 .languageFlag   = lngHeader.flagFile,
                 .lngFileName    = filePath,
-                .lngStream      = std::move(stream),
+                .getLngStream   = std::move(getLngStream),
             });
         }
         catch (const lng::ParsingError& e)
@@ -382,7 +422,8 @@ void fff::setLanguage(wxLanguage lng) //throw FileError
     for (const TranslationInfo& e : getAvailableTranslations())
         if (e.languageID == lng)
         {
-            lngStream   = e.lngStream;
+            if (e.getLngStream)
+                lngStream = e.getLngStream(); //throw FileError
             lngFileName = e.lngFileName;
             break;
         }
@@ -8,6 +8,7 @@
 #define LOCALIZATION_H_8917342083178321534
 
 #include <vector>
+#include <functional>
 #include <zen/file_error.h>
 #include <wx/language.h>
 
@@ -22,7 +23,7 @@ struct TranslationInfo
     std::wstring translatorName;
     std::string languageFlag;
     Zstring lngFileName;
-    std::string lngStream;
+    std::function<std::string()> getLngStream; //throw FileError; decompress on demand; empty for default language
 };
 const std::vector<TranslationInfo>& getAvailableTranslations();
 
@@ -5,8 +5,14 @@
 // *****************************************************************************
 
 #include "log_file.h"
+#include <zen/crc.h>
+#include <zen/guid.h>
 #include <zen/http.h>
+#include <zen/serialize.h>
 #include <zen/sys_info.h>
+#include <zen/file_access.h>
+#include "afs/native.h"
+#include "base/dir_lock.h"
 
 using namespace zen;
 using namespace fff;
@@ -384,23 +390,20 @@ void streamToLogFile(const ProcessSummary& summary, const ErrorLog& log,
               generateLogHeaderHtml(summary, log, logPreviewMax) :
               generateLogHeaderTxt (summary, log, logPreviewMax)); //throw X
 
-    int itemCount = 0;
-    for (const LogEntry& entry : log)
+    log.visitItems([&](const LogEntry& entry) //streams log items from spool file, if needed
     {
-        if (itemCount++ >= logItemsMax)
-            break;
         stringOut(logFormat == LogFileFormat::html ?
                   formatMessageHtml(entry) :
                   formatMessage    (entry)); //throw X
-    }
+    }, static_cast<size_t>(std::max(logItemsMax, 0))); //throw SysError, X
 
     const std::string footer = [&]
     {
         try
         {
             return logFormat == LogFileFormat::html ?
-            generateLogFooterHtml(logFilePath, static_cast<int>(log.size()), logItemsMax): //throw FileError
-            generateLogFooterTxt (logFilePath, static_cast<int>(log.size()), logItemsMax); //
+            generateLogFooterHtml(logFilePath, static_cast<int>(log.itemCount()), logItemsMax): //throw FileError
+            generateLogFooterTxt (logFilePath, static_cast<int>(log.itemCount()), logItemsMax); //
         }
         catch (const FileError& e) { throw SysError(replaceCpy(e.toString(), L"\n\n", L'\n')); } //errors should be further enriched by context info => SysError
     }(); //caveat: don't catch exceptions thrown by stringOut()!
@@ -469,11 +472,41 @@ const Zchar STATUS_BEGIN_TOKEN[] = Zstr(" [");
 const Zchar STATUS_END_TOKEN     = Zstr(']');
 
 
+std::optional<time_t> parseLogFileTime(const Zstring& itemName)
+{
+    //"Backup FreeFileSync 2013-09-15 015052.123.html"
+    //"Jobname1 + Jobname2 2013-09-15 015052.123.log"
+    //"2013-09-15 015052.123 [Error].log"
+    static_assert(TIME_STAMP_LENGTH == 21);
+
+    if (endsWith(itemName, Zstr(".log")) || //case-sensitive: e.g. ".LOG" is not from FFS, right?
+        endsWith(itemName, Zstr(".html")))
+    {
+        ZstringView itemPhrase = beforeLast<ZstringView>(itemName, Zstr('.'), IfNotFoundReturn::none);
+
+        if (endsWith(itemPhrase, STATUS_END_TOKEN))
+            itemPhrase = beforeLast(itemPhrase, STATUS_BEGIN_TOKEN, IfNotFoundReturn::all);
+
+        if (itemPhrase.size() >= TIME_STAMP_LENGTH &&
+            itemPhrase.end()[-4] == Zstr('.') &&
+            isdigit(itemPhrase.end()[-3]) &&
+            isdigit(itemPhrase.end()[-2]) &&
+            isdigit(itemPhrase.end()[-1]))
+        {
+            const TimeComp tc = parseTime(Zstr("%Y-%m-%d %H%M%S"), makeStringView(itemPhrase.end() - TIME_STAMP_LENGTH, 17)); //returns TimeComp() on error
+            if (const auto [localTime, timeValid] = localToTimeT(tc);
+                timeValid)
+                return localTime;
+        }
+    }
+    return std::nullopt;
+}
+
+
 struct LogFileInfo
 {
-    AbstractPath filePath;
-    time_t       timeStamp;
-    std::wstring jobNames; //may be empty
+    Zstring itemName;
+    time_t  timeStamp = 0;
 };
 std::vector<LogFileInfo> getLogFiles(const AbstractPath& logFolderPath) //throw FileError
 {
@@ -481,40 +514,8 @@ std::vector<LogFileInfo> getLogFiles(const AbstractPath& logFolderPath) //throw
 
     AFS::traverseFolder(logFolderPath, [&](const AFS::FileInfo& fi) //throw FileError
     {
-        //"Backup FreeFileSync 2013-09-15 015052.123.html"
-        //"Jobname1 + Jobname2 2013-09-15 015052.123.log"
-        //"2013-09-15 015052.123 [Error].log"
-        static_assert(TIME_STAMP_LENGTH == 21);
-
-        if (endsWith(fi.itemName, Zstr(".log")) || //case-sensitive: e.g. ".LOG" is not from FFS, right?
-            endsWith(fi.itemName, Zstr(".html")))
-        {
-            ZstringView itemPhrase = beforeLast<ZstringView>(fi.itemName, Zstr('.'), IfNotFoundReturn::none);
-
-            if (endsWith(itemPhrase, STATUS_END_TOKEN))
-                itemPhrase = beforeLast(itemPhrase, STATUS_BEGIN_TOKEN, IfNotFoundReturn::all);
-
-            if (itemPhrase.size() >= TIME_STAMP_LENGTH &&
-                itemPhrase.end()[-4] == Zstr('.') &&
-                isdigit(itemPhrase.end()[-3]) &&
-                isdigit(itemPhrase.end()[-2]) &&
-                isdigit(itemPhrase.end()[-1]))
-            {
-                const TimeComp tc = parseTime(Zstr("%Y-%m-%d %H%M%S"), makeStringView(itemPhrase.end() - TIME_STAMP_LENGTH, 17)); //returns TimeComp() on error
-                if (const auto [localTime, timeValid] = localToTimeT(tc);
-                    timeValid)
-                {
-                    itemPhrase.remove_suffix(TIME_STAMP_LENGTH);
-                    if (!itemPhrase.empty())
-                    {
-                        assert(itemPhrase.size() >= 2 && endsWith(itemPhrase, Zstr(' ')));
-                        itemPhrase = trimCpy(itemPhrase);
-                    }
-
-                    logfiles.push_back({AFS::appendRelPath(logFolderPath, fi.itemName), localTime, utfTo<std::wstring>(itemPhrase)});
-                }
-            }
-        }
+        if (const std::optional<time_t> timeStamp = parseLogFileTime(fi.itemName))
+            logfiles.push_back({fi.itemName, *timeStamp});
     },
     nullptr /*onFolder*/, //traverse only one level deep
     nullptr /*onSymlink*/);
@@ -522,8 +523,125 @@ std::vector<LogFileInfo> getLogFiles(const AbstractPath& logFolderPath) //throw
     return logfiles;
 }
 
+//-------------------------------------------------------------------------------------------
+
+/* log folder index: avoid traversing the full log folder (possibly on a slow network share or cloud) for each sync
+    - updated after each log file is written and after log files are deleted
+    - (just) a cache: missing/corrupted/outdated index => rescan log folder
+    - periodic rescan: pick up log files written by other FreeFileSync instances/versions without an index update */
+const Zchar LOG_INDEX_FILE_NAME[] = Zstr(".ffs_log_index");
+const char  LOG_INDEX_FILE_DESCR[] = "FreeFileSync";
+const int   LOG_INDEX_FILE_VERSION = 1;
+const int   LOG_INDEX_RESCAN_DAYS  = 7;
+
+
+struct LogFolderIndex
+{
+    time_t lastFullScan = 0;
+    std::vector<LogFileInfo> logFiles;
+};
+
+
+LogFolderIndex loadLogFolderIndex(const AbstractPath& indexPath) //throw FileError
+{
+    const std::unique_ptr<AFS::InputStream> fileIn = AFS::getInputStream(indexPath); //throw FileError, ErrorFileLocked
+
+    const std::string byteStream = unbufferedLoad<std::string>([&](void* buffer, size_t bytesToRead)
+    {
+        return fileIn->tryRead(buffer, bytesToRead, nullptr /*notifyUnbufferedIO*/); //throw FileError, ErrorFileLocked; may return short, only 0 means EOF!
+    },
+    fileIn->getBlockSize()); //throw FileError
+    try
+    {
+        MemoryStreamIn memStreamIn(byteStream);
+
+        char formatDescr[sizeof(LOG_INDEX_FILE_DESCR)] = {};
+        readArray(memStreamIn, formatDescr, sizeof(formatDescr)); //throw SysErrorUnexpectedEos
+
+        if (!std::equal(LOG_INDEX_FILE_DESCR, LOG_INDEX_FILE_DESCR + sizeof(LOG_INDEX_FILE_DESCR), formatDescr))
+            throw SysError(_("File content is corrupted.") + L" (invalid header)");
+
+        const int version = readNumber<int32_t>(memStreamIn); //throw SysErrorUnexpectedEos
+        if (version != LOG_INDEX_FILE_VERSION)
+            throw SysError(_("Unsupported data format.") + L' ' + replaceCpy(_("Version: %x"), L"%x", numberTo<std::wstring>(version)));
+
+        assert(byteStream.size() >= sizeof(uint32_t)); //obviously in this context!
+        MemoryStreamOut crcStreamOut;
+        writeNumber<uint32_t>(crcStreamOut, getCrc32(byteStream.begin(), byteStream.end() - sizeof(uint32_t)));
+
+        if (!endsWith(byteStream, crcStreamOut.ref()))
+            throw SysError(_("File content is corrupted.") + L" (invalid checksum)");
+
+        LogFolderIndex index;
+        index.lastFullScan = readNumber<int64_t>(memStreamIn); //throw SysErrorUnexpectedEos
+
+        size_t fileCount = readNumber<uint32_t>(memStreamIn); //throw SysErrorUnexpectedEos
+        while (fileCount-- != 0)
+        {
+            const Zstring itemName = utfTo<Zstring>(readContainer<std::string>(memStreamIn)); //throw SysErrorUnexpectedEos
+            const time_t timeStamp = readNumber<int64_t>(memStreamIn);                         //
+            index.logFiles.push_back({itemName, timeStamp});
+        }
+        return index;
+    }
+    catch (const SysError& e)
+    {
+        throw FileError(replaceCpy(_("Cannot read file %x."), L"%x", fmtPath(AFS::getDisplayPath(indexPath))), e.toString());
+    }
+}
+
+
+void saveLogFolderIndex(const LogFolderIndex& index, const AbstractPath& indexPath) //throw FileError
+{
+    MemoryStreamOut memStreamOut;
+
+    writeArray(memStreamOut, LOG_INDEX_FILE_DESCR, sizeof(LOG_INDEX_FILE_DESCR));
+    writeNumber<int32_t>(memStreamOut, LOG_INDEX_FILE_VERSION);
+    writeNumber<int64_t>(memStreamOut, index.lastFullScan);
+
+    writeNumber(memStreamOut, static_cast<uint32_t>(index.logFiles.size()));
+    for (const LogFileInfo& lfi : index.logFiles)
+    {
+        writeContainer(memStreamOut, utfTo<std::string>(lfi.itemName));
+        writeNumber<int64_t>(memStreamOut, lfi.timeStamp);
+    }
+
+    writeNumber<uint32_t>(memStreamOut, getCrc32(memStreamOut.ref()));
+    //------------------------------------------------------------------------------------------------------------------------
+
+    //write to temp file + rename: (almost) transactional => never leave a half-written index behind
+    const Zstring shortGuid = printNumber<Zstring>(Zstr("%04x"), static_cast<unsigned int>(getCrc16(generateGUID())));
+    const AbstractPath indexPathTmp = AFS::appendRelPath(*AFS::getParentPath(indexPath), AFS::getItemName(indexPath) + Zstr('.') + shortGuid + AFS::TEMP_FILE_ENDING);
+    {
+        const std::unique_ptr<AFS::OutputStream> fileOut = AFS::getOutputStream(indexPathTmp,
+                                                                                memStreamOut.ref().size(),
+                                                                                std::nullopt /*modTime*/); //throw FileError
+        unbufferedSave(memStreamOut.ref(), [&](const void* buffer, size_t bytesToWrite)
+        {
+            return fileOut->tryWrite(buffer, bytesToWrite, nullptr /*notifyUnbufferedIO*/); //throw FileError
+        },
+        fileOut->getBlockSize()); //throw FileError
+
+        fileOut->finalize(nullptr /*notifyUnbufferedIO*/); //throw FileError
+    }
+    ZEN_ON_SCOPE_FAIL(try { AFS::removeFilePlain(indexPathTmp); }
+    catch (const FileError& e) { logExtraError(e.toString()); });
+
+    if (const Zstring& indexPathNative = getNativeItemPath(indexPath);
+        !indexPathNative.empty())
+        moveAndRenameItem(getNativeItemPath(indexPathTmp), indexPathNative, true /*replaceExisting*/); //throw FileError, (ErrorTargetExisting), (ErrorMoveUnsupported)
+    //=> rename() over existing file: readers see either the old or the new index
+    else
+    {
+        //AFS has no "replace existing" => not atomic: a reader in between finds no index and falls back to a full rescan
+        AFS::removeFileIfExists(indexPath); //throw FileError
+        AFS::moveAndRenameItem(indexPathTmp, indexPath); //throw FileError, (ErrorMoveUnsupported)
+    }
+}
+
 
 void limitLogfileCount(const AbstractPath& logFolderPath, //throw FileError, X
+                       const std::optional<Zstring>& newLogFileName, //just written to logFolderPath
                        int logfilesMaxAgeDays, //<= 0 := no limit
                        const std::set<AbstractPath>& logsToKeepPaths,
                        const std::function<void(std::wstring&& msg)>& notifyStatus /*throw X*/)
@@ -534,7 +652,42 @@ void limitLogfileCount(const AbstractPath& logFolderPath, //throw FileError, X
 
         if (notifyStatus) notifyStatus(statusPrefix + fmtPath(AFS::getDisplayPath(logFolderPath))); //throw X
 
-        std::vector<LogFileInfo> logFiles = getLogFiles(logFolderPath); //throw FileError
+        const AbstractPath indexPath = AFS::appendRelPath(logFolderPath, LOG_INDEX_FILE_NAME);
+
+        //serialize load-modify-save of the index between FFS instances sharing the same log folder, e.g. parallel batch jobs
+        //- native folders only (same as sync directory locks): elsewhere a lost update is repaired by the next full rescan
+        //- lock is just an optimization: failure to get it is not an error
+        std::optional<DirLock> indexLock;
+        if (const Zstring& logFolderPathNative = getNativeItemPath(logFolderPath);
+            !logFolderPathNative.empty())
+            try
+            {
+                indexLock.emplace(logFolderPathNative, Zstring(LOG_INDEX_FILE_NAME) + LOCK_FILE_ENDING,
+                [&](std::wstring&& msg) { if (notifyStatus) notifyStatus(std::move(msg)); /*throw X*/ },
+                UI_UPDATE_INTERVAL / 2); //throw FileError
+            }
+            catch (const FileError& e) { logExtraError(e.toString()); }
+
+        const time_t now = std::time(nullptr);
+
+        std::optional<LogFolderIndex> index;
+        try
+        {
+            index = loadLogFolderIndex(indexPath); //throw FileError
+        }
+        catch (FileError&) {} //not existing or corrupted => recover via full rescan
+
+        if (index &&
+            index->lastFullScan <= now && //clock changed? => rescan
+            now - index->lastFullScan < static_cast<time_t>(LOG_INDEX_RESCAN_DAYS) * 24 * 3600)
+        {
+            if (newLogFileName)
+                if (const std::optional<time_t> timeStamp = parseLogFileTime(*newLogFileName))
+                    if (std::none_of(index->logFiles.begin(), index->logFiles.end(), [&](const LogFileInfo& lfi) { return lfi.itemName == *newLogFileName; }))
+                        index->logFiles.push_back({*newLogFileName, *timeStamp});
+        }
+        else
+            index = LogFolderIndex{.lastFullScan = now, .logFiles = getLogFiles(logFolderPath)}; //throw FileError
 
         const time_t lastMidnightTime = []
         {
@@ -548,18 +701,30 @@ void limitLogfileCount(const AbstractPath& logFolderPath, //throw FileError, X
 
         std::exception_ptr firstError;
 
-        for (const LogFileInfo& lfi : logFiles)
+        std::erase_if(index->logFiles, [&](const LogFileInfo& lfi)
+        {
+            const AbstractPath filePath = AFS::appendRelPath(logFolderPath, lfi.itemName);
+
             if (lfi.timeStamp < cutOffTime &&
-                !logsToKeepPaths.contains(lfi.filePath)) //don't trim latest log files corresponding to last used config files!
+                !logsToKeepPaths.contains(filePath)) //don't trim latest log files corresponding to last used config files!
                 //nitpicker's corner: what about path differences due to case? e.g. user-overriden log file path changed in case
             {
-                if (notifyStatus) notifyStatus(statusPrefix + fmtPath(AFS::getDisplayPath(lfi.filePath))); //throw X
+                if (notifyStatus) notifyStatus(statusPrefix + fmtPath(AFS::getDisplayPath(filePath))); //throw X
                 try
                 {
-                    AFS::removeFilePlain(lfi.filePath); //throw FileError
+                    AFS::removeFileIfExists(filePath); //throw FileError
+                    return true; //index entry might be stale, e.g. log file deleted manually
                 }
                 catch (const FileError&) { if (!firstError) firstError = std::current_exception(); };
             }
+            return false;
+        });
+
+        try
+        {
+            saveLogFolderIndex(*index, indexPath); //throw FileError
+        }
+        catch (const FileError& e) { logExtraError(e.toString()); } //index is just a cache: next run will rescan
 
         if (firstError) //late failure!
             std::rethrow_exception(firstError);
@@ -638,9 +803,11 @@ void fff::saveLogFile(const AbstractPath& logFilePath, //throw FileError, X
                       const std::function<void(std::wstring&& msg)>& notifyStatus /*throw X*/)
 {
     std::exception_ptr firstError;
+    std::optional<Zstring> newLogFileName;
     try
     {
         saveNewLogFile(logFilePath, logFormat, summary, log, notifyStatus); //throw FileError, X
+        newLogFileName = AFS::getItemName(logFilePath);
     }
     catch (const FileError&) { if (!firstError) firstError = std::current_exception(); };
 
@@ -648,7 +815,7 @@ void fff::saveLogFile(const AbstractPath& logFilePath, //throw FileError, X
     {
         const std::optional<AbstractPath> logFolderPath = AFS::getParentPath(logFilePath);
         assert(logFolderPath); //else: logFilePath == device root; not possible with generateLogFilePath()
-        limitLogfileCount(*logFolderPath, logfilesMaxAgeDays, logsToKeepPaths, notifyStatus); //throw FileError, X
+        limitLogfileCount(*logFolderPath, newLogFileName, logfilesMaxAgeDays, logsToKeepPaths, notifyStatus); //throw FileError, X
     }
     catch (const FileError&) { if (!firstError) firstError = std::current_exception(); };
 
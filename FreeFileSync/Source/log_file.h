@@ -10,16 +10,11 @@
 #include <zen/error_log.h>
 #include "status_handler.h"
 #include "afs/abstract.h"
+#include "base/structures.h"
 
 
 namespace fff
 {
-enum class LogFileFormat
-{
-    html,
-    text
-};
-
 Zstring generateLogFileName(LogFileFormat logFormat, const ProcessSummary& summary);
 
 void saveLogFile(const AbstractPath& logFilePath, //throw FileError, X
@@ -71,8 +71,8 @@ BatchStatusHandler::Result BatchStatusHandler::prepareResult()
     if (const ErrorLog extraLog = fetchExtraLog();
         !extraLog.empty())
     {
-        append(errorLog_.ref(), extraLog);
-        std::stable_sort(errorLog_.ref().begin(), errorLog_.ref().end(), [](const LogEntry& lhs, const LogEntry& rhs) { return lhs.time < rhs.time; });
+        errorLog_.ref().append(extraLog);
+        errorLog_.ref().sortByTime();
     }
 
     //determine post-sync status irrespective of further errors during tear-down
@@ -406,24 +406,8 @@ void BatchStatusHandler::reportFatalError(const std::wstring& msg)
 
 Statistics::ErrorStats BatchStatusHandler::getErrorStats() const
 {
-    //errorLog_ is an "append only" structure, so we can make getErrorStats() complexity "constant time":
-    std::for_each(errorLog_.ref().begin() + errorStatsRowsChecked_, errorLog_.ref().end(), [&](const LogEntry& entry)
-    {
-        switch (entry.type)
-        {
-            case MSG_TYPE_INFO:
-                break;
-            case MSG_TYPE_WARNING:
-                ++errorStatsBuf_.warningCount;
-                break;
-            case MSG_TYPE_ERROR:
-                ++errorStatsBuf_.errorCount;
-                break;
-        }
-    });
-    errorStatsRowsChecked_ = errorLog_.ref().size();
-
-    return errorStatsBuf_;
+    const ErrorLogStats logCount = getStats(errorLog_.ref()); //constant time
+    return {.errorCount = logCount.errors, .warningCount = logCount.warnings};
 }
 
 
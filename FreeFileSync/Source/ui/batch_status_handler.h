@@ -75,8 +75,6 @@ private:
 
     SyncProgressDialog* progressDlg_; //managed to have the same lifetime as this handler!
     zen::SharedRef<zen::ErrorLog> errorLog_ = zen::makeSharedRef<zen::ErrorLog>();
-    mutable Statistics::ErrorStats errorStatsBuf_{};
-    mutable size_t errorStatsRowsChecked_ = 0;
     const BatchErrorHandling batchErrorHandling_;
     bool switchToGuiRequested_ = false;
     std::optional<TaskResult> syncResult_;
@@ -5,6 +5,7 @@
 // *****************************************************************************
 
 #include "file_grid.h"
+#include <list>
 #include <wx/dc.h>
 #include <wx/settings.h>
 #include <wx/timer.h>
@@ -284,6 +285,56 @@ private:
 };
 
 
+//least recently used entries are discarded: a screenful of rows needs a few hundred entries only, but scrolling through 1M rows must not grow the buffer
+template <class Value>
+class TextBuffer
+{
+public:
+    const Value* find(const std::wstring_view& text)
+    {
+        auto it = itemsByText_.find(text);
+        if (it == itemsByText_.end())
+            return nullptr;
+
+        priorityList_.splice(priorityList_.end(), priorityList_, it->second); //mark as most recently used
+        return &it->second->second;
+    }
+
+    void insert(const std::wstring_view& text, const Value& value) //replace existing entry
+    {
+        if (auto it = itemsByText_.find(text);
+            it != itemsByText_.end())
+        {
+            it->second->second = value;
+            priorityList_.splice(priorityList_.end(), priorityList_, it->second);
+            return;
+        }
+
+        priorityList_.emplace_back(std::wstring(text), value);
+        itemsByText_.emplace(priorityList_.back().first, std::prev(priorityList_.end()));
+
+        if (itemsByText_.size() > BUFFER_SIZE_MAX)
+        {
+            itemsByText_.erase(priorityList_.front().first);
+            priorityList_.pop_front();
+        }
+    }
+
+    void clear()
+    {
+        itemsByText_.clear();
+        priorityList_.clear();
+    }
+
+private:
+    static constexpr size_t BUFFER_SIZE_MAX = 10000;
+
+    using PriorityList = std::list<std::pair<std::wstring, Value>>; //least recently used at front, most recently used at back
+    PriorityList priorityList_;
+    std::unordered_map<std::wstring_view, typename PriorityList::iterator> itemsByText_; //string_view into priorityList_: std::list nodes don't move
+};
+
+
 struct SharedComponents //...between left, center, and right grids
 {
     SharedRef<FileView> gridDataView = makeSharedRef<FileView>();
@@ -291,8 +342,14 @@ struct SharedComponents //...between left, center, and right grids
     NavigationMarker navMarker;
     std::unique_ptr<GridEventManager> evtMgr;
     GridViewType gridViewType = GridViewType::action;
-    std::unordered_map<std::wstring, wxSize, StringHash, StringEqual> compExtentsBuf_; //buffer expensive wxDC::GetTextExtent() calls!
-    //StringHash, StringEqual => heterogenous lookup by std::wstring_view
+    TextBuffer<wxSize> compExtentsBuf_; //buffer expensive wxDC::GetTextExtent() calls!
+
+    struct TruncatedText
+    {
+        int maxWidth = 0;
+        GridData::TextTruncated trunc;
+    };
+    TextBuffer<TruncatedText> truncTextBuf_; //buffer ellipsis truncation: one wxDC::GetTextExtent() per binary search step!
 };
 
 //########################################################################################################
@@ -308,6 +365,7 @@ public:
         sharedComp_.ref().gridDataView = makeSharedRef<FileView>(); //clear old data view first! avoid memory peaks!
         sharedComp_.ref().gridDataView = makeSharedRef<FileView>(folderCmp);
         sharedComp_.ref().compExtentsBuf_.clear(); //doesn't become stale! but still: re-calculate and save some memory...
+        sharedComp_.ref().truncTextBuf_  .clear(); //
     }
 
     GridEventManager* getEventManager() { return sharedComp_.ref().evtMgr.get(); }
@@ -335,18 +393,42 @@ public:
 
     const FileSystemObject* getFsObject(size_t row) const { return getDataView().getFsObject(row); }
 
-    const wxSize& getTextExtentBuffered(const wxReadOnlyDC& dc, const std::wstring_view& text)
+    wxSize getTextExtentBuffered(const wxReadOnlyDC& dc, const std::wstring_view& text) //return by value: entry may be discarded by next insert
     {
         auto& compExtentsBuf = sharedComp_.ref().compExtentsBuf_;
-        //- only used for parent path names and file names on view => should not grow "too big"
+        //- bounded LRU buffer
         //- cleaned up during GridDataBase::setData()
         assert(!contains(text, L'\n'));
 
-        auto it = compExtentsBuf.find(text);
-        if (it == compExtentsBuf.end())
-            it = compExtentsBuf.emplace(text, dc.GetTextExtent(copyStringTo<wxString>(text))).first;
+        if (const wxSize* extent = compExtentsBuf.find(text))
+            return *extent;
+
+        const wxSize extent = dc.GetTextExtent(copyStringTo<wxString>(text));
+        compExtentsBuf.insert(text, extent);
         //GetTextExtent() returns (0, 0) for empty string!
-        return it->second;
+        return extent;
+    }
+
+    //same as drawCellText(), but buffer text extents *and* truncated text: repainting while scrolling/resizing becomes cheap
+    void drawCellTextBuffered(wxDC& dc, const wxRect& rect, const std::wstring_view& text, int alignment)
+    {
+        if (rect.width <= 0 || rect.height <= 0 || text.empty())
+            return;
+
+        const wxSize extent = getTextExtentBuffered(dc, text);
+        if (extent.GetWidth() <= rect.width)
+            return drawCellText(dc, rect, text, alignment, &extent);
+
+        auto& truncTextBuf = sharedComp_.ref().truncTextBuf_;
+        //- remember last width only: same text is usually drawn with same column width
+        //- bounded LRU buffer, cleaned up during GridDataBase::setData()
+        if (const SharedComponents::TruncatedText* tt = truncTextBuf.find(text);
+            tt && tt->maxWidth == rect.width)
+            return drawCellText(dc, rect, tt->trunc.text, alignment, &tt->trunc.extent);
+
+        const SharedComponents::TruncatedText tt{rect.width, truncateText(dc, text, rect.width, &extent)};
+        truncTextBuf.insert(text, tt);
+        drawCellText(dc, rect, tt.trunc.text, alignment, &tt.trunc.extent);
     }
 
     //- trim while leaving path components intact
@@ -555,6 +637,98 @@ private:
         return {};
     }
 
+    ValueSnapshot getValueSnapshot(const std::vector<ColumnType>& colTypes) const override
+    {
+        //copy raw item data on main thread (FolderComparison!), but leave formatting to the worker thread
+        struct RowData
+        {
+            enum class Type : unsigned char { none, folder, file, symlink } type = Type::none;
+            unsigned int basePathIdx = 0;
+            time_t modTime = 0;
+            uint64_t fileSize = 0;
+            Zstring relPath; //only if needed by "path" or "extension" column
+        };
+        const bool needRelPath = std::any_of(colTypes.begin(), colTypes.end(), [](ColumnType ct)
+        {
+            return static_cast<ColumnTypeRim>(ct) == ColumnTypeRim::path ||
+                   static_cast<ColumnTypeRim>(ct) == ColumnTypeRim::extension;
+        });
+
+        std::vector<AbstractPath> basePaths;
+        std::unordered_map<const BaseFolderPair*, unsigned int> basePathIdxs;
+
+        std::vector<RowData> rows(getRowCount());
+        for (size_t row = 0; row < rows.size(); ++row)
+            if (const FileSystemObject* fsObj = getFsObject(row))
+                if (!fsObj->isEmpty<side>())
+                {
+                    RowData& rd = rows[row];
+                    if (needRelPath)
+                        rd.relPath = fsObj->getRelativePath<side>();
+
+                    if (itemPathFormat_ == ItemPathFormat::full)
+                    {
+                        auto [it, inserted] = basePathIdxs.emplace(&fsObj->base(), static_cast<unsigned int>(basePaths.size()));
+                        if (inserted)
+                            basePaths.push_back(fsObj->base().getAbstractPath<side>());
+                        rd.basePathIdx = it->second;
+                    }
+
+                    visitFSObject(*fsObj, [&](const FolderPair& folder) { rd.type = RowData::Type::folder; },
+                    [&](const FilePair& file)
+                    {
+                        rd.type     = RowData::Type::file;
+                        rd.fileSize = file.getFileSize<side>();
+                        rd.modTime  = file.getLastWriteTime<side>();
+                    },
+                    [&](const SymlinkPair& symlink)
+                    {
+                        rd.type    = RowData::Type::symlink;
+                        rd.modTime = symlink.getLastWriteTime<side>();
+                    });
+                }
+
+        //same formatting as getValue():
+        return [rows = std::move(rows), basePaths = std::move(basePaths), itemPathFormat = itemPathFormat_,
+                symlinkLabel = L'<' + _("Symlink") + L'>'](size_t row, ColumnType colType) -> std::wstring
+        {
+            const RowData& rd = rows[row];
+            if (rd.type != RowData::Type::none)
+                switch (static_cast<ColumnTypeRim>(colType))
+                {
+                    case ColumnTypeRim::path:
+                        switch (itemPathFormat)
+                        {
+                            case ItemPathFormat::name:
+                                return utfTo<std::wstring>(afterLast(rd.relPath, FILE_NAME_SEPARATOR, IfNotFoundReturn::all));
+                            case ItemPathFormat::relative:
+                                return utfTo<std::wstring>(rd.relPath);
+                            case ItemPathFormat::full:
+                                return AFS::getDisplayPath(AFS::appendRelPath(basePaths[rd.basePathIdx], rd.relPath));
+                        }
+                        break;
+
+                    case ColumnTypeRim::size:
+                        if (rd.type == RowData::Type::file)
+                            return formatNumber(rd.fileSize);
+                        if (rd.type == RowData::Type::symlink)
+                            return symlinkLabel;
+                        break;
+
+                    case ColumnTypeRim::date:
+                        if (rd.type != RowData::Type::folder)
+                            return formatUtcToLocalTime(rd.modTime);
+                        break;
+
+                    case ColumnTypeRim::extension:
+                        if (rd.type != RowData::Type::folder)
+                            return utfTo<std::wstring>(getFileExtension(rd.relPath));
+                        break;
+                }
+            return {};
+        };
+    }
+
     void renderRowBackgound(wxDC& dc, const wxRect& rect, size_t row, bool enabled, bool selected, HoverArea rowHover) override
     {
         const FileView::PathDrawInfo pdi = getDataView().getDrawInfo(row);
@@ -994,11 +1168,11 @@ private:
                             split(groupParentPart, L'\n', [&, linesPerRow = std::max(refGrid().getRowHeight() / charHeight_, 1),
                                                            lineNo = 0](const std::wstring_view line) mutable
                             {
-                                drawCellText(dc, {
+                                drawCellTextBuffered(dc, {
                                     rectGroupParentText.x, //distribute lines evenly across multiple rows:
                                     rectGroupParentText.y + (rectGroupParentText.height * (1 + lineNo++ * 2) - linesPerRow * charHeight_) / (linesPerRow * 2),
                                     rectGroupParentText.width, charHeight_
-                                }, line, wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL, &getTextExtentBuffered(dc, line));
+                                }, line, wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL);
                             });
 #if 0
                             drawCellText(dc, rectGroupParentText, groupParentPart, wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL, &getTextExtentBuffered(dc, groupParentPart));
@@ -1042,7 +1216,7 @@ private:
                                 drawRectangleBorder(dc, rectGroupNameBack, mouseHighlightColor_, dipToWxsize(1));
 
                             if (!pdi.folderGroupObj->isEmpty<side>())
-                                drawCellText(dc, rectGroupName, groupName, wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL, &getTextExtentBuffered(dc, groupName));
+                                drawCellTextBuffered(dc, rectGroupName, groupName, wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL);
                         }
                     }
 
@@ -1114,7 +1288,7 @@ private:
                             drawRectangleBorder(dc, rectItemsBack, mouseHighlightColor_, dipToWxsize(1));
 
                         if (!pdi.fsObj->isEmpty<side>())
-                            drawCellText(dc, rectGroupItems, itemName, wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL, &getTextExtentBuffered(dc, itemName));
+                            drawCellTextBuffered(dc, rectGroupItems, itemName, wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL);
                     }
 
                     //if not done yet:
@@ -1131,12 +1305,12 @@ private:
                     {
                         rectTmp.x     += gapSize_;
                         rectTmp.width -= gapSize_;
-                        drawCellText(dc, rectTmp, getValue(row, colType), wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL);
+                        drawCellTextBuffered(dc, rectTmp, getValue(row, colType), wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL);
                     }
                     else
                     {
                         rectTmp.width -= gapSize_;
-                        drawCellText(dc, rectTmp, getValue(row, colType), wxALIGN_RIGHT | wxALIGN_CENTER_VERTICAL);
+                        drawCellTextBuffered(dc, rectTmp, getValue(row, colType), wxALIGN_RIGHT | wxALIGN_CENTER_VERTICAL);
                         //macOS: wxALIGN_RIGHT also helps mitigate NSDateFormatter not zero-padding dates!
                     }
                 }
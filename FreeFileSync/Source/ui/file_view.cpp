@@ -5,7 +5,6 @@
 // *****************************************************************************
 
 #include "file_view.h"
-#include <span>
 #include <zen/stl_tools.h>
 #include <zen/thread.h>
 
@@ -51,6 +50,22 @@ void serializeHierarchy(ContainerObject& conObj, std::vector<std::weak_ptr<FileS
     }
 #endif
 }
+
+
+//run fun(first, last) on chunks of [0, itemCount) in parallel
+template <class Function>
+void parallelChunks(size_t itemCount, Function fun)
+{
+    const size_t chunkSizeMin = 10'000; //don't bother with threads for small views
+    const size_t chunkCount = std::clamp<size_t>(itemCount / chunkSizeMin, 1, std::max<size_t>(std::thread::hardware_concurrency(), 1));
+    if (chunkCount == 1)
+        return fun(0, itemCount);
+
+    ThreadGroup<std::function<void()>> tg(chunkCount, Zstr("Grid View"));
+    for (size_t i = 0; i < chunkCount; ++i)
+        tg.run([&fun, first = itemCount * i / chunkCount, last = itemCount * (i + 1) / chunkCount] { fun(first, last); });
+    tg.wait();
+}
 }
 
 
@@ -70,29 +85,97 @@ FileView::FileView(FolderComparison& folderCmp)
 }
 
 
-template <class Predicate>
-void FileView::updateView(Predicate pred)
+template <class ViewStats, class Predicate, class AddStats>
+ViewStats FileView::updateView(Predicate pred /*bool(const FileSystemObject&, ViewStats&)*/, AddStats addStats /*void(ViewStats&, const ViewStats&)*/)
 {
-    viewRef_               .clear();
-    groupDetails_          .clear();
-    rowPositions_          .clear();
-    rowPositionsFirstChild_.clear();
+    viewRef_     .clear();
+    groupDetails_.clear();
+    rowPositions_.reset();
 
     static uint64_t globalViewUpdateId;
     viewUpdateId_ = ++globalViewUpdateId;
     assert(runningOnMainThread());
 
-    std::vector<const ContainerObject*> parentsBuf; //from bottom to top of hierarchy
+    struct RowInfo
+    {
+        const FileSystemObject* fsObj = nullptr;
+        bool isFolder = false;
+        bool visible  = false;
+    };
+    std::vector<RowInfo> rowInfos(sortedRef_.size());
+
+    ViewStats stats;
+    std::mutex statsLock;
+
+    //perf: categorize in parallel, then only collect visible rows on main thread
+    parallelChunks(sortedRef_.size(), [&](size_t first, size_t last)
+    {
+        ViewStats chunkStats;
+
+        for (size_t i = first; i < last; ++i)
+            if (const FileSystemObject* fsObj = sortedRef_[i].lock().get()) //owned by FolderComparison => no dangling pointer while on main thread
+            {
+                RowInfo& ri = rowInfos[i];
+                ri.fsObj = fsObj;
+
+                if (dynamic_cast<const FolderPair*>(fsObj))
+                    ri.isFolder = true; //FolderPair::getSyncOperation() is buffered (mutable, recursive) => evaluate on main thread only!
+                else
+                    ri.visible = pred(*fsObj, chunkStats);
+            }
+
+        std::lock_guard dummy(statsLock);
+        addStats(stats, chunkStats);
+    });
+
     const ContainerObject* groupStartObj = nullptr;
 
-    for (const std::weak_ptr<FileSystemObject>& objRef : sortedRef_)
-        if (const FileSystemObject* fsObj = objRef.lock().get())
-            if (pred(*fsObj))
+    for (size_t i = 0; i < rowInfos.size(); ++i)
+    {
+        RowInfo& ri = rowInfos[i];
+
+        if (ri.isFolder)
+            ri.visible = pred(*ri.fsObj, stats);
+
+        if (ri.visible)
+        {
+            const size_t row = viewRef_.size();
+
+            //------ save info to aggregate rows by parent folders ------
+            if (ri.isFolder)
+            {
+                groupStartObj = static_cast<const FolderPair*>(ri.fsObj);
+                groupDetails_.push_back({row});
+            }
+            else if (&ri.fsObj->parent() != groupStartObj)
             {
-                const size_t row = viewRef_.size();
+                groupStartObj = &ri.fsObj->parent();
+                groupDetails_.push_back({row});
+            }
+            assert(!groupDetails_.empty());
+            const size_t groupIdx = groupDetails_.size() - 1;
+            //-----------------------------------------------------------
+            viewRef_.push_back({sortedRef_[i], groupIdx});
+        }
+    }
+    return stats;
+}
+
+
+const FileView::RowPositions& FileView::getRowPositions() const
+{
+    if (!rowPositions_) //perf: lazy init => not needed for each updateView() but only when navigating from tree to file view
+    {
+        RowPositions& rp = rowPositions_.emplace();
+        rp.direct.reserve(viewRef_.size());
+
+        std::vector<const ContainerObject*> parentsBuf; //from bottom to top of hierarchy
 
+        for (size_t row = 0; row < viewRef_.size(); ++row)
+            if (const FileSystemObject* fsObj = viewRef_[row].objRef.lock().get())
+            {
                 //save row position for direct random access to FilePair or FolderPair
-                rowPositions_.emplace(fsObj, row); //costs: 0.28 µs per call - MSVC based on std::set
+                rp.direct.emplace(fsObj, row); //costs: 0.28 µs per call - MSVC based on std::set
 
                 parentsBuf.clear();
                 for (const FileSystemObject* fsObj2 = fsObj;;)
@@ -107,40 +190,28 @@ void FileView::updateView(Predicate pred)
 
                 //save row position to identify first child *on sorted subview* of FolderPair or BaseFolderPair in case latter are filtered out
                 for (const ContainerObject* parent : parentsBuf)
-                    if (const auto [it, inserted] = this->rowPositionsFirstChild_.emplace(parent, row);
+                    if (const auto [it, inserted] = rp.firstChild.emplace(parent, row);
                         !inserted) //=> parents further up in hierarchy already inserted!
                         break;
-
-                //------ save info to aggregate rows by parent folders ------
-                if (const auto folder = dynamic_cast<const FolderPair*>(fsObj))
-                {
-                    groupStartObj = folder;
-                    groupDetails_.push_back({row});
-                }
-                else if (&fsObj->parent() != groupStartObj)
-                {
-                    groupStartObj = &fsObj->parent();
-                    groupDetails_.push_back({row});
-                }
-                assert(!groupDetails_.empty());
-                const size_t groupIdx = groupDetails_.size() - 1;
-                //-----------------------------------------------------------
-                viewRef_.push_back({objRef, groupIdx});
             }
+    }
+    return *rowPositions_;
 }
 
 
 ptrdiff_t FileView::findRowDirect(const FileSystemObject* fsObj) const
 {
-    auto it = rowPositions_.find(fsObj);
-    return it != rowPositions_.end() ? it->second : -1;
+    const RowPositions& rp = getRowPositions();
+    auto it = rp.direct.find(fsObj);
+    return it != rp.direct.end() ? it->second : -1;
 }
 
 
 ptrdiff_t FileView::findRowFirstChild(const ContainerObject* conObj) const
 {
-    auto it = rowPositionsFirstChild_.find(conObj);
-    return it != rowPositionsFirstChild_.end() ? it->second : -1;
+    const RowPositions& rp = getRowPositions();
+    auto it = rp.firstChild.find(conObj);
+    return it != rp.firstChild.end() ? it->second : -1;
 }
 
 
@@ -181,6 +252,50 @@ void addNumbers(const FileSystemObject& fsObj, ViewStats& stats)
             ++stats.fileStatsRight.fileCount;
     });
 }
+
+
+void addStats(FileView::FileStats& stats, const FileView::FileStats& other)
+{
+    stats.fileCount   += other.fileCount;
+    stats.folderCount += other.folderCount;
+    stats.bytes       += other.bytes;
+}
+
+
+void addStats(FileView::DifferenceViewStats& stats, const FileView::DifferenceViewStats& other)
+{
+    stats.excluded += other.excluded;
+    stats.equal    += other.equal;
+    stats.conflict += other.conflict;
+
+    stats.leftOnly   += other.leftOnly;
+    stats.rightOnly  += other.rightOnly;
+    stats.leftNewer  += other.leftNewer;
+    stats.rightNewer += other.rightNewer;
+    stats.different  += other.different;
+
+    addStats(stats.fileStatsLeft,  other.fileStatsLeft);
+    addStats(stats.fileStatsRight, other.fileStatsRight);
+}
+
+
+void addStats(FileView::ActionViewStats& stats, const FileView::ActionViewStats& other)
+{
+    stats.excluded += other.excluded;
+    stats.equal    += other.equal;
+    stats.conflict += other.conflict;
+
+    stats.createLeft  += other.createLeft;
+    stats.createRight += other.createRight;
+    stats.deleteLeft  += other.deleteLeft;
+    stats.deleteRight += other.deleteRight;
+    stats.updateLeft  += other.updateLeft;
+    stats.updateRight += other.updateRight;
+    stats.updateNone  += other.updateNone;
+
+    addStats(stats.fileStatsLeft,  other.fileStatsLeft);
+    addStats(stats.fileStatsRight, other.fileStatsRight);
+}
 }
 
 
@@ -193,9 +308,7 @@ FileView::DifferenceViewStats FileView::applyDifferenceFilter(bool showExcluded,
                                                               bool showEqual,
                                                               bool showConflict)
 {
-    DifferenceViewStats stats;
-
-    updateView([&](const FileSystemObject& fsObj)
+    return updateView<DifferenceViewStats>([&](const FileSystemObject& fsObj, DifferenceViewStats& stats)
     {
         auto categorize = [&](bool showCategory, int& categoryCount)
         {
@@ -234,9 +347,8 @@ FileView::DifferenceViewStats FileView::applyDifferenceFilter(bool showExcluded,
         }
         assert(false);
         return true;
-    });
-
-    return stats;
+    },
+    [](DifferenceViewStats& stats, const DifferenceViewStats& other) { addStats(stats, other); });
 }
 
 
@@ -251,13 +363,19 @@ FileView::ActionViewStats FileView::applyActionFilter(bool showExcluded, //maps
                                                       bool showEqual,
                                                       bool showConflict)
 {
-    ActionViewStats stats;
-
-    int moveLeft  = 0;
-    int moveRight = 0;
+    struct Stats
+    {
+        ActionViewStats view;
+        int moveLeft  = 0;
+        int moveRight = 0;
+    };
 
-    updateView([&](const FileSystemObject& fsObj)
+    const Stats totalStats = updateView<Stats>([&](const FileSystemObject& fsObj, Stats& stats2)
     {
+        ActionViewStats& stats = stats2.view;
+        int& moveLeft  = stats2.moveLeft;
+        int& moveRight = stats2.moveRight;
+
         auto categorize = [&](bool showCategory, int& categoryCount)
         {
             if (!fsObj.isActive())
@@ -305,11 +423,18 @@ FileView::ActionViewStats FileView::applyActionFilter(bool showExcluded, //maps
         }
         assert(false);
         return true;
+    },
+    [](Stats& stats2, const Stats& other)
+    {
+        addStats(stats2.view, other.view);
+        stats2.moveLeft  += other.moveLeft;
+        stats2.moveRight += other.moveRight;
     });
 
-    assert(moveLeft % 2 == 0 && moveRight % 2 == 0);
-    stats.updateLeft  += moveLeft  / 2; //count move operations as single update
-    stats.updateRight += moveRight / 2; //=> harmonize with SyncStatistics::processFile()
+    ActionViewStats stats = totalStats.view;
+    assert(totalStats.moveLeft % 2 == 0 && totalStats.moveRight % 2 == 0);
+    stats.updateLeft  += totalStats.moveLeft  / 2; //count move operations as single update
+    stats.updateRight += totalStats.moveRight / 2; //=> harmonize with SyncStatistics::processFile()
 
     return stats;
 }
@@ -360,10 +485,9 @@ void FileView::removeInvalidRows()
     //remove rows that have been deleted meanwhile
     std::erase_if(sortedRef_, [&](const std::weak_ptr<FileSystemObject>& objRef) { return objRef.expired(); });
 
-    viewRef_               .clear();
-    groupDetails_          .clear();
-    rowPositions_          .clear();
-    rowPositionsFirstChild_.clear();
+    viewRef_     .clear();
+    groupDetails_.clear();
+    rowPositions_.reset();
 }
 
 
@@ -385,401 +509,383 @@ bool isDirectoryPair(const FileSystemObject& fsObj)
 }
 
 
-template <bool ascending, SelectSide side> inline
-bool lessFileName(const FileSystemObject& lhs, const FileSystemObject& rhs)
+template <bool ascending, class T> inline
+std::weak_ordering compareDirected(const T& lhs, const T& rhs)
 {
-    //sort order: first files/symlinks, then directories then empty rows
+    if constexpr (ascending)
+        return lhs <=> rhs;
+    else
+        return rhs <=> lhs;
+}
 
-    //empty rows always last
-    if (lhs.isEmpty<side>())
-        return false;
-    else if (rhs.isEmpty<side>())
-        return true;
 
-    //directories after files/symlinks:
-    if (isDirectoryPair(lhs))
-    {
-        if (!isDirectoryPair(rhs))
-            return false;
-    }
-    else if (isDirectoryPair(rhs))
-        return true;
-
-    return zen::makeSortDirection(LessNaturalSort() /*even on Linux*/, std::bool_constant<ascending>())(lhs.getItemName<side>(), rhs.getItemName<side>());
+template <bool ascending> inline
+std::weak_ordering compareDirected(const ZstringNatural& lhs, const ZstringNatural& rhs)
+{
+    if constexpr (ascending)
+        return compareNatural(lhs, rhs) /*even on Linux*/;
+    else
+        return compareNatural(rhs, lhs);
 }
 
 
-template <bool ascending, SelectSide side>  inline
-bool lessFilePath(const std::weak_ptr<FileSystemObject>& lhs, const std::weak_ptr<FileSystemObject>& rhs,
-                  const std::unordered_map<const void* /*BaseFolderPair*/, size_t /*position*/>& sortedPos,
-                  std::vector<const FolderPair*>& tempBuf)
+/* - sort chunks in parallel, then merge neighbors pairwise
+   - requires strict *total* order => result is independent from thread count and identical to std::stable_sort()  */
+template <class T, class Less>
+void parallelSort(std::vector<T>& items, Less less)
 {
-    const FileSystemObject* fsObjL = lhs.lock().get();
-    const FileSystemObject* fsObjR = rhs.lock().get();
-    if (!fsObjL) //invalid rows shall appear at the end
-        return false;
-    else if (!fsObjR)
-        return true;
+    std::vector<std::pair<size_t, size_t>> chunks;
+    std::mutex chunksLock;
+    parallelChunks(items.size(), [&](size_t first, size_t last)
+    {
+        std::sort(items.begin() + first, items.begin() + last, less);
 
-    //------- presort by folder pair ----------
+        std::lock_guard dummy(chunksLock);
+        chunks.emplace_back(first, last);
+    });
+    std::sort(chunks.begin(), chunks.end());
+
+    while (chunks.size() > 1)
     {
-        auto itL = sortedPos.find(&fsObjL->base());
-        auto itR = sortedPos.find(&fsObjR->base());
-        assert(itL != sortedPos.end() && itR != sortedPos.end());
-        if (itL == sortedPos.end()) //invalid rows shall appear at the end
-            return false;
-        else if (itR == sortedPos.end())
-            return true;
+        ThreadGroup<std::function<void()>> tg(chunks.size() / 2, Zstr("Grid View"));
+        std::vector<std::pair<size_t, size_t>> merged;
 
-        const size_t basePosL = itL->second;
-        const size_t basePosR = itR->second;
+        for (size_t i = 0; i + 1 < chunks.size(); i += 2)
+        {
+            const auto [first, middle] = chunks[i];
+            const size_t last = chunks[i + 1].second;
+            assert(middle == chunks[i + 1].first);
 
-        if (basePosL != basePosR)
-            return zen::makeSortDirection(std::less(), std::bool_constant<ascending>())(basePosL, basePosR);
+            tg.run([&items, &less, first, middle, last]
+            {
+                std::inplace_merge(items.begin() + first, items.begin() + middle, items.begin() + last, less);
+            });
+            merged.emplace_back(first, last);
+        }
+        if (chunks.size() % 2 != 0)
+            merged.push_back(chunks.back());
+
+        tg.wait();
+        chunks.swap(merged);
     }
+}
 
-    //------- sort component-wise ----------
-    const auto folderL = dynamic_cast<const FolderPair*>(fsObjL);
-    const auto folderR = dynamic_cast<const FolderPair*>(fsObjR);
 
-    std::vector<const FolderPair*>& parentsBuf = tempBuf; //from bottom to top of hierarchy, excluding base
-    parentsBuf.clear();
+/* perf: don't lock weak pointers, dynamic_cast and Unicode-normalize names during each of the O(n log n) comparisons:
+    1. extract compact sort keys once per row (in parallel)
+    2. sort keys in parallel
+    3. reorder sortedRef according to the sorted keys                */
+template <class GetKey /*std::optional<Key>(const FileSystemObject&): none for invalid rows*/, class CompareKey /*std::weak_ordering(const Key&, const Key&)*/>
+void sortByKey(std::vector<std::weak_ptr<FileSystemObject>>& sortedRef, GetKey getKey, CompareKey compareKey)
+{
+    using Key = typename decltype(getKey(std::declval<const FileSystemObject&>()))::value_type;
 
-    const auto collectParents = [&](const FileSystemObject* fsObj)
+    struct SortRow
     {
-        for (;;)
-            if (const auto folder = dynamic_cast<const FolderPair*>(&fsObj->parent())) //perf: most expensive part of this function!
-            {
-                parentsBuf.push_back(folder);
-                fsObj = folder;
-            }
-            else
-                break;
+        std::optional<Key> key; //none: invalid rows shall appear at the end
+        size_t pos = 0;         //position before sorting: tie-breaker => stable sort
     };
-    if (folderL)
-        parentsBuf.push_back(folderL);
-    collectParents(fsObjL);
-    const size_t parentsSizeL = parentsBuf.size();
-
-    if (folderR)
-        parentsBuf.push_back(folderR);
-    collectParents(fsObjR);
+    std::vector<SortRow> rows(sortedRef.size());
 
-    const std::span<const FolderPair*> parentsL(parentsBuf.data(), parentsSizeL); //no construction via iterator (yet): https://github.com/cplusplus/draft/pull/3456
-    const std::span<const FolderPair*> parentsR(parentsBuf.data() + parentsSizeL, parentsBuf.size() - parentsSizeL);
-
-    const auto& [itL, itR] = std::mismatch(parentsL.rbegin(), parentsL.rend(),
-                                           parentsR.rbegin(), parentsR.rend());
-    if (itL == parentsL.rend())
+    parallelChunks(rows.size(), [&](size_t first, size_t last)
     {
-        if (itR == parentsR.rend())
+        for (size_t i = first; i < last; ++i)
         {
-            //make folders always appear before contained files
-            if (folderR)
-                return false;
-            else if (folderL)
-                return true;
-
-            return zen::makeSortDirection(LessNaturalSort(), std::bool_constant<ascending>())(fsObjL->getItemName<side>(), fsObjR->getItemName<side>());
+            if (const std::shared_ptr<FileSystemObject> fsObj = sortedRef[i].lock())
+                rows[i].key = getKey(*fsObj);
+            rows[i].pos = i;
         }
-        else
-            return true;
-    }
-    else if (itR == parentsR.rend())
-        return false;
+    });
 
-    //different components...
-    if (const std::weak_ordering cmp = compareNatural((*itL)->getItemName<side>(), (*itR)->getItemName<side>());
-        cmp != std::weak_ordering::equivalent)
+    parallelSort(rows, [&](const SortRow& lhs, const SortRow& rhs)
     {
-        if constexpr (ascending)
-            return std::is_lt(cmp);
-        else
-            return std::is_gt(cmp);
-    }
-    //return zen::makeSortDirection(std::less(), std::bool_constant<ascending>())(rv, 0);
+        if (!lhs.key != !rhs.key)
+            return !rhs.key; //invalid rows shall appear at the end
+
+        if (lhs.key)
+            if (const std::weak_ordering cmp = compareKey(*lhs.key, *rhs.key);
+                cmp != std::weak_ordering::equivalent)
+                return std::is_lt(cmp);
+
+        return lhs.pos < rhs.pos;
+    });
 
-    /*...with equivalent names:
-        1. functional correctness => must not compare equal!  e.g. a/a/x and a/A/y
-        2. ensure stable sort order                                                            */
-    return *itL < *itR;
+    std::vector<std::weak_ptr<FileSystemObject>> output;
+    output.reserve(rows.size());
+    for (const SortRow& row : rows)
+        output.push_back(std::move(sortedRef[row.pos]));
+
+    sortedRef.swap(output);
 }
 
 
-template <bool ascending, SelectSide side> inline
-bool lessFilesize(const FileSystemObject& lhs, const FileSystemObject& rhs)
+struct NameKey
 {
-    //empty rows always last
-    if (lhs.isEmpty<side>())
-        return false;
-    else if (rhs.isEmpty<side>())
-        return true;
+    int group = 0; //ordering independent from sort direction: e.g. empty rows always last
+    ZstringNatural name;
+};
 
-    //directories second last
-    if (isDirectoryPair(lhs))
-        return false;
-    else if (isDirectoryPair(rhs))
-        return true;
 
-    const FilePair* fileL = dynamic_cast<const FilePair*>(&lhs);
-    const FilePair* fileR = dynamic_cast<const FilePair*>(&rhs);
+struct NumberKey
+{
+    int group = 0; //ordering independent from sort direction: e.g. empty rows always last
+    int64_t number = 0;
+};
 
-    //then symlinks
-    if (!fileL)
-        return false;
-    else if (!fileR)
-        return true;
 
-    //return list beginning with largest files first
-    return zen::makeSortDirection(std::less(), std::bool_constant<ascending>())(fileL->getFileSize<side>(), fileR->getFileSize<side>());
+template <bool ascending> inline
+std::weak_ordering compareNameKey(const NameKey& lhs, const NameKey& rhs)
+{
+    if (const std::weak_ordering cmp = lhs.group <=> rhs.group;
+        cmp != std::weak_ordering::equivalent)
+        return cmp;
+    return compareDirected<ascending>(lhs.name, rhs.name);
 }
 
 
-template <bool ascending, SelectSide side> inline
-bool lessFiletime(const FileSystemObject& lhs, const FileSystemObject& rhs)
+template <bool ascending> inline
+std::weak_ordering compareNumberKey(const NumberKey& lhs, const NumberKey& rhs)
 {
-    if (lhs.isEmpty<side>())
-        return false; //empty rows always last
-    else if (rhs.isEmpty<side>())
-        return true; //empty rows always last
-
-    const FilePair* fileL = dynamic_cast<const FilePair*>(&lhs);
-    const FilePair* fileR = dynamic_cast<const FilePair*>(&rhs);
-
-    const SymlinkPair* symlinkL = dynamic_cast<const SymlinkPair*>(&lhs);
-    const SymlinkPair* symlinkR = dynamic_cast<const SymlinkPair*>(&rhs);
+    if (const std::weak_ordering cmp = lhs.group <=> rhs.group;
+        cmp != std::weak_ordering::equivalent)
+        return cmp;
+    return compareDirected<ascending>(lhs.number, rhs.number);
+}
 
-    if (!fileL && !symlinkL)
-        return false; //directories last
-    else if (!fileR && !symlinkR)
-        return true; //directories last
 
-    const int64_t dateL = fileL ? fileL->getLastWriteTime<side>() : symlinkL->getLastWriteTime<side>();
-    const int64_t dateR = fileR ? fileR->getLastWriteTime<side>() : symlinkR->getLastWriteTime<side>();
+template <SelectSide side>
+std::optional<NameKey> getFileNameKey(const FileSystemObject& fsObj)
+{
+    //sort order: first files/symlinks, then directories then empty rows
+    if (fsObj.isEmpty<side>())
+        return NameKey{2, {}};
 
-    //return list beginning with newest files first
-    return zen::makeSortDirection(std::less(), std::bool_constant<ascending>())(dateL, dateR);
+    return NameKey{isDirectoryPair(fsObj) ? 1 : 0, ZstringNatural(fsObj.getItemName<side>())};
 }
 
 
-template <bool ascending, SelectSide side> inline
-bool lessExtension(const FileSystemObject& lhs, const FileSystemObject& rhs)
+template <SelectSide side>
+std::optional<NumberKey> getFilesizeKey(const FileSystemObject& fsObj)
 {
-    if (lhs.isEmpty<side>())
-        return false; //empty rows always last
-    else if (rhs.isEmpty<side>())
-        return true; //empty rows always last
+    //sort order: files (largest first if descending), then symlinks, then directories, then empty rows
+    if (fsObj.isEmpty<side>())
+        return NumberKey{3, 0};
 
-    if (dynamic_cast<const FolderPair*>(&lhs))
-        return false; //directories last
-    else if (dynamic_cast<const FolderPair*>(&rhs))
-        return true; //directories last
+    if (isDirectoryPair(fsObj))
+        return NumberKey{2, 0};
 
-    auto getExtension = [](const FileSystemObject& fsObj)
-    {
-        return afterLast(fsObj.getItemName<side>(), Zstr('.'), zen::IfNotFoundReturn::none);
-    };
+    if (const FilePair* file = dynamic_cast<const FilePair*>(&fsObj))
+        return NumberKey{0, static_cast<int64_t>(file->getFileSize<side>())};
 
-    return zen::makeSortDirection(LessNaturalSort() /*even on Linux*/, std::bool_constant<ascending>())(getExtension(lhs), getExtension(rhs));
+    return NumberKey{1, 0};
 }
 
 
-template <bool ascending> inline
-bool lessCmpResult(const FileSystemObject& lhs, const FileSystemObject& rhs)
+template <SelectSide side>
+std::optional<NumberKey> getFiletimeKey(const FileSystemObject& fsObj)
 {
-    return zen::makeSortDirection([](CompareFileResult lhs2, CompareFileResult rhs2)
-    {
-        //presort: equal shall appear at end of list
-        if (lhs2 == FILE_EQUAL)
-            return false;
-        if (rhs2 == FILE_EQUAL)
-            return true;
-        return lhs2 < rhs2;
-    },
-    std::bool_constant<ascending>())(lhs.getCategory(), rhs.getCategory());
+    //sort order: files/symlinks (newest first if descending), then directories, then empty rows
+    if (fsObj.isEmpty<side>())
+        return NumberKey{2, 0};
+
+    if (const FilePair* file = dynamic_cast<const FilePair*>(&fsObj))
+        return NumberKey{0, file->getLastWriteTime<side>()};
+
+    if (const SymlinkPair* symlink = dynamic_cast<const SymlinkPair*>(&fsObj))
+        return NumberKey{0, symlink->getLastWriteTime<side>()};
+
+    return NumberKey{1, 0};
 }
 
 
-template <bool ascending> inline
-bool lessSyncDirection(const FileSystemObject& lhs, const FileSystemObject& rhs)
+template <SelectSide side>
+std::optional<NameKey> getExtensionKey(const FileSystemObject& fsObj)
 {
-    return zen::makeSortDirection(std::less(), std::bool_constant<ascending>())(lhs.getSyncOperation(), rhs.getSyncOperation());
+    //sort order: files/symlinks, then directories, then empty rows
+    if (fsObj.isEmpty<side>())
+        return NameKey{2, {}};
+
+    if (isDirectoryPair(fsObj))
+        return NameKey{1, {}};
+
+    return NameKey{0, ZstringNatural(afterLast(fsObj.getItemName<side>(), Zstr('.'), zen::IfNotFoundReturn::none))};
 }
 
 
-template <bool ascending, SelectSide side>
-struct LessFullPath
+std::optional<NumberKey> getCmpResultKey(const FileSystemObject& fsObj)
 {
-    LessFullPath(std::vector<std::tuple<const void* /*BaseFolderPair*/, AbstractPath, AbstractPath>> folderPairs)
-    {
-        //calculate positions of base folders sorted by name
-        std::sort(folderPairs.begin(), folderPairs.end(), [](const auto& a, const auto& b)
-        {
-            const auto& [baseObjA, basePathLA, basePathRA] = a;
-            const auto& [baseObjB, basePathLB, basePathRB] = b;
+    const CompareFileResult cmpRes = fsObj.getCategory();
+    //presort: equal shall appear at end of list
+    return NumberKey{0, cmpRes == FILE_EQUAL ? std::numeric_limits<int64_t>::max() : static_cast<int64_t>(cmpRes)};
+}
 
-            const AbstractPath& basePathA = selectParam<side>(basePathLA, basePathRA);
-            const AbstractPath& basePathB = selectParam<side>(basePathLB, basePathRB);
 
-            return LessNaturalSort()/*even on Linux*/(utfTo<Zstring>(AFS::getDisplayPath(basePathA)),
-                                                      utfTo<Zstring>(AFS::getDisplayPath(basePathB)));
-        });
-
-        size_t pos = 0;
-        for (const auto& [baseObj, basePathL, basePathR] : folderPairs)
-            shared_.ref().sortedPos.emplace(baseObj, pos++);
-    }
+//run on worker threads: requires FolderPair sync operations to be buffered beforehand, see FileView::sortView()
+std::optional<NumberKey> getSyncDirectionKey(const FileSystemObject& fsObj)
+{
+    return NumberKey{0, static_cast<int64_t>(fsObj.getSyncOperation())};
+}
 
-    bool operator()(const std::weak_ptr<FileSystemObject>& lhs, const std::weak_ptr<FileSystemObject>& rhs) const
-    {
-        return lessFilePath<ascending, side>(lhs, rhs, shared_.ref().sortedPos, shared_.ref().tempBuf);
-    }
 
-private:
-    struct Shared
-    {
-        std::unordered_map<const void* /*BaseFolderPair*/, size_t /*position*/> sortedPos;
-        mutable std::vector<const FolderPair*> tempBuf; //avoid repeated memory allocation in lessFilePath()
-    };
-    SharedRef<Shared> shared_ = makeSharedRef<Shared>(); //std::sort makes lots of predicate copies during its "divide and conquer"
+struct PathKey
+{
+    size_t basePos    = 0;
+    size_t folderRank = 0; //of the folder itself, or of the parent folder for files/symlinks; 0 for base folder
+    bool isFolder = false;
+    ZstringNatural itemName; //files/symlinks only
 };
 
 
-template <bool ascending, SelectSide side>
-struct LessRelativeFolder
+template <bool ascending> inline
+std::weak_ordering comparePathKey(const PathKey& lhs, const PathKey& rhs)
 {
-    LessRelativeFolder(const std::vector<std::tuple<const void* /*BaseFolderPair*/, AbstractPath, AbstractPath>>& folderPairs)
-    {
-        size_t pos = 0; //take over positions of base folders as set up by user
-        for (const auto& [baseObj, basePathL, basePathR] : folderPairs)
-            shared_.ref().sortedPos.emplace(baseObj, pos++);
-    }
+    //------- presort by folder pair ----------
+    if (const std::weak_ordering cmp = compareDirected<ascending>(lhs.basePos, rhs.basePos);
+        cmp != std::weak_ordering::equivalent)
+        return cmp;
 
-    bool operator()(const std::weak_ptr<FileSystemObject>& lhs, const std::weak_ptr<FileSystemObject>& rhs) const
-    {
-        return lessFilePath<ascending, side>(lhs, rhs, shared_.ref().sortedPos, shared_.ref().tempBuf);
-    }
+    //------- folder ranks already consider sort direction ----------
+    if (const std::weak_ordering cmp = lhs.folderRank <=> rhs.folderRank;
+        cmp != std::weak_ordering::equivalent)
+        return cmp;
 
-private:
-    struct Shared
-    {
-        std::unordered_map<const void* /*BaseFolderPair*/, size_t /*position*/> sortedPos;
-        mutable std::vector<const FolderPair*> tempBuf; //avoid repeated memory allocation in lessFilePath()
-    };
-    SharedRef<Shared> shared_ = makeSharedRef<Shared>(); //std::sort makes lots of predicate copies during its "divide and conquer"
-};
+    //make folders always appear before contained files
+    if (lhs.isFolder != rhs.isFolder)
+        return rhs.isFolder <=> lhs.isFolder;
+
+    return compareDirected<ascending>(lhs.itemName, rhs.itemName);
+}
 
 
+/* sort order by relative path (component-wise):
+     - files/symlinks before subfolders of the same parent folder
+     - folders directly followed by their content
+   => number folders in pre-order, sorting siblings by name                  */
 template <bool ascending, SelectSide side>
-struct LessFileName
+std::unordered_map<const void* /*ContainerObject*/, size_t> getFolderRanks(const std::vector<std::weak_ptr<FileSystemObject>>& sortedRef)
 {
-    bool operator()(const std::weak_ptr<FileSystemObject>& lhs, const std::weak_ptr<FileSystemObject>& rhs) const
-    {
-        const std::shared_ptr<FileSystemObject> fsObjL = lhs.lock();
-        const std::shared_ptr<FileSystemObject> fsObjR = rhs.lock();
-        if (!fsObjL) //invalid rows shall appear at the end
-            return false;
-        else if (!fsObjR)
-            return true;
+    std::unordered_map<const ContainerObject*, std::vector<std::pair<ZstringNatural, const FolderPair*>>> subfoldersByParent;
 
-        return lessFileName<ascending, side>(*fsObjL, *fsObjR);
-    }
-};
+    for (const std::weak_ptr<FileSystemObject>& objRef : sortedRef)
+        if (const std::shared_ptr<FileSystemObject> fsObj = objRef.lock())
+            if (const auto folder = dynamic_cast<const FolderPair*>(fsObj.get()))
+                subfoldersByParent[&folder->parent()].emplace_back(ZstringNatural(folder->getItemName<side>()), folder);
 
+    std::unordered_map<const void* /*ContainerObject*/, size_t> folderRanks;
+    size_t rank = 0;
 
-template <bool ascending, SelectSide side>
-struct LessFilesize
-{
-    bool operator()(const std::weak_ptr<FileSystemObject>& lhs, const std::weak_ptr<FileSystemObject>& rhs) const
+    auto rankSubfolders = [&](const ContainerObject& parent, auto& rankSubfoldersRec) -> void
     {
-        const std::shared_ptr<FileSystemObject> fsObjL = lhs.lock();
-        const std::shared_ptr<FileSystemObject> fsObjR = rhs.lock();
-        if (!fsObjL) //invalid rows shall appear at the end
-            return false;
-        else if (!fsObjR)
-            return true;
+        auto it = subfoldersByParent.find(&parent);
+        if (it == subfoldersByParent.end())
+            return;
 
-        return lessFilesize<ascending, side>(*fsObjL, *fsObjR);
-    }
-};
+        std::vector<std::pair<ZstringNatural, const FolderPair*>>& subfolders = it->second;
 
+        std::sort(subfolders.begin(), subfolders.end(), [](const auto& lhs, const auto& rhs)
+        {
+            if (const std::weak_ordering cmp = compareDirected<ascending>(lhs.first, rhs.first);
+                cmp != std::weak_ordering::equivalent)
+                return std::is_lt(cmp);
+
+            /*...with equivalent names:
+                1. functional correctness => must not compare equal!  e.g. a/a/x and a/A/y
+                2. ensure stable sort order                                                            */
+            return lhs.second < rhs.second;
+        });
 
-template <bool ascending, SelectSide side>
-struct LessFiletime
-{
-    bool operator()(const std::weak_ptr<FileSystemObject>& lhs, const std::weak_ptr<FileSystemObject>& rhs) const
-    {
-        const std::shared_ptr<FileSystemObject> fsObjL = lhs.lock();
-        const std::shared_ptr<FileSystemObject> fsObjR = rhs.lock();
-        if (!fsObjL) //invalid rows shall appear at the end
-            return false;
-        else if (!fsObjR)
-            return true;
+        for (const auto& [folderName, folder] : subfolders)
+        {
+            folderRanks.emplace(static_cast<const ContainerObject*>(folder), ++rank);
+            rankSubfoldersRec(*folder, rankSubfoldersRec);
+        }
+    };
 
-        return lessFiletime<ascending, side>(*fsObjL, *fsObjR);
-    }
-};
+    for (const auto& [parent, subfolders] : subfoldersByParent)
+        if (!dynamic_cast<const FolderPair*>(parent)) //start at base folders
+            rankSubfolders(*parent, rankSubfolders);
+
+    return folderRanks;
+}
 
 
 template <bool ascending, SelectSide side>
-struct LessExtension
+void sortByPath(std::vector<std::weak_ptr<FileSystemObject>>& sortedRef,
+                const std::unordered_map<const void* /*BaseFolderPair*/, size_t /*position*/>& sortedPos)
 {
-    bool operator()(const std::weak_ptr<FileSystemObject>& lhs, const std::weak_ptr<FileSystemObject>& rhs) const
+    const std::unordered_map<const void* /*ContainerObject*/, size_t> folderRanks = getFolderRanks<ascending, side>(sortedRef);
+
+    sortByKey(sortedRef, [&](const FileSystemObject& fsObj) -> std::optional<PathKey>
     {
-        const std::shared_ptr<FileSystemObject> fsObjL = lhs.lock();
-        const std::shared_ptr<FileSystemObject> fsObjR = rhs.lock();
-        if (!fsObjL) //invalid rows shall appear at the end
-            return false;
-        else if (!fsObjR)
-            return true;
+        auto itBase = sortedPos.find(&fsObj.base());
+        assert(itBase != sortedPos.end());
+        if (itBase == sortedPos.end()) //invalid rows shall appear at the end
+            return std::nullopt;
 
-        return lessExtension<ascending, side>(*fsObjL, *fsObjR);
-    }
-};
+        PathKey key{itBase->second};
+
+        if (const auto folder = dynamic_cast<const FolderPair*>(&fsObj))
+        {
+            key.isFolder = true;
+            if (auto it = folderRanks.find(static_cast<const ContainerObject*>(folder)); it != folderRanks.end())
+                key.folderRank = it->second;
+            else assert(false);
+        }
+        else
+        {
+            if (auto it = folderRanks.find(&fsObj.parent()); it != folderRanks.end())
+                key.folderRank = it->second;
+            else assert(!dynamic_cast<const FolderPair*>(&fsObj.parent())); //rank 0: base folder
+
+            key.itemName = ZstringNatural(fsObj.getItemName<side>());
+        }
+        return key;
+    },
+    comparePathKey<ascending>);
+}
 
 
-template <bool ascending>
-struct LessCmpResult
+template <SelectSide side>
+std::unordered_map<const void* /*BaseFolderPair*/, size_t /*position*/> getBasePositionsByName(std::vector<std::tuple<const void* /*BaseFolderPair*/, AbstractPath, AbstractPath>> folderPairs)
 {
-    bool operator()(const std::weak_ptr<FileSystemObject>& lhs, const std::weak_ptr<FileSystemObject>& rhs) const
+    //calculate positions of base folders sorted by name
+    std::sort(folderPairs.begin(), folderPairs.end(), [](const auto& a, const auto& b)
     {
-        const std::shared_ptr<FileSystemObject> fsObjL = lhs.lock();
-        const std::shared_ptr<FileSystemObject> fsObjR = rhs.lock();
-        if (!fsObjL) //invalid rows shall appear at the end
-            return false;
-        else if (!fsObjR)
-            return true;
+        const auto& [baseObjA, basePathLA, basePathRA] = a;
+        const auto& [baseObjB, basePathLB, basePathRB] = b;
 
-        return lessCmpResult<ascending>(*fsObjL, *fsObjR);
-    }
-};
+        const AbstractPath& basePathA = selectParam<side>(basePathLA, basePathRA);
+        const AbstractPath& basePathB = selectParam<side>(basePathLB, basePathRB);
 
+        return LessNaturalSort()/*even on Linux*/(utfTo<Zstring>(AFS::getDisplayPath(basePathA)),
+                                                  utfTo<Zstring>(AFS::getDisplayPath(basePathB)));
+    });
 
-template <bool ascending>
-struct LessSyncDirection
-{
-    bool operator()(const std::weak_ptr<FileSystemObject>& lhs, const std::weak_ptr<FileSystemObject>& rhs) const
-    {
-        const std::shared_ptr<FileSystemObject> fsObjL = lhs.lock();
-        const std::shared_ptr<FileSystemObject> fsObjR = rhs.lock();
-        if (!fsObjL) //invalid rows shall appear at the end
-            return false;
-        else if (!fsObjR)
-            return true;
+    std::unordered_map<const void* /*BaseFolderPair*/, size_t /*position*/> sortedPos;
+    size_t pos = 0;
+    for (const auto& [baseObj, basePathL, basePathR] : folderPairs)
+        sortedPos.emplace(baseObj, pos++);
+    return sortedPos;
+}
 
-        return lessSyncDirection<ascending>(*fsObjL, *fsObjR);
-    }
-};
+
+std::unordered_map<const void* /*BaseFolderPair*/, size_t /*position*/> getBasePositionsAsConfigured(const std::vector<std::tuple<const void* /*BaseFolderPair*/, AbstractPath, AbstractPath>>& folderPairs)
+{
+    std::unordered_map<const void* /*BaseFolderPair*/, size_t /*position*/> sortedPos;
+    size_t pos = 0; //take over positions of base folders as set up by user
+    for (const auto& [baseObj, basePathL, basePathR] : folderPairs)
+        sortedPos.emplace(baseObj, pos++);
+    return sortedPos;
+}
 }
 
 //-------------------------------------------------------------------------------------------------------
 
 void FileView::sortView(ColumnTypeRim type, ItemPathFormat pathFmt, bool onLeft, bool ascending)
 {
-    viewRef_               .clear();
-    groupDetails_          .clear();
-    rowPositions_          .clear();
-    rowPositionsFirstChild_.clear();
+    viewRef_     .clear();
+    groupDetails_.clear();
+    rowPositions_.reset();
     currentSort_ = SortInfo({type, onLeft, ascending});
 
     switch (type)
@@ -788,45 +894,45 @@ void FileView::sortView(ColumnTypeRim type, ItemPathFormat pathFmt, bool onLeft,
             switch (pathFmt)
             {
                 case ItemPathFormat::name:
-                    if      ( ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFileName<true,  SelectSide::left >());
-                    else if ( ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFileName<true,  SelectSide::right>());
-                    else if (!ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFileName<false, SelectSide::left >());
-                    else if (!ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFileName<false, SelectSide::right>());
+                    if      ( ascending &&  onLeft) sortByKey(sortedRef_, getFileNameKey<SelectSide::left >, compareNameKey<true >);
+                    else if ( ascending && !onLeft) sortByKey(sortedRef_, getFileNameKey<SelectSide::right>, compareNameKey<true >);
+                    else if (!ascending &&  onLeft) sortByKey(sortedRef_, getFileNameKey<SelectSide::left >, compareNameKey<false>);
+                    else if (!ascending && !onLeft) sortByKey(sortedRef_, getFileNameKey<SelectSide::right>, compareNameKey<false>);
                     break;
 
                 case ItemPathFormat::relative:
-                    if      ( ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessRelativeFolder<true,  SelectSide::left >(folderPairs_));
-                    else if ( ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessRelativeFolder<true,  SelectSide::right>(folderPairs_));
-                    else if (!ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessRelativeFolder<false, SelectSide::left >(folderPairs_));
-                    else if (!ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessRelativeFolder<false, SelectSide::right>(folderPairs_));
+                    if      ( ascending &&  onLeft) sortByPath<true,  SelectSide::left >(sortedRef_, getBasePositionsAsConfigured(folderPairs_));
+                    else if ( ascending && !onLeft) sortByPath<true,  SelectSide::right>(sortedRef_, getBasePositionsAsConfigured(folderPairs_));
+                    else if (!ascending &&  onLeft) sortByPath<false, SelectSide::left >(sortedRef_, getBasePositionsAsConfigured(folderPairs_));
+                    else if (!ascending && !onLeft) sortByPath<false, SelectSide::right>(sortedRef_, getBasePositionsAsConfigured(folderPairs_));
                     break;
 
                 case ItemPathFormat::full:
-                    if      ( ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFullPath<true,  SelectSide::left >(folderPairs_));
-                    else if ( ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFullPath<true,  SelectSide::right>(folderPairs_));
-                    else if (!ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFullPath<false, SelectSide::left >(folderPairs_));
-                    else if (!ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFullPath<false, SelectSide::right>(folderPairs_));
+                    if      ( ascending &&  onLeft) sortByPath<true,  SelectSide::left >(sortedRef_, getBasePositionsByName<SelectSide::left >(folderPairs_));
+                    else if ( ascending && !onLeft) sortByPath<true,  SelectSide::right>(sortedRef_, getBasePositionsByName<SelectSide::right>(folderPairs_));
+                    else if (!ascending &&  onLeft) sortByPath<false, SelectSide::left >(sortedRef_, getBasePositionsByName<SelectSide::left >(folderPairs_));
+                    else if (!ascending && !onLeft) sortByPath<false, SelectSide::right>(sortedRef_, getBasePositionsByName<SelectSide::right>(folderPairs_));
                     break;
             }
             break;
 
         case ColumnTypeRim::size:
-            if      ( ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFilesize<true,  SelectSide::left >());
-            else if ( ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFilesize<true,  SelectSide::right>());
-            else if (!ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFilesize<false, SelectSide::left >());
-            else if (!ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFilesize<false, SelectSide::right>());
+            if      ( ascending &&  onLeft) sortByKey(sortedRef_, getFilesizeKey<SelectSide::left >, compareNumberKey<true >);
+            else if ( ascending && !onLeft) sortByKey(sortedRef_, getFilesizeKey<SelectSide::right>, compareNumberKey<true >);
+            else if (!ascending &&  onLeft) sortByKey(sortedRef_, getFilesizeKey<SelectSide::left >, compareNumberKey<false>);
+            else if (!ascending && !onLeft) sortByKey(sortedRef_, getFilesizeKey<SelectSide::right>, compareNumberKey<false>);
             break;
         case ColumnTypeRim::date:
-            if      ( ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFiletime<true,  SelectSide::left >());
-            else if ( ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFiletime<true,  SelectSide::right>());
-            else if (!ascending &&  onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFiletime<false, SelectSide::left >());
-            else if (!ascending && !onLeft) std::sort(sortedRef_.begin(), sortedRef_.end(), LessFiletime<false, SelectSide::right>());
+            if      ( ascending &&  onLeft) sortByKey(sortedRef_, getFiletimeKey<SelectSide::left >, compareNumberKey<true >);
+            else if ( ascending && !onLeft) sortByKey(sortedRef_, getFiletimeKey<SelectSide::right>, compareNumberKey<true >);
+            else if (!ascending &&  onLeft) sortByKey(sortedRef_, getFiletimeKey<SelectSide::left >, compareNumberKey<false>);
+            else if (!ascending && !onLeft) sortByKey(sortedRef_, getFiletimeKey<SelectSide::right>, compareNumberKey<false>);
             break;
         case ColumnTypeRim::extension:
-            if      ( ascending &&  onLeft) std::stable_sort(sortedRef_.begin(), sortedRef_.end(), LessExtension<true,  SelectSide::left >());
-            else if ( ascending && !onLeft) std::stable_sort(sortedRef_.begin(), sortedRef_.end(), LessExtension<true,  SelectSide::right>());
-            else if (!ascending &&  onLeft) std::stable_sort(sortedRef_.begin(), sortedRef_.end(), LessExtension<false, SelectSide::left >());
-            else if (!ascending && !onLeft) std::stable_sort(sortedRef_.begin(), sortedRef_.end(), LessExtension<false, SelectSide::right>());
+            if      ( ascending &&  onLeft) sortByKey(sortedRef_, getExtensionKey<SelectSide::left >, compareNameKey<true >);
+            else if ( ascending && !onLeft) sortByKey(sortedRef_, getExtensionKey<SelectSide::right>, compareNameKey<true >);
+            else if (!ascending &&  onLeft) sortByKey(sortedRef_, getExtensionKey<SelectSide::left >, compareNameKey<false>);
+            else if (!ascending && !onLeft) sortByKey(sortedRef_, getExtensionKey<SelectSide::right>, compareNameKey<false>);
             break;
     }
 }
@@ -834,10 +940,9 @@ void FileView::sortView(ColumnTypeRim type, ItemPathFormat pathFmt, bool onLeft,
 
 void FileView::sortView(ColumnTypeCenter type, bool ascending)
 {
-    viewRef_               .clear();
-    groupDetails_          .clear();
-    rowPositions_          .clear();
-    rowPositionsFirstChild_.clear();
+    viewRef_     .clear();
+    groupDetails_.clear();
+    rowPositions_.reset();
     currentSort_ = SortInfo({type, false, ascending});
 
     switch (type)
@@ -846,12 +951,18 @@ void FileView::sortView(ColumnTypeCenter type, bool ascending)
             assert(false);
             break;
         case ColumnTypeCenter::difference:
-            if      ( ascending) std::stable_sort(sortedRef_.begin(), sortedRef_.end(), LessCmpResult<true >());
-            else if (!ascending) std::stable_sort(sortedRef_.begin(), sortedRef_.end(), LessCmpResult<false>());
+            if      ( ascending) sortByKey(sortedRef_, getCmpResultKey, compareNumberKey<true >);
+            else if (!ascending) sortByKey(sortedRef_, getCmpResultKey, compareNumberKey<false>);
             break;
         case ColumnTypeCenter::action:
-            if      ( ascending) std::stable_sort(sortedRef_.begin(), sortedRef_.end(), LessSyncDirection<true >());
-            else if (!ascending) std::stable_sort(sortedRef_.begin(), sortedRef_.end(), LessSyncDirection<false>());
+            //FolderPair::getSyncOperation() is buffered (mutable, recursive) => fill buffers on main thread *before* parallel key extraction!
+            for (const std::weak_ptr<FileSystemObject>& ref : sortedRef_)
+                if (const std::shared_ptr<FileSystemObject> fsObj = ref.lock())
+                    if (dynamic_cast<const FolderPair*>(fsObj.get()))
+                        fsObj->getSyncOperation();
+
+            if      ( ascending) sortByKey(sortedRef_, getSyncDirectionKey, compareNumberKey<true >);
+            else if (!ascending) sortByKey(sortedRef_, getSyncDirectionKey, compareNumberKey<false>);
             break;
     }
 }
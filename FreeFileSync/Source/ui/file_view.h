@@ -127,12 +127,17 @@ private:
     FileView           (const FileView&) = delete;
     FileView& operator=(const FileView&) = delete;
 
-    template <class Predicate> void updateView(Predicate pred);
+    template <class ViewStats, class Predicate, class AddStats> ViewStats updateView(Predicate pred, AddStats addStats);
 
+    struct RowPositions
+    {
+        std::unordered_map<const void* /*FileSystemObject*/, size_t> direct;     //find row positions on viewRef_ directly
+        std::unordered_map<const void* /*ContainerObject*/,  size_t> firstChild; //find first child on sortedRef of a container object
+        //void* instead of ContainerObject*: these pointers should *never be dereferenced*!
+    };
+    const RowPositions& getRowPositions() const;
 
-    std::unordered_map<const void* /*FileSystemObject*/, size_t> rowPositions_; //find row positions on viewRef_ directly
-    std::unordered_map<const void* /*ContainerObject*/,  size_t> rowPositionsFirstChild_; //find first child on sortedRef of a container object
-    //void* instead of ContainerObject*: these pointers should *never be dereferenced*!
+    mutable std::optional<RowPositions> rowPositions_; //buffer: create on demand after updateView()
 
     struct GroupDetail
     {
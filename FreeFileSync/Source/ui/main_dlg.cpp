@@ -38,7 +38,6 @@
 #include "small_dlgs.h"
 #include "rename_dlg.h"
 #include "folder_pair.h"
-#include "search_grid.h"
 #include "batch_config.h"
 #include "app_icon.h"
 #include "../base_tools.h"
@@ -936,6 +935,7 @@ imgFileManagerSmall_([]
     //----------------------------------------------------------------------------------
 
     m_panelSearch->Bind(wxEVT_CHAR_HOOK, [this](wxKeyEvent& event) { onSearchPanelKeyPressed(event); });
+    m_checkBoxMatchCase->Bind(wxEVT_CHECKBOX, [this](wxCommandEvent& event) { updateSearchIndex(); });
 
 
     //set tool tips with (non-translated!) short cut hint
@@ -1115,7 +1115,7 @@ imgFileManagerSmall_([]
                 {
                     if (startsWith(fi.itemName, Zstr("ErrorLog ")) && endsWith(fi.itemName, Zstr(".xml"))) //case-sensitive
                     {
-                        append(extraLog, loadErrorLog(fi.fullPath)); //throw FileError
+                        extraLog.append(loadErrorLog(fi.fullPath)); //throw FileError
                         removeFilePlain(fi.fullPath); //throw FileError
                         //yeah, "read + delete" is a bit racy...
                     }
@@ -1123,7 +1123,7 @@ imgFileManagerSmall_([]
             }
             catch (const FileError& e) { logMsg(extraLog, e.toString(), MessageType::MSG_TYPE_ERROR); }
 
-            std::stable_sort(extraLog.begin(), extraLog.end(), [](const LogEntry& lhs, const LogEntry& rhs) { return lhs.time < rhs.time; });
+            extraLog.sortByTime();
 
             if (!extraLog.empty())
             {
@@ -1470,6 +1470,8 @@ void MainDialog::setSyncDirManually(const std::vector<FileSystemObject*>& select
         setSyncDirectionRec(direction, *fsObj); //set new direction (recursively)
         setActiveStatus(true, *fsObj); //works recursively for directories
     }
+    treegrid::getDataView(*m_gridOverview).notifyItemsChanged(selection); //perf: update only these and their parents
+
     updateGui();
 }
 
@@ -1485,6 +1487,8 @@ void MainDialog::setIncludedManually(const std::vector<FileSystemObject*>& selec
     for (FileSystemObject* fsObj : selection)
         setActiveStatus(setActive, *fsObj); //works recursively for directories
 
+    treegrid::getDataView(*m_gridOverview).notifyItemsChanged(selection); //perf: update only these and their parents
+
     updateGuiDelayedIf(!m_bpButtonShowExcluded->isActive()); //show update GUI before removing rows
 }
 
@@ -1721,7 +1725,7 @@ void MainDialog::deleteSelectedFiles(const std::vector<FileSystemObject*>& selec
     const StatusHandlerTemporaryPanel::Result r = statusHandler.prepareResult(); //noexcept
     setLastOperationLog(r.summary, r.errorLog.ptr());
 
-    append(fullSyncLog_->log, r.errorLog.ref());
+    fullSyncLog_->log.append(r.errorLog.ref());
     fullSyncLog_->totalTime += r.summary.totalTime;
 
     //remove rows that are empty: just a beautification, invalid rows shouldn't cause issues
@@ -1783,7 +1787,7 @@ void MainDialog::renameSelectedFiles(const std::vector<FileSystemObject*>& selec
     const StatusHandlerTemporaryPanel::Result r = statusHandler.prepareResult(); //noexcept
     setLastOperationLog(r.summary, r.errorLog.ptr());
 
-    append(fullSyncLog_->log, r.errorLog.ref());
+    fullSyncLog_->log.append(r.errorLog.ref());
     fullSyncLog_->totalTime += r.summary.totalTime;
 
     updateGui();
@@ -3025,6 +3029,7 @@ void MainDialog::onGridLabelContextRim(GridLabelClickEvent& event, bool leftSide
             caItemPath->offset -= caToggle->visible ? caToggle->offset : -caToggle->offset;
 
             grid.setColumnConfig(colAttr);
+            updateSearchIndex();
         }
     };
 
@@ -3041,6 +3046,7 @@ void MainDialog::onGridLabelContextRim(GridLabelClickEvent& event, bool leftSide
     {
         itemPathFormat = fmt;
         filegrid::setItemPathForm(grid, fmt);
+        updateSearchIndex();
     };
     auto addFormatEntry = [&](const wxString& label, ItemPathFormat fmt)
     {
@@ -4904,7 +4910,7 @@ void MainDialog::onStartSync(wxCommandEvent& event)
     StatusHandlerFloatingDialog::Result r = statusHandler.prepareResult();
 
     //merge logs of comparison, manual operations, sync
-    append(fullSyncLog_->log, r.errorLog.ref());
+    fullSyncLog_->log.append(r.errorLog.ref());
     fullSyncLog_->totalTime += r.summary.totalTime;
 
 
@@ -5232,7 +5238,7 @@ void MainDialog::startSyncForSelecction(const std::vector<FileSystemObject*>& se
 
         setLastOperationLog(r.summary, r.errorLog.ptr());
 
-        append(fullSyncLog_->log, r.errorLog.ref());
+        fullSyncLog_->log.append(r.errorLog.ref());
         fullSyncLog_->totalTime += r.summary.totalTime;
 
     } //run updateGui() *after* reverting our temporary exclusions
@@ -5673,6 +5679,17 @@ void MainDialog::updateGridViewData()
 
     //update status bar information
     setStatusBarFileStats(fileStatsLeft, fileStatsRight);
+
+    updateSearchIndex();
+}
+
+
+void MainDialog::updateSearchIndex()
+{
+    gridSearch_.clearIndex();
+
+    if (auiMgr_.GetPane(m_panelSearch).IsShown()) //index only while in use: might need hundreds of MB for millions of rows
+        gridSearch_.startIndexing(*m_gridMainL, *m_gridMainR, m_checkBoxMatchCase->GetValue());
 }
 
 
@@ -5784,6 +5801,8 @@ void MainDialog::showFindPanel(bool show) //CTRL + F or F3 with empty search phr
     {
         auiMgr_.GetPane(m_panelSearch).Show(show);
         auiMgr_.Update();
+
+        updateSearchIndex(); //start building in background, or free memory
     }
 
     if (show)
@@ -5822,23 +5841,25 @@ void MainDialog::startFindNext(bool searchAscending) //F3 or ENTER in m_textCtrl
         if ((isComponentOf(focus, m_panelSearch) ? focusAfterCloseSearch_ : focus->GetId()) == m_gridMainR->getMainWin().GetId())
             std::swap(grid1, grid2); //select side to start search at grid cursor position
 
-        wxBeginBusyCursor(wxHOURGLASS_CURSOR);
-        const std::pair<const Grid*, ptrdiff_t> result = findGridMatch(*grid1, *grid2, utfTo<std::wstring>(searchString),
-                                                                       m_checkBoxMatchCase->GetValue(), searchAscending);
+        wxBeginBusyCursor(wxHOURGLASS_CURSOR); //index might not be ready yet
+        const GridSearch::Match result = gridSearch_.findMatch(*grid1, *grid2, searchString,
+                                                               m_checkBoxMatchCase->GetValue(), searchAscending);
         //parameter owned by GUI, *not* globalCfg structure! => we should better implement a getGlocalCfg()!
         wxEndBusyCursor();
 
-        if (Grid* grid = const_cast<Grid*>(result.first)) //grid wasn't const when passing to findAndSelectNext(), so this is legal
+        if (Grid* grid = const_cast<Grid*>(result.grid)) //grid wasn't const when passing to findAndSelectNext(), so this is legal
         {
-            assert(result.second >= 0);
+            assert(result.row >= 0);
 
             filegrid::setScrollMaster(*grid);
-            grid->setGridCursor(result.second, GridEventPolicy::allow);
+            grid->setGridCursor(result.row, GridEventPolicy::allow);
 
             focusAfterCloseSearch_ = grid->getMainWin().GetId();
 
             if (!isComponentOf(wxWindow::FindFocus(), m_panelSearch))
                 grid->getMainWin().SetFocus();
+
+            flashStatusInfo(_P("1 match", "%x matches", result.matchCount));
         }
         else
         {
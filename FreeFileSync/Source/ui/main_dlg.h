@@ -17,6 +17,7 @@
 #include "sync_cfg.h"
 #include "log_panel.h"
 #include "folder_history_box.h"
+#include "search_grid.h"
 #include "../config.h"
 //#include "../status_handler.h"
 #include "../base/algorithm.h"
@@ -97,6 +98,7 @@ private:
     void updateGridViewData();     //
     void updateStatistics(const SyncStatistics& st); // more fine-grained updaters
     void updateUnsavedCfgStatus(); //
+    void updateSearchIndex();      //
 
     std::vector<std::wstring> getJobNames() const;
 
@@ -350,6 +352,8 @@ private:
 
     zen::AsyncGuiQueue guiQueue_; //schedule and run long-running tasks asynchronously, but process results on GUI queue
 
+    GridSearch gridSearch_; //index of grid texts => rebuild whenever grid content changes: updateSearchIndex()
+
     wxWindowID focusAfterCloseLog_    = wxID_ANY; //
     wxWindowID focusAfterCloseSearch_ = wxID_ANY; //restore focus after panel is closed
     //don't save wxWindow* to arbitrary window: might not exist anymore when hideFindPanel() uses it!!! (e.g. some folder pair panel)
@@ -49,81 +49,185 @@ void normalizeForSearch<false /*respectCase*/>(std::wstring& str)
 
 
 template <bool respectCase>
-class MatchFound
+std::string getSearchText(std::wstring&& str)
 {
-public:
-    explicit MatchFound(const std::wstring& textToFind) : textToFind_(textToFind)
-    {
-        normalizeForSearch<respectCase>(textToFind_);
-    }
+    normalizeForSearch<respectCase>(str);
+    return utfTo<std::string>(str); //UTF-8 is self-synchronizing => substring search on code units finds code point sequences only
+}
 
-    bool operator()(std::wstring&& phrase) const
-    {
-        normalizeForSearch<respectCase>(phrase);
-        return contains(phrase, textToFind_);
-    }
 
-private:
-    std::wstring textToFind_;
-};
+std::vector<ColumnType> getVisibleColumns(const Grid& grid)
+{
+    std::vector<ColumnType> colTypes;
+    for (const Grid::ColAttributes& ca : grid.getColumnConfig())
+        if (ca.visible)
+            colTypes.push_back(ca.type);
+    return colTypes;
+}
 
-//###########################################################################################
 
-template <bool respectCase>
-ptrdiff_t findRow(const Grid& grid, //return -1 if no matching row found
-                  const std::wstring& searchString,
+//return -1 if no matching row found
+ptrdiff_t findRow(const std::string& text,
+                  const std::vector<size_t>& rowBegin,
+                  const std::string& textToFind,
                   bool searchAscending,
                   size_t rowFirst, //range to search:
                   size_t rowLast)  // [rowFirst, rowLast)
 {
-    if (auto prov = grid.getDataProvider())
+    assert(!textToFind.empty() && !contains(textToFind, '\0')); //=> matches can't span multiple cells
+    if (rowFirst >= rowLast)
+        return -1;
+
+    const size_t posFirst = rowBegin[rowFirst];
+    const size_t posLast  = rowBegin[rowLast];
+    size_t pos = std::string::npos;
+
+    if (searchAscending)
+        pos = text.find(textToFind, posFirst);
+    else if (posLast >= textToFind.size())
+        pos = text.rfind(textToFind, posLast - textToFind.size());
+
+    if (pos == std::string::npos || pos < posFirst || pos >= posLast)
+        return -1;
+
+    return std::upper_bound(rowBegin.begin(), rowBegin.end(), pos) - rowBegin.begin() - 1;
+}
+}
+
+
+void GridSearch::startIndexing(const Grid& grid1, const Grid& grid2, bool respectCase)
+{
+    clearIndex(); //cancel and join running worker first: don't hold two indexes in memory
+
+    auto index = std::make_shared<Index>();
+    index->respectCase = respectCase;
+
+    std::vector<GridData::ValueSnapshot> snapshots;
+    for (size_t i = 0; i < std::size(index->gridTexts); ++i)
+    {
+        const Grid& grid = i == 0 ? grid1 : grid2;
+        GridTexts& gt = index->gridTexts[i];
+
+        gt.grid = &grid;
+        gt.prov = grid.getDataProvider();
+        gt.colTypes = getVisibleColumns(grid);
+        gt.rowCount = gt.prov ? gt.prov->getRowCount() : 0;
+
+        snapshots.push_back(gt.prov && !gt.colTypes.empty() ? gt.prov->getValueSnapshot(gt.colTypes) : nullptr);
+    }
+
+    std::promise<void> promReady;
+    indexReady_ = promReady.get_future();
+    indexPending_ = index;
+
+    indexThread_ = InterruptibleThread([index, snapshots = std::move(snapshots), promReady = std::move(promReady)]() mutable
     {
-        std::vector<Grid::ColAttributes> colAttr = grid.getColumnConfig();
-        std::erase_if(colAttr, [](const Grid::ColAttributes& ca) { return !ca.visible; });
-        if (!colAttr.empty())
+        setCurrentThreadName(Zstr("Grid search index"));
+
+        for (size_t i = 0; i < std::size(index->gridTexts); ++i)
         {
-            const MatchFound<respectCase> matchFound(searchString);
+            GridTexts& gt = index->gridTexts[i];
+            gt.rowBegin.reserve(gt.rowCount + 1);
 
-            if (searchAscending)
-            {
-                for (size_t row = rowFirst; row < rowLast; ++row)
-                    for (const Grid::ColAttributes& ca : colAttr)
-                        if (matchFound(prov->getValue(row, ca.type)))
-                            return row;
-            }
+            if (snapshots[i])
+                for (size_t row = 0; row < gt.rowCount; ++row)
+                {
+                    if (row % 1000 == 0)
+                        interruptionPoint(); //throw ThreadStopRequest
+
+                    gt.rowBegin.push_back(gt.text.size());
+
+                    for (const ColumnType colType : gt.colTypes)
+                    {
+                        gt.text += index->respectCase ?
+                                   getSearchText<true >(snapshots[i](row, colType)) :
+                                   getSearchText<false>(snapshots[i](row, colType));
+                        gt.text += '\0';
+                    }
+                }
             else
-                for (size_t row = rowLast; row-- > rowFirst;)
-                    for (const Grid::ColAttributes& ca : colAttr)
-                        if (matchFound(prov->getValue(row, ca.type)))
-                            return row;
+                gt.rowBegin.resize(gt.rowCount, 0);
+
+            gt.rowBegin.push_back(gt.text.size());
+            gt.text.shrink_to_fit();
+
+            snapshots[i] = nullptr; //free memory early
         }
-    }
-    return -1;
+        promReady.set_value();
+    });
 }
+
+
+void GridSearch::clearIndex()
+{
+    indexThread_ = {}; //request stop + join
+    indexReady_ = {};
+    indexPending_.reset();
+    index_.reset();
 }
 
 
-std::pair<const Grid*, ptrdiff_t> fff::findGridMatch(const Grid& grid1, const Grid& grid2, const std::wstring& searchString, bool respectCase, bool searchAscending)
+GridSearch::Index& GridSearch::getIndex(const Grid& grid1, const Grid& grid2, bool respectCase)
+{
+    auto isCurrent = [&](const Index& index)
+    {
+        auto gridUnchanged = [&](const Grid& grid)
+        {
+            return std::any_of(std::begin(index.gridTexts), std::end(index.gridTexts), [&](const GridTexts& gt)
+            {
+                return gt.grid == &grid &&
+                       gt.prov == grid.getDataProvider() &&
+                       gt.colTypes == getVisibleColumns(grid) &&
+                       gt.rowCount == (gt.prov ? gt.prov->getRowCount() : 0);
+            });
+        };
+        return index.respectCase == respectCase && gridUnchanged(grid1) && gridUnchanged(grid2);
+    };
+
+    if (!index_ || !isCurrent(*index_))
+    {
+        if (!indexPending_ || !isCurrent(*indexPending_)) //e.g. column visibility changed
+            startIndexing(grid1, grid2, respectCase);
+
+        indexReady_.get(); //wait for worker
+        indexThread_ = {}; //already finished
+        index_ = std::move(indexPending_);
+    }
+    return *index_;
+}
+
+
+GridSearch::Match GridSearch::findMatch(const Grid& gridStart, const Grid& gridOther, const std::wstring& searchString, bool respectCase, bool searchAscending)
 {
     //PERF_START
+    const std::string textToFind = respectCase ?
+                                   getSearchText<true >(std::wstring(searchString)) :
+                                   getSearchText<false>(std::wstring(searchString));
+    if (textToFind.empty())
+        return {};
 
-    const size_t rowCount1 = grid1.getRowCount();
-    const size_t rowCount2 = grid2.getRowCount();
+    Index& index = getIndex(gridStart, gridOther, respectCase);
 
-    size_t cursorRow1 = grid1.getGridCursor();
+    const GridTexts& texts1 = index.gridTexts[index.gridTexts[0].grid == &gridStart ? 0 : 1];
+    const GridTexts& texts2 = index.gridTexts[index.gridTexts[0].grid == &gridStart ? 1 : 0];
+
+    const size_t rowCount1 = texts1.rowCount;
+    const size_t rowCount2 = texts2.rowCount;
+
+    size_t cursorRow1 = gridStart.getGridCursor();
     if (cursorRow1 >= rowCount1)
         cursorRow1 = 0;
 
-    std::pair<const Grid*, ptrdiff_t> result(nullptr, -1);
+    Match result;
 
-    auto finishSearch = [&](const Grid& grid, size_t rowFirst, size_t rowLast)
+    auto finishSearch = [&](const GridTexts& texts, size_t rowFirst, size_t rowLast)
     {
-        const ptrdiff_t targetRow = respectCase ?
-                                    findRow<true >(grid, searchString, searchAscending, rowFirst, rowLast) :
-                                    findRow<false>(grid, searchString, searchAscending, rowFirst, rowLast);
+        const ptrdiff_t targetRow = texts.colTypes.empty() ? -1 :
+                                    findRow(texts.text, texts.rowBegin, textToFind, searchAscending, rowFirst, rowLast);
         if (targetRow >= 0)
         {
-            result = {&grid, targetRow};
+            result.grid = texts.grid;
+            result.row  = targetRow;
             return true;
         }
         return false;
@@ -131,15 +235,40 @@ std::pair<const Grid*, ptrdiff_t> fff::findGridMatch(const Grid& grid1, const Gr
 
     if (searchAscending)
     {
-        if (!finishSearch(grid1, cursorRow1 + 1, rowCount1))
-            if (!finishSearch(grid2, 0, rowCount2))
-                finishSearch(grid1, 0, cursorRow1 + 1);
+        if (!finishSearch(texts1, std::min(cursorRow1 + 1, rowCount1), rowCount1))
+            if (!finishSearch(texts2, 0, rowCount2))
+                finishSearch(texts1, 0, std::min(cursorRow1 + 1, rowCount1));
     }
     else
     {
-        if (!finishSearch(grid1, 0, cursorRow1))
-            if (!finishSearch(grid2, 0, rowCount2))
-                finishSearch(grid1, cursorRow1, rowCount1);
+        if (!finishSearch(texts1, 0, cursorRow1))
+            if (!finishSearch(texts2, 0, rowCount2))
+                finishSearch(texts1, cursorRow1, rowCount1);
+    }
+
+    if (result.grid)
+    {
+        if (index.lastTextToFind != textToFind)
+        {
+            //both grids show the same rows => count each row once
+            std::vector<bool> rowMatches(std::max(rowCount1, rowCount2));
+
+            for (const GridTexts& texts : index.gridTexts)
+                if (!texts.colTypes.empty())
+                    for (size_t row = 0; row < texts.rowCount;)
+                    {
+                        const ptrdiff_t matchRow = findRow(texts.text, texts.rowBegin, textToFind, true /*searchAscending*/, row, texts.rowCount);
+                        if (matchRow < 0)
+                            break;
+
+                        rowMatches[matchRow] = true;
+                        row = matchRow + 1;
+                    }
+
+            index.lastTextToFind = textToFind;
+            index.lastMatchCount = std::count(rowMatches.begin(), rowMatches.end(), true);
+        }
+        result.matchCount = index.lastMatchCount;
     }
     return result;
 }
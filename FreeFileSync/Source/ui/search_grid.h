@@ -7,13 +7,61 @@
 #ifndef SEARCH_H_423905762345342526587
 #define SEARCH_H_423905762345342526587
 
+#include <future>
+#include <zen/thread.h>
 #include <wx+/grid.h>
 
 
 namespace fff
 {
-std::pair<const zen::Grid*, ptrdiff_t> findGridMatch(const zen::Grid& grid1, const zen::Grid& grid2, const std::wstring& searchString, bool respectCase, bool searchAscending);
-//returns (grid/row) where the value was found, (nullptr, -1) if not found
+/* search index for "find next":
+    - cell texts are copied on main thread (GridData::getValueSnapshot()), normalized and indexed on a worker thread
+    - grid1 and grid2 show the same rows, e.g. left/right file grid                                              */
+class GridSearch
+{
+public:
+    //call after grid content has changed: cancels running index build
+    void startIndexing(const zen::Grid& grid1, const zen::Grid& grid2, bool respectCase);
+    void clearIndex(); //free memory
+
+    struct Match
+    {
+        const zen::Grid* grid = nullptr; //nullptr if not found
+        ptrdiff_t row = -1;
+        size_t matchCount = 0; //number of matching rows: match on both grids counts once
+    };
+    //search starts at grid cursor of gridStart; waits for index if not yet ready
+    Match findMatch(const zen::Grid& gridStart, const zen::Grid& gridOther, const std::wstring& searchString, bool respectCase, bool searchAscending);
+
+private:
+    struct GridTexts
+    {
+        const zen::Grid* grid = nullptr;
+        const zen::GridData* prov = nullptr;
+        std::vector<zen::ColumnType> colTypes; //visible columns only
+        size_t rowCount = 0;
+
+        //written by worker thread:
+        std::string text;             //UTF8-encoded, normalized cell texts: each cell followed by '\0'
+        std::vector<size_t> rowBegin; //position within "text"; plus end position for last row
+    };
+
+    struct Index
+    {
+        bool respectCase = false;
+        GridTexts gridTexts[2];
+
+        std::string lastTextToFind; //buffer match count of last search
+        size_t lastMatchCount = 0;
+    };
+    Index& getIndex(const zen::Grid& grid1, const zen::Grid& grid2, bool respectCase);
+
+    std::shared_ptr<Index> index_;
+
+    std::shared_ptr<Index> indexPending_; //worker thread owns all but GridTexts' meta data until indexReady_
+    std::future<void> indexReady_;
+    zen::InterruptibleThread indexThread_;
+};
 }
 
 #endif //SEARCH_H_423905762345342526587
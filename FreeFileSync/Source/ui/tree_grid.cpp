@@ -55,7 +55,7 @@ TreeView::TreeView(FolderComparison& folderCmp, const SortInfo& si) : currentSor
 inline
 void TreeView::compressNode(Container& cont) //remove single-element sub-trees -> gain clarity + usability (call *after* inclusion check!!!)
 {
-    if (cont.subDirs.empty()) //single files node
+    if (!cont.hasSubDirs) //single files node
         cont.showFilesNode = false;
 
 #if 0 //let's not go overboard: empty folders should not be condensed => used for file exclusion filter; user expects to see them
@@ -69,9 +69,7 @@ void TreeView::compressNode(Container& cont) //remove single-element sub-trees -
 
 
 template <class Function> //(const FileSystemObject&) -> bool
-void TreeView::extractVisibleSubtree(ContainerObject& conObj, //in
-                                     TreeView::Container& cont, //out
-                                     Function pred)
+void TreeView::updateFolderStats(const ContainerObject& conObj, bool included, const Function& pred) //requires up to date stats of sub folders
 {
     auto getBytes = [](const FilePair& file) //MSVC screws up miserably if we put this lambda into std::for_each
     {
@@ -89,45 +87,127 @@ void TreeView::extractVisibleSubtree(ContainerObject& conObj, //in
                         file.isEmpty<SelectSide::right>() ? 0 : file.getFileSize<SelectSide::right>());
     };
 
-    for (FilePair& file : conObj.files())
+    FolderStats stats;
+
+    for (const FilePair& file : conObj.files())
         if (pred(file))
         {
-            cont.bytesNet += getBytes(file);
-            ++cont.itemCountNet;
+            stats.bytesNet += getBytes(file);
+            ++stats.itemCountNet;
         }
 
-    for (SymlinkPair& symlink : conObj.symlinks())
+    for (const SymlinkPair& symlink : conObj.symlinks())
         if (pred(symlink))
-            ++cont.itemCountNet;
+            ++stats.itemCountNet;
+
+    stats.bytesGross     = stats.bytesNet;
+    stats.itemCountGross = stats.itemCountNet + (included ? 1 : 0);
 
-    cont.showFilesNode = cont.itemCountNet > 0;
+    for (const FolderPair& folder : conObj.subfolders())
+        if (auto it = folderStats_.find(&folder);
+            it != folderStats_.end()) //sub folder on view
+        {
+            stats.bytesGross     += it->second.bytesGross;
+            stats.itemCountGross += it->second.itemCountGross;
+            stats.hasSubDirs = true;
+        }
 
-    cont.bytesGross     += cont.bytesNet;
-    cont.itemCountGross += cont.itemCountNet;
+    if (included || stats.hasSubDirs || stats.itemCountNet > 0)
+        folderStats_.insert_or_assign(&conObj, stats);
+    else
+        folderStats_.erase(&conObj);
+}
 
-    cont.subDirs.reserve(conObj.subfolders().size()); //avoid expensive reallocations!
 
-    for (FolderPair& folder : conObj.subfolders())
+template <class Function>
+void TreeView::updateSubtreeStats(const ContainerObject& conObj, const Function& pred) //excluding "conObj"
+{
+    for (const FolderPair& folder : conObj.subfolders())
     {
-        const bool included = pred(folder);
+        updateSubtreeStats(folder, pred); //bottom-up
+        updateFolderStats(folder, pred(folder), pred);
+    }
+}
 
-        cont.subDirs.emplace_back(); //
-        auto& subDirCont = cont.subDirs.back();
-        TreeView::extractVisibleSubtree(folder, subDirCont, pred);
-        if (included)
-            ++subDirCont.itemCountGross;
 
-        cont.bytesGross     += subDirCont.bytesGross;
-        cont.itemCountGross += subDirCont.itemCountGross;
+template <class Function>
+bool TreeView::updateStatsIncremental(const std::vector<std::weak_ptr<FileSystemObject>>& changedItems, const Function& pred)
+{
+    std::unordered_set<const ContainerObject*> changedParents;
 
-        if (!included && subDirCont.subDirs.empty() && !subDirCont.showFilesNode)
-            cont.subDirs.pop_back();
-        else
+    for (const std::weak_ptr<FileSystemObject>& itemRef : changedItems)
+    {
+        const std::shared_ptr<FileSystemObject> fsObj = itemRef.lock();
+        if (!fsObj) //FolderComparison has changed in other ways, too
+            return false;
+
+        if (const FolderPair* folder = dynamic_cast<const FolderPair*>(fsObj.get()))
         {
-            subDirCont.containerRef = std::static_pointer_cast<FolderPair>(folder.shared_from_this());
-            compressNode(subDirCont);
+            updateSubtreeStats(*folder, pred);
+            updateFolderStats(*folder, pred(*folder), pred);
         }
+
+        //sync operation of a moved file depends on its counterpart
+        visitFSObjectRecursively(*fsObj, [](FolderPair& folder) {}, [&](FilePair& file)
+        {
+            if (const FilePair* movePair = file.getMovePair())
+                changedParents.insert(&movePair->parent());
+        }, [](SymlinkPair& symlink) {});
+
+        changedParents.insert(&fsObj->parent());
     }
+
+    //update ancestors only: bottom-up, and each one once
+    std::vector<std::pair<size_t /*depth*/, const ContainerObject*>> ancestors;
+    std::unordered_set<const ContainerObject*> ancestorsSeen;
+
+    for (const ContainerObject* conObj : changedParents)
+        for (const ContainerObject* anc = conObj; anc && ancestorsSeen.insert(anc).second; )
+        {
+            const FolderPair* folder = dynamic_cast<const FolderPair*>(anc);
+
+            size_t depth = 0;
+            for (const FolderPair* fp = folder; fp; fp = dynamic_cast<const FolderPair*>(&fp->parent()))
+                ++depth;
+
+            ancestors.emplace_back(depth, anc);
+            anc = folder ? &folder->parent() : nullptr;
+        }
+
+    std::sort(ancestors.begin(), ancestors.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    for (const auto& [depth, conObj] : ancestors)
+        if (const FolderPair* folder = dynamic_cast<const FolderPair*>(conObj))
+            updateFolderStats(*folder, pred(*folder), pred);
+        else
+            updateFolderStats(*conObj, false /*included*/, pred); //BaseFolderPair
+    return true;
+}
+
+
+const std::vector<TreeView::Container>& TreeView::getSubDirs(const Container& cont)
+{
+    if (!cont.subDirs)
+    {
+        //aggregates of all folders on view are stored during view update => cost scales with number of children, not sub tree size
+        //note: pointers into "cont.subDirs" are stored in "flatTree_" => materialize at most once per view update!
+        std::vector<Container> subDirs;
+
+        if (ContainerObject* conObj = cont.containerRef.lock().get())
+            for (FolderPair& folder : conObj->subfolders())
+                if (auto it = folderStats_.find(&folder);
+                    it != folderStats_.end())
+                {
+                    Container& subDirCont = subDirs.emplace_back();
+                    static_cast<FolderStats&>(subDirCont) = it->second;
+                    subDirCont.showFilesNode = subDirCont.itemCountNet > 0;
+                    subDirCont.containerRef = std::static_pointer_cast<FolderPair>(folder.shared_from_this());
+                    compressNode(subDirCont);
+                }
+
+        cont.subDirs = std::move(subDirs);
+    }
+    return *cont.subDirs;
 }
 
 
@@ -266,11 +346,13 @@ void TreeView::sortSingleLevel(std::vector<TreeLine>& items, ColumnTypeOverview
 
 void TreeView::getChildren(const Container& cont, unsigned int level, std::vector<TreeLine>& output)
 {
+    const std::vector<Container>& subDirs = getSubDirs(cont);
+
     output.clear();
-    output.reserve(cont.subDirs.size() + 1); //keep pointers in "workList" valid
+    output.reserve(subDirs.size() + 1); //keep pointers in "workList" valid
     std::vector<std::pair<uint64_t, int*>> workList;
 
-    for (const Container& subDir : cont.subDirs)
+    for (const Container& subDir : subDirs)
     {
         output.push_back({level, 0, &subDir, NodeType::folder});
         workList.emplace_back(subDir.bytesGross, &output.back().percent);
@@ -368,37 +450,55 @@ void TreeView::applySubView(std::vector<RootNodeImpl>&& newView)
 
 
 template <class Predicate>
-void TreeView::updateView(Predicate pred)
+void TreeView::updateView(Predicate pred, std::vector<bool>&& viewFilterCfg)
 {
-    //update view on full data
+    std::vector<std::weak_ptr<FileSystemObject>> changedItems;
+    changedItems.swap(changedItems_);
+
+    //update aggregates on full data: incremental if only a few items changed for the same view filter
+    if (changedItems.empty() || viewFilterCfg != viewFilterCfg_ ||
+        !updateStatsIncremental(changedItems, pred))
+    {
+        folderStats_.clear();
+
+        for (const std::weak_ptr<BaseFolderPair>& baseObjRef : folderCmp_)
+            if (const BaseFolderPair* baseObj = baseObjRef.lock().get())
+            {
+                updateSubtreeStats(*baseObj, pred);
+                updateFolderStats(*baseObj, false /*included*/, pred);
+            }
+    }
+    viewFilterCfg_ = std::move(viewFilterCfg);
+    lastViewFilterPred_ = pred;
+
     std::vector<RootNodeImpl> newView;
     newView.reserve(folderCmp_.size()); //avoid expensive reallocations!
 
     for (const std::weak_ptr<BaseFolderPair>& baseObjRef : folderCmp_)
-        if (BaseFolderPair* baseObj = baseObjRef.lock().get())
-        {
-            newView.emplace_back();
-            RootNodeImpl& root = newView.back();
-            this->extractVisibleSubtree(*baseObj, root, pred); //"this->" is bogus for a static method, but GCC screws this one up
-
-            //warning: the following lines are almost 1:1 copy from extractVisibleSubtree, adapted for BaseFolderPair:
-            if (root.subDirs.empty() && !root.showFilesNode)
-                newView.pop_back();
-            else
+        if (const BaseFolderPair* baseObj = baseObjRef.lock().get())
+            if (auto it = folderStats_.find(baseObj);
+                it != folderStats_.end()) //root on view
             {
+                RootNodeImpl& root = newView.emplace_back();
+                static_cast<FolderStats&>(root) = it->second;
+                root.showFilesNode = root.itemCountNet > 0;
                 root.containerRef = baseObjRef;
                 root.displayName = getShortDisplayNameForFolderPair(baseObj->getAbstractPath<SelectSide::left >(),
                                                                     baseObj->getAbstractPath<SelectSide::right>());
-
-                this->compressNode(root); //"this->" required by two-pass lookup as enforced by GCC 4.7
+                compressNode(root);
             }
-        }
 
-    lastViewFilterPred_ = pred;
     applySubView(std::move(newView));
 }
 
 
+void TreeView::notifyItemsChanged(const std::vector<FileSystemObject*>& items)
+{
+    for (FileSystemObject* fsObj : items)
+        changedItems_.push_back(fsObj->shared_from_this());
+}
+
+
 void TreeView::setSortDirection(ColumnTypeOverview colType, bool ascending) //apply permanently!
 {
     currentSort_ = SortInfo{colType, ascending};
@@ -420,7 +520,7 @@ TreeView::NodeStatus TreeView::getStatus(size_t row) const
         {
             case NodeType::root:
             case NodeType::folder:
-                return flatTree_[row].node->showFilesNode || !flatTree_[row].node->subDirs.empty() ? NodeStatus::reduced : NodeStatus::empty;
+                return flatTree_[row].node->showFilesNode || flatTree_[row].node->hasSubDirs ? NodeStatus::reduced : NodeStatus::empty;
 
             case NodeType::files:
                 return NodeStatus::empty;
@@ -462,20 +562,10 @@ void TreeView::reduceNode(size_t row)
     {
         const unsigned int parentLevel = flatTree_[row].level;
 
-        bool done = false;
-        flatTree_.erase(std::remove_if(flatTree_.begin() + row + 1, flatTree_.end(),
-                                       [&](const TreeLine& line) -> bool
-        {
-            if (done)
-                return false;
-            if (line.level > parentLevel)
-                return true;
-            else
-            {
-                done = true;
-                return false;
-            }
-        }), flatTree_.end());
+        //sub tree lines are contiguous: no need to look at the rest of the tree
+        auto itLast = std::find_if(flatTree_.begin() + row + 1, flatTree_.end(), [&](const TreeLine& line) { return line.level <= parentLevel; });
+
+        flatTree_.erase(flatTree_.begin() + row + 1, itLast);
     }
 }
 
@@ -536,7 +626,9 @@ void TreeView::applyDifferenceFilter(bool showExcluded,
         }
         assert(false);
         return true;
-    });
+    },
+    {false /*action filter*/, showExcluded, leftOnlyFilesActive, rightOnlyFilesActive, leftNewerFilesActive, rightNewerFilesActive,
+     differentFilesActive, equalFilesActive, conflictFilesActive});
 }
 
 
@@ -594,7 +686,9 @@ void TreeView::applyActionFilter(bool showExcluded,
         }
         assert(false);
         return true;
-    });
+    },
+    {true /*action filter*/, showExcluded, syncCreateLeftActive, syncCreateRightActive, syncDeleteLeftActive, syncDeleteRightActive,
+     syncDirOverwLeftActive, syncDirOverwRightActive, syncDirNoneActive, syncEqualActive, conflictFilesActive});
 }
 
 
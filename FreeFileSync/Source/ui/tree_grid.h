@@ -8,6 +8,7 @@
 #define TREE_VIEW_H_841703190201835280256673425
 
 #include <functional>
+#include <unordered_map>
 #include <wx+/grid.h>
 #include "tree_grid_attr.h"
 #include "../base/file_hierarchy.h"
@@ -102,6 +103,9 @@ public:
     NodeStatus getStatus(size_t row) const;
     ptrdiff_t getParent(size_t row) const; //return < 0 if none
 
+    //items changed, but nothing else since last view update => next applyXXXFilter() only updates these and their ancestors
+    void notifyItemsChanged(const std::vector<FileSystemObject*>& items);
+
     void setSortDirection(ColumnTypeOverview colType, bool ascending); //apply permanently!
     SortInfo getSortConfig() { return currentSort_; }
 
@@ -109,17 +113,22 @@ private:
     TreeView           (const TreeView&) = delete;
     TreeView& operator=(const TreeView&) = delete;
 
-    struct Container
+    struct FolderStats
     {
         uint64_t bytesGross = 0;
         uint64_t bytesNet   = 0; //bytes for files on view in this directory only
         int itemCountGross  = 0;
         int itemCountNet    = 0; //number of files on view in this directory only
+        bool hasSubDirs = false; //sub folders on view; known even if "subDirs" are not yet materialized
+    };
 
-        std::vector<Container> subDirs;
+    struct Container : public FolderStats
+    {
         bool showFilesNode = false; //"compress" algorithm may hide file nodes for directories with a single included file, i.e. itemCountGross == itemCountNet == 1
         std::weak_ptr<ContainerObject> containerRef; //-> BaseFolderPair if NodeType::root,
         //FolderPair if NodeType::folder, and parent ContainerObject if NodeType::files
+
+        mutable std::optional<std::vector<Container>> subDirs; //buffer: materialized on demand when node is expanded => cost scales with visible rows, not tree size
     };
 
     struct RootNodeImpl : public Container
@@ -143,10 +152,12 @@ private:
     };
 
     static void compressNode(Container& cont);
-    template <class Function>
-    static void extractVisibleSubtree(ContainerObject& conObj, Container& cont, Function includeObject);
+    template <class Function> void updateFolderStats(const ContainerObject& conObj, bool included, const Function& pred);
+    template <class Function> void updateSubtreeStats(const ContainerObject& conObj, const Function& pred);
+    template <class Function> bool updateStatsIncremental(const std::vector<std::weak_ptr<FileSystemObject>>& changedItems, const Function& pred);
+    const std::vector<Container>& getSubDirs(const Container& cont);
     void getChildren(const Container& cont, unsigned int level, std::vector<TreeLine>& output);
-    template <class Predicate> void updateView(Predicate pred);
+    template <class Predicate> void updateView(Predicate pred, std::vector<bool>&& viewFilterCfg);
     void applySubView(std::vector<RootNodeImpl>&& newView);
 
     template <bool ascending> static void sortSingleLevel(std::vector<TreeLine>& items, ColumnTypeOverview columnType);
@@ -157,6 +168,10 @@ private:
                     | (update...)             */
     std::vector<RootNodeImpl> folderCmpView_; //partial view on folderCmp -> unsorted (cannot be, because files are not a separate entity)
     std::function<bool(const FileSystemObject& fsObj)> lastViewFilterPred_; //buffer view filter predicate for lazy evaluation of files/symlinks corresponding to a TYPE_FILES node
+    std::vector<bool> viewFilterCfg_; //settings of "lastViewFilterPred_"
+
+    std::unordered_map<const ContainerObject*, FolderStats> folderStats_; //all folders (and roots) on view => children materialize in O(number of children)
+    std::vector<std::weak_ptr<FileSystemObject>> changedItems_; //see notifyItemsChanged()
     /*             /|\
                     | (update...)             */
     std::vector<std::weak_ptr<BaseFolderPair>> folderCmp_; //full raw data
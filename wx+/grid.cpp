@@ -161,6 +161,26 @@ void GridData::renderCell(wxDC& dc, const wxRect& rect, size_t row, ColumnType c
 }
 
 
+GridData::ValueSnapshot GridData::getValueSnapshot(const std::vector<ColumnType>& colTypes) const
+{
+    const size_t rowCount = getRowCount();
+
+    std::vector<std::wstring> cellValues;
+    cellValues.reserve(rowCount * colTypes.size());
+
+    for (size_t row = 0; row < rowCount; ++row)
+        for (const ColumnType colType : colTypes)
+            cellValues.push_back(getValue(row, colType));
+
+    return [cellValues = std::move(cellValues), colTypes](size_t row, ColumnType colType)
+    {
+        const size_t colIdx = std::find(colTypes.begin(), colTypes.end(), colType) - colTypes.begin();
+        assert(colIdx < colTypes.size());
+        return colIdx < colTypes.size() ? cellValues[row * colTypes.size() + colIdx] : std::wstring();
+    };
+}
+
+
 int GridData::getBestSize(const wxReadOnlyDC& dc, size_t row, ColumnType colType)
 {
     return dc.GetTextExtent(getValue(row, colType)).GetWidth() + 2 * getColumnGapLeft() + dipToWxsize(1); //gap on left and right side + border
@@ -190,12 +210,34 @@ void GridData::drawCellText(wxDC& dc, const wxRect& rect, const std::wstring_vie
     if (rect.width <= 0 || rect.height <= 0 || text.empty())
         return;
 
-    //truncate large texts and add ellipsis
-    wxString textTrunc(&text[0], text.size());
-    wxSize extentTrunc = textExtentHint ? *textExtentHint : dc.GetTextExtent(textTrunc);
-    assert(!textExtentHint || *textExtentHint == dc.GetTextExtent(textTrunc)); //"trust, but verify" :>
+    const auto& [textTrunc, extentTrunc] = truncateText(dc, text, rect.width, textExtentHint);
 
-    if (extentTrunc.GetWidth() > rect.width)
+    wxPoint pt = rect.GetTopLeft();
+    if (alignment & wxALIGN_RIGHT) //note: wxALIGN_LEFT == 0!
+        pt.x += rect.width - extentTrunc.GetWidth();
+    else if (alignment & wxALIGN_CENTER_HORIZONTAL)
+        pt.x += numeric::intDivFloor(rect.width - extentTrunc.GetWidth(), 2); //round down negative values, too!
+
+    if (alignment & wxALIGN_BOTTOM) //note: wxALIGN_TOP == 0!
+        pt.y += rect.height - extentTrunc.GetHeight();
+    else if (alignment & wxALIGN_CENTER_VERTICAL)
+        pt.y += numeric::intDivFloor(rect.height - extentTrunc.GetHeight(), 2); //round down negative values, too!
+
+    //std::optional<RecursiveDcClipper> clip; -> redundant!? RecursiveDcClipper already used during grid cell rendering
+    //if (extentTrunc.GetWidth() > rect.width)
+    //    clip.emplace(dc, rect);
+
+    dc.DrawText(textTrunc, pt);
+}
+
+
+GridData::TextTruncated GridData::truncateText(const wxReadOnlyDC& dc, const std::wstring_view text, int maxWidth, const wxSize* textExtentHint)
+{
+    TextTruncated trunc{std::wstring(text), {}};
+    trunc.extent = textExtentHint ? *textExtentHint : dc.GetTextExtent(trunc.text);
+    assert(!textExtentHint || *textExtentHint == dc.GetTextExtent(trunc.text)); //"trust, but verify" :>
+
+    if (trunc.extent.GetWidth() > maxWidth)
     {
         //unlike File Explorer, we truncate UTF-16 correctly: e.g. CJK-Ideograph encodes to TWO wchar_t: utfTo<std::wstring>("\xf0\xa4\xbd\x9c");
         size_t low  = 0;                   //number of Unicode chars!
@@ -207,43 +249,27 @@ void GridData::drawCellText(wxDC& dc, const wxRect& rect, const std::wstring_vie
                 {
                     if (low == 0)
                     {
-                        textTrunc   = ELLIPSIS;
-                        extentTrunc = dc.GetTextExtent(ELLIPSIS);
+                        trunc.text   = ELLIPSIS;
+                        trunc.extent = dc.GetTextExtent(ELLIPSIS);
                     }
                     break;
                 }
                 const size_t middle = (low + high) / 2; //=> never 0 when "high - low > 1"
 
-                /*const*/ wxString candidate = getUnicodeSubstring<wxString>(text, 0, middle) + ELLIPSIS;
+                /*const*/ std::wstring candidate = getUnicodeSubstring<std::wstring>(text, 0, middle) + ELLIPSIS;
                 const wxSize extentCand = dc.GetTextExtent(candidate); //perf: most expensive call of this routine!
 
-                if (extentCand.GetWidth() <= rect.width)
+                if (extentCand.GetWidth() <= maxWidth)
                 {
                     low = middle;
-                    textTrunc   = std::move(candidate);
-                    extentTrunc = extentCand;
+                    trunc.text   = std::move(candidate);
+                    trunc.extent = extentCand;
                 }
                 else
                     high = middle;
             }
     }
-
-    wxPoint pt = rect.GetTopLeft();
-    if (alignment & wxALIGN_RIGHT) //note: wxALIGN_LEFT == 0!
-        pt.x += rect.width - extentTrunc.GetWidth();
-    else if (alignment & wxALIGN_CENTER_HORIZONTAL)
-        pt.x += numeric::intDivFloor(rect.width - extentTrunc.GetWidth(), 2); //round down negative values, too!
-
-    if (alignment & wxALIGN_BOTTOM) //note: wxALIGN_TOP == 0!
-        pt.y += rect.height - extentTrunc.GetHeight();
-    else if (alignment & wxALIGN_CENTER_VERTICAL)
-        pt.y += numeric::intDivFloor(rect.height - extentTrunc.GetHeight(), 2); //round down negative values, too!
-
-    //std::optional<RecursiveDcClipper> clip; -> redundant!? RecursiveDcClipper already used during grid cell rendering
-    //if (extentTrunc.GetWidth() > rect.width)
-    //    clip.emplace(dc, rect);
-
-    dc.DrawText(textTrunc, pt);
+    return trunc;
 }
 
 
@@ -1416,6 +1442,7 @@ private:
 
     void ScrollWindow(int dx, int dy, const wxRect* rect) override
     {
+        //blit the already rendered area: only the newly exposed rows end up in render() via GetUpdateRegion()
         wxWindow::ScrollWindow(dx, dy, rect);
         rowLabelWin_.ScrollWindow(0, dy, rect);
         colLabelWin_.ScrollWindow(dx, 0, rect);
@@ -1570,14 +1597,20 @@ void Grid::updateWindowSizes(bool updateScrollbar)
     const wxSize mainWinSize(std::max(0, GetClientSize().GetWidth () - rowLabelWidth),
                              std::max(0, GetClientSize().GetHeight() - getColumnLabelHeight()));
 
+    const wxRect colLabelRectOld = colLabelWin_->GetRect();
+    const wxRect mainWinRectOld  = mainWin_    ->GetRect();
+
     cornerWin_  ->SetSize(0, 0, rowLabelWidth, getColumnLabelHeight());
     rowLabelWin_->SetSize(0, getColumnLabelHeight(), rowLabelWidth, mainWinSize.GetHeight());
     colLabelWin_->SetSize(rowLabelWidth, 0, mainWinSize.GetWidth(), getColumnLabelHeight());
     mainWin_    ->SetSize(rowLabelWidth, getColumnLabelHeight(), mainWinSize.GetWidth(), mainWinSize.GetHeight());
 
     //avoid flicker in wxWindowMSW::HandleSize() when calling ::EndDeferWindowPos() where the sub-windows are moved only although they need to be redrawn!
-    colLabelWin_->Refresh();
-    mainWin_    ->Refresh();
+    //=> but only if moved/resized: we're called after each scroll step, and a full refresh would discard MainWin::ScrollWindow()'s blit
+    if (colLabelWin_->GetRect() != colLabelRectOld)
+        colLabelWin_->Refresh();
+    if (mainWin_->GetRect() != mainWinRectOld)
+        mainWin_->Refresh();
 
     //3. update scrollbars: "guide wxScrolledHelper to not screw up too much"
     if (updateScrollbar)
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <optional>
+#include <functional>
 #include <vector>
 #include <zen/stl_tools.h>
 #include <wx/scrolwin.h>
@@ -111,6 +112,11 @@ public:
     virtual HoverArea    getMouseHover(const wxReadOnlyDC& dc, size_t row, ColumnType colType, int cellRelativePosX, int cellWidth) { return HoverArea::none; }
     virtual std::wstring getToolTip                           (size_t row, ColumnType colType, HoverArea rowHover) { return std::wstring(); }
 
+    //copy of getValue() for all rows that may be evaluated on a worker thread, e.g. to build a search index:
+    //default implementation copies the formatted cell texts => override if raw data is cheaper to copy
+    using ValueSnapshot = std::function<std::wstring(size_t row, ColumnType colType)>;
+    virtual ValueSnapshot getValueSnapshot(const std::vector<ColumnType>& colTypes) const;
+
     //label area:
     virtual std::wstring getColumnLabel(ColumnType colType) const = 0;
     virtual void renderColumnLabel(wxDC& dc, const wxRect& rect, ColumnType colType, bool enabled, bool highlighted); //default implementation
@@ -123,6 +129,13 @@ public:
 
     static void drawCellText(wxDC& dc, const wxRect& rect, const std::wstring_view text,
                              int alignment = wxALIGN_LEFT | wxALIGN_CENTER_VERTICAL, const wxSize* textExtentHint = nullptr);
+
+    struct TextTruncated
+    {
+        std::wstring text; //ends with ellipsis if truncated
+        wxSize extent;
+    };
+    static TextTruncated truncateText(const wxReadOnlyDC& dc, const std::wstring_view text, int maxWidth, const wxSize* textExtentHint = nullptr); //truncate large texts and add ellipsis
     static wxRect drawCellBorder(wxDC& dc, const wxRect& rect); //returns inner rectangle
 
     static wxRect drawColumnLabelBackground(wxDC& dc, const wxRect& rect, bool highlighted); //returns inner rectangle
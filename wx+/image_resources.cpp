@@ -5,10 +5,14 @@
 // *****************************************************************************
 
 #include "image_resources.h"
+#include <unordered_set>
+#include <unistd.h> //lseek
 #include <zen/utf.h>
 #include <zen/thread.h>
 #include <zen/file_io.h>
 #include <zen/file_traverser.h>
+#include <zen/serialize.h>
+#include <zen/extra_log.h>
 #include <wx/zipstrm.h>
 #include <wx/mstream.h>
 #include <xBRZ/src/xbrz.h>
@@ -68,73 +72,232 @@ ImageHolder xbrzScale(int width, int height, const unsigned char* imageRgb, cons
 }
 
 
-auto createScalerTask(const std::string& imageName, const wxImage& img, int hqScale, Protected<std::vector<std::pair<std::string, ImageHolder>>>& protResult)
+//cache xBRZ-scaled images across application runs: startup should not pay for scaling each time
+//- file format: header, offset table, image data => load the table at startup, and the images only on first use
+class ScaledImageCache
 {
-    assert(runningOnMainThread());
-    return [imageName,
-            width  = img.GetWidth(),  //
-            height = img.GetHeight(), //don't call these wxWidgets functions from worker thread
-            rgb    = img.GetData(),   //
-            alpha  = img.GetAlpha(),  //
-            hqScale, &protResult]
+public:
+    ScaledImageCache(const Zstring& filePath, int hqScale) : filePath_(filePath), hqScale_(hqScale)
     {
-        ImageHolder ih = xbrzScale(width, height, rgb, alpha, hqScale);
-        protResult.access([&](std::vector<std::pair<std::string, ImageHolder>>& result) { result.emplace_back(imageName, std::move(ih)); });
-    };
-}
+        if (filePath_.empty())
+            return;
+        try
+        {
+            fileIn_.emplace(filePath_); //throw FileError, ErrorFileLocked
+            //keep open: even if the file is replaced in the meantime, the offset table still matches our data
+
+            const uint64_t fileSize = fileIn_->getStatBuffered().st_size; //throw FileError
+            if (fileSize < HEADER_SIZE || fileSize > CACHE_FILE_SIZE_MAX)
+                return; //don't load garbage at startup => recreate
+
+            const std::string header = readRange(0, HEADER_SIZE); //throw FileError, SysErrorUnexpectedEos
+            MemoryStreamIn streamIn(header);
+            //-------- file format header --------
+            char tmp[sizeof(CACHE_FILE_DESCR)] = {};
+            readArray(streamIn, &tmp, sizeof(tmp)); //throw SysErrorUnexpectedEos
+
+            if (!std::equal(std::begin(tmp), std::end(tmp), std::begin(CACHE_FILE_DESCR)) ||
+                readNumber<int32_t>(streamIn) != CACHE_FILE_VERSION || //throw SysErrorUnexpectedEos
+                readNumber<int32_t>(streamIn) != xbrz::VERSION      || //
+                readNumber<int32_t>(streamIn) != hqScale_)             //
+                return; //outdated => recreate
+
+            const size_t imageCount = readNumber<uint32_t>(streamIn); //throw SysErrorUnexpectedEos
+            if (imageCount > (fileSize - HEADER_SIZE) / TABLE_ENTRY_SIZE)
+                throw SysErrorUnexpectedEos();
+
+            //-------- offset table --------
+            const std::string table = readRange(HEADER_SIZE, imageCount * TABLE_ENTRY_SIZE); //throw FileError, SysErrorUnexpectedEos
+            MemoryStreamIn streamInTable(table);
+
+            const uint64_t dataBegin = HEADER_SIZE + imageCount * TABLE_ENTRY_SIZE;
+            for (size_t i = 0; i < imageCount; ++i)
+            {
+                const uint64_t streamHash = readNumber<uint64_t>(streamInTable); //throw SysErrorUnexpectedEos
+                CachedImage ci;
+                ci.offset = readNumber<uint64_t>(streamInTable); //
+                ci.width  = readNumber<int32_t> (streamInTable); //
+                ci.height = readNumber<int32_t> (streamInTable); //
+
+                //check bounds before reading on demand: avoid int overflow and huge allocation for corrupted data
+                if (ci.width <= 0 || ci.height <= 0 ||
+                    ci.offset < dataBegin || ci.offset > fileSize ||
+                    static_cast<uint64_t>(ci.width) * static_cast<uint64_t>(ci.height) * 4 > fileSize - ci.offset)
+                    throw SysErrorUnexpectedEos();
+
+                cachedImages_.emplace(streamHash, ci);
+            }
+        }
+        catch (FileError&) {} //not existing, or whatever: just a cache
+        catch (SysError&) { cachedImages_.clear(); } //corrupted
 
+        if (cachedImages_.empty())
+            fileIn_.reset();
+    }
 
-class HqParallelScaler
-{
-public:
-    explicit HqParallelScaler(int hqScale) : hqScale_(hqScale) { assert(hqScale > 1); }
+    //return empty if not cached
+    ImageHolder get(uint64_t streamHash)
+    {
+        if (auto it = newImages_.find(streamHash);
+            it != newImages_.end())
+            return toImageHolder(it->second);
 
-    ~HqParallelScaler() { threadGroup_ = {}; } //imgKeeper_ must out-live threadGroup!!!
+        if (auto it = cachedImages_.find(streamHash);
+            it != cachedImages_.end())
+            try
+            {
+                return toImageHolder(readImage(it->second)); //throw FileError, SysErrorUnexpectedEos
+            }
+            catch (FileError&) { cachedImages_.erase(it); }
+            catch (SysError&) { assert(false); cachedImages_.erase(it); }
 
-    void add(const std::string& imageName, const wxImage& img)
-    {
-        assert(runningOnMainThread());
-        imgKeeper_.push_back(img); //retain (ref-counted) wxImage so that the rgb/alpha pointers remain valid after passed to threads
-        threadGroup_->run(createScalerTask(imageName, img, hqScale_, protResult_));
+        return {};
     }
 
-    std::unordered_map<std::string, wxImage> waitAndGetResult()
+    void set(uint64_t streamHash, ImageHolder& ih)
     {
-        assert(runningOnMainThread());
-        threadGroup_->wait();
+        if (filePath_.empty())
+            return;
+
+        const size_t pixelCount = static_cast<size_t>(ih.getWidth()) * ih.getHeight();
+
+        ImageData img{ih.getWidth(), ih.getHeight(), std::string(pixelCount * 4, '\0')};
+        std::copy(ih.getRgb  (), ih.getRgb  () + pixelCount * 3, img.rgbAlpha.begin());
+        std::copy(ih.getAlpha(), ih.getAlpha() + pixelCount,     img.rgbAlpha.begin() + pixelCount * 3);
 
-        std::unordered_map<std::string, wxImage> output;
+        newImages_.insert_or_assign(streamHash, std::move(img));
+        modified_ = true;
+    }
 
-        protResult_.access([&](std::vector<std::pair<std::string, ImageHolder>>& result)
+    //remove images no longer found in resources
+    void save(const std::unordered_set<uint64_t>& streamHashes) //throw FileError
+    {
+        if (filePath_.empty() || !modified_)
+            return;
+
+        std::vector<std::pair<uint64_t /*PNG stream hash*/, ImageData>> images;
+
+        for (const auto& [streamHash, img] : newImages_)
+            if (streamHashes.contains(streamHash))
+                images.emplace_back(streamHash, img);
+
+        for (const auto& [streamHash, ci] : cachedImages_)
+            if (streamHashes.contains(streamHash) && !newImages_.contains(streamHash))
+                try
+                {
+                    images.emplace_back(streamHash, readImage(ci)); //throw FileError, SysErrorUnexpectedEos
+                }
+                catch (FileError&) {} //just a cache
+                catch (SysError&) {} //
+
+        MemoryStreamOut streamOut;
+        writeArray(streamOut, CACHE_FILE_DESCR, sizeof(CACHE_FILE_DESCR));
+        writeNumber<int32_t>(streamOut, CACHE_FILE_VERSION);
+        writeNumber<int32_t>(streamOut, xbrz::VERSION);
+        writeNumber<int32_t>(streamOut, hqScale_);
+        writeNumber(streamOut, static_cast<uint32_t>(images.size()));
+        assert(streamOut.ref().size() == HEADER_SIZE);
+
+        uint64_t offset = HEADER_SIZE + images.size() * TABLE_ENTRY_SIZE;
+        for (const auto& [streamHash, img] : images)
         {
-            for (auto& [imageName, ih] : result)
-            {
-                wxImage img(ih.getWidth(), ih.getHeight(), ih.releaseRgb(), false /*static_data*/); //pass ownership
-                img.SetAlpha(ih.releaseAlpha(), false /*static_data*/);
+            writeNumber<uint64_t>(streamOut, streamHash);
+            writeNumber<uint64_t>(streamOut, offset);
+            writeNumber<int32_t> (streamOut, img.width);
+            writeNumber<int32_t> (streamOut, img.height);
+            offset += img.rgbAlpha.size();
+        }
 
-                output.emplace(imageName, std::move(img));
-            }
-        });
-        return output;
+        for (const auto& [streamHash, img] : images)
+            writeArray(streamOut, img.rgbAlpha.data(), img.rgbAlpha.size());
+        assert(streamOut.ref().size() == offset);
+
+        setFileContent(filePath_, streamOut.ref(), nullptr /*notifyUnbufferedIO*/); //throw FileError
+        modified_ = false;
     }
 
 private:
-    const int hqScale_;
-    std::vector<wxImage> imgKeeper_;
-    Protected<std::vector<std::pair<std::string, ImageHolder>>> protResult_;
+    ScaledImageCache           (const ScaledImageCache&) = delete;
+    ScaledImageCache& operator=(const ScaledImageCache&) = delete;
+
+    struct CachedImage
+    {
+        uint64_t offset = 0;
+        int width  = 0;
+        int height = 0;
+    };
+
+    struct ImageData
+    {
+        int width  = 0;
+        int height = 0;
+        std::string rgbAlpha; //RGB followed by alpha
+    };
+
+    static ImageHolder toImageHolder(const ImageData& img)
+    {
+        const size_t pixelCount = static_cast<size_t>(img.width) * img.height;
+        assert(img.rgbAlpha.size() == pixelCount * 4);
+
+        ImageHolder ih(img.width, img.height, true /*withAlpha*/);
+        std::copy(img.rgbAlpha.begin(),                  img.rgbAlpha.begin() + pixelCount * 3, ih.getRgb  ());
+        std::copy(img.rgbAlpha.begin() + pixelCount * 3, img.rgbAlpha.end(),                    ih.getAlpha());
+        return ih;
+    }
+
+    ImageData readImage(const CachedImage& ci) //throw FileError, SysErrorUnexpectedEos
+    {
+        return {ci.width, ci.height, readRange(ci.offset, static_cast<size_t>(ci.width) * ci.height * 4)}; //bounds checked during construction
+    }
+
+    std::string readRange(uint64_t offset, size_t bytesToRead) //throw FileError, SysErrorUnexpectedEos
+    {
+        assert(fileIn_);
+        if (::lseek(fileIn_->getHandle(), offset, SEEK_SET) != static_cast<off_t>(offset))
+            THROW_LAST_FILE_ERROR(replaceCpy(_("Cannot read file %x."), L"%x", fmtPath(filePath_)), "lseek");
+
+        std::string buf(bytesToRead, '\0');
+        for (size_t bytesRead = 0; bytesRead < bytesToRead;)
+            if (const size_t bytesReadTmp = fileIn_->tryRead(buf.data() + bytesRead, bytesToRead - bytesRead); //throw FileError, ErrorFileLocked
+                bytesReadTmp > 0)
+                bytesRead += bytesReadTmp;
+            else
+                throw SysErrorUnexpectedEos();
+        return buf;
+    }
+
+    static constexpr char CACHE_FILE_DESCR[] = "zen::ScaledImageCache";
+    static const int32_t CACHE_FILE_VERSION = 2; //2: offset table + xBRZ version
+    static const uint64_t CACHE_FILE_SIZE_MAX = 256 * 1024 * 1024; //way more than all scaled images in Icons.zip
 
-    using TaskType = FunctionReturnTypeT<decltype(&createScalerTask)>;
-    std::optional<ThreadGroup<TaskType>> threadGroup_{ThreadGroup<TaskType>(std::max<int>(std::thread::hardware_concurrency(), 1), Zstr("xBRZ Scaler"))};
-    //hardware_concurrency() == 0 if "not computable or well defined"
+    static constexpr uint64_t HEADER_SIZE      = sizeof(CACHE_FILE_DESCR) + 4 * sizeof(int32_t); //version, xBRZ version, scale, image count
+    static constexpr uint64_t TABLE_ENTRY_SIZE = 2 * sizeof(uint64_t) + 2 * sizeof(int32_t);     //stream hash, offset, width, height
+
+    const Zstring filePath_;
+    const int hqScale_;
+    std::optional<FileInputPlain> fileIn_;
+    std::unordered_map<uint64_t /*PNG stream hash*/, CachedImage> cachedImages_; //found in cache file: read on demand
+    std::unordered_map<uint64_t /*PNG stream hash*/, ImageData> newImages_;      //scaled during this run: written by save()
+    bool modified_ = false;
 };
 
+
+uint64_t getStreamHash(const std::string& stream)
+{
+    FNV1aHash<uint64_t> hash;
+    for (const char c : stream)
+        hash.add(static_cast<unsigned char>(c));
+    return hash.get();
+}
+
 //================================================================================================
 //================================================================================================
 
 class ImageBuffer
 {
 public:
-    explicit ImageBuffer(const Zstring& filePath); //throw FileError
+    ImageBuffer(const Zstring& filePath, const Zstring& cacheFilePath); //throw FileError
+    ~ImageBuffer();
 
     const wxImage& getImage(const std::string& name, int maxWidth /*optional*/, int maxHeight /*optional*/);
 
@@ -145,10 +308,12 @@ private:
     const wxImage& getRawImage   (const std::string& name);
     const wxImage& getHqScaledImage(const std::string& name);
 
+    std::unordered_map<std::string, std::string> imageStreams_; //PNG byte streams: decode on first use only
     std::unordered_map<std::string, wxImage> imagesRaw_;
     std::unordered_map<std::string, wxImage> imagesScaled_;
 
-    std::optional<HqParallelScaler> hqScaler_;
+    const int hqScale_;
+    std::optional<ScaledImageCache> scaledCache_; //only needed for hqScale_ > 1
 
     using OutImageKey = std::tuple<std::string /*name*/, int /*height*/>;
 
@@ -171,7 +336,10 @@ private:
 };
 
 
-ImageBuffer::ImageBuffer(const Zstring& zipPath) //throw FileError
+ImageBuffer::ImageBuffer(const Zstring& zipPath, const Zstring& cacheFilePath) : //throw FileError
+    //do we need xBRZ scaling for high quality DPI images?
+    hqScale_(std::clamp(static_cast<int>(std::ceil(getScreenDpiScale())), 1, xbrz::SCALE_FACTOR_MAX))
+    //even for 125% DPI scaling, "2xBRZ + bilinear downscale" gives a better result than mere "125% bilinear upscale"!
 {
     std::vector<std::pair<Zstring /*file name*/, std::string /*byte stream*/>> streams;
 
@@ -209,37 +377,29 @@ ImageBuffer::ImageBuffer(const Zstring& zipPath) //throw FileError
 
     wxImage::AddHandler(new wxPNGHandler/*ownership passed*/); //activate support for .png files
 
-    //do we need xBRZ scaling for high quality DPI images?
-    const int hqScale = std::clamp(static_cast<int>(std::ceil(getScreenDpiScale())), 1, xbrz::SCALE_FACTOR_MAX);
-    //even for 125% DPI scaling, "2xBRZ + bilinear downscale" gives a better result than mere "125% bilinear upscale"!
-    if (hqScale > 1)
-        hqScaler_.emplace(hqScale);
+    if (hqScale_ > 1)
+        scaledCache_.emplace(cacheFilePath, hqScale_);
 
-    for (const auto& [fileName, stream] : streams)
+    for (auto& [fileName, stream] : streams)
         if (endsWith(fileName, Zstr(".png")))
-        {
-            wxMemoryInputStream wxstream(stream.c_str(), stream.size()); //stream does not take ownership of data
-
-            wxImage img(wxstream, wxBITMAP_TYPE_PNG);
-            assert(img.IsOk());
-
-            //end this alpha/no-alpha/mask/wxDC::DrawBitmap/RTL/high-contrast-scheme interoperability nightmare here and now!!!!
-            //=> there's only one type of wxImage: with alpha channel, no mask!!!
-            convertToVanillaImage(img);
+            imageStreams_.emplace(utfTo<std::string>(beforeLast(fileName, Zstr("."), IfNotFoundReturn::none)), std::move(stream));
+        else
+            assert(false);
+}
 
-            const std::string imageName = utfTo<std::string>(beforeLast(fileName, Zstr("."), IfNotFoundReturn::none));
 
-            imagesRaw_.emplace(imageName, img);
-            if (hqScaler_)
-                hqScaler_->add(imageName, img); //scale in parallel!
-            else
-                imagesScaled_.emplace(imageName, img);
+ImageBuffer::~ImageBuffer()
+{
+    if (scaledCache_)
+        try
+        {
+            std::unordered_set<uint64_t> streamHashes;
+            for (const auto& [imageName, stream] : imageStreams_)
+                streamHashes.insert(getStreamHash(stream));
 
-            //wxBitmap::NewFromPNGData(stream.c_str(), stream.size())?
-            //  => Windows: just a (slow!) wrapper for wxBitmap(wxImage())!
+            scaledCache_->save(streamHashes); //throw FileError
         }
-        else
-            assert(false);
+        catch (const FileError& e) { logExtraError(e.toString()); } //not critical in this context
 }
 
 
@@ -249,6 +409,24 @@ const wxImage& ImageBuffer::getRawImage(const std::string& name)
         it != imagesRaw_.end())
         return it->second;
 
+    if (auto it = imageStreams_.find(name);
+        it != imageStreams_.end())
+    {
+        const std::string& stream = it->second;
+        wxMemoryInputStream wxstream(stream.c_str(), stream.size()); //stream does not take ownership of data
+
+        wxImage img(wxstream, wxBITMAP_TYPE_PNG);
+        assert(img.IsOk());
+
+        //end this alpha/no-alpha/mask/wxDC::DrawBitmap/RTL/high-contrast-scheme interoperability nightmare here and now!!!!
+        //=> there's only one type of wxImage: with alpha channel, no mask!!!
+        convertToVanillaImage(img);
+
+        //wxBitmap::NewFromPNGData(stream.c_str(), stream.size())?
+        //  => Windows: just a (slow!) wrapper for wxBitmap(wxImage())!
+        return imagesRaw_.emplace(name, std::move(img)).first->second;
+    }
+
     assert(false);
     return wxNullImage;
 }
@@ -256,21 +434,28 @@ const wxImage& ImageBuffer::getRawImage(const std::string& name)
 
 const wxImage& ImageBuffer::getHqScaledImage(const std::string& name)
 {
-    //test: this function is first called about 220ms after ImageBuffer::ImageBuffer() has ended
-    //      => should be enough time to finish xBRZ scaling in parallel (which takes 50ms)
-    //debug perf: extra 800-1000ms during startup
-    if (hqScaler_)
-    {
-        imagesScaled_ = hqScaler_->waitAndGetResult();
-        hqScaler_.reset();
-    }
-
     if (auto it = imagesScaled_.find(name);
         it != imagesScaled_.end())
         return it->second;
 
-    assert(false);
-    return wxNullImage;
+    const wxImage& rawImg = getRawImage(name);
+    if (!scaledCache_ || !rawImg.IsOk())
+        return rawImg;
+
+    //xBRZ-scale on first use only; less than 1ms per image, but don't pay for all images during each startup
+    const uint64_t streamHash = getStreamHash(imageStreams_.find(name)->second); //getRawImage() succeeded => stream exists
+
+    ImageHolder ih = scaledCache_->get(streamHash);
+    if (!ih)
+    {
+        ih = xbrzScale(rawImg.GetWidth(), rawImg.GetHeight(), rawImg.GetData(), rawImg.GetAlpha(), hqScale_);
+        scaledCache_->set(streamHash, ih);
+    }
+
+    wxImage img(ih.getWidth(), ih.getHeight(), ih.releaseRgb(), false /*static_data*/); //pass ownership
+    img.SetAlpha(ih.releaseAlpha(), false /*static_data*/);
+
+    return imagesScaled_.emplace(name, std::move(img)).first->second;
 }
 
 
@@ -308,11 +493,11 @@ std::optional<ImageBuffer> globalImageBuffer;
 }
 
 
-void zen::imageResourcesInit(const Zstring& zipPath) //throw FileError
+void zen::imageResourcesInit(const Zstring& zipPath, const Zstring& cacheFilePath) //throw FileError
 {
     assert(runningOnMainThread()); //wxWidgets is not thread-safe!
     assert(!globalImageBuffer);
-    globalImageBuffer.emplace(zipPath); //throw FileError
+    globalImageBuffer.emplace(zipPath, cacheFilePath); //throw FileError
 }
 
 
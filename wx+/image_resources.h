@@ -14,7 +14,8 @@
 namespace zen
 {
 //pass resources .zip file at application startup
-void imageResourcesInit(const Zstring& zipPath); //throw FileError
+//images are decoded on first use; xBRZ-scaled images (high DPI) are stored in "cacheFilePath" (optional) for later runs
+void imageResourcesInit(const Zstring& zipPath, const Zstring& cacheFilePath); //throw FileError
 void imageResourcesCleanup();
 
 const wxImage& loadImage(const std::string& name, int maxWidth /*optional*/, int maxHeight /*optional*/);
@@ -22,6 +22,11 @@
 #include <vector>
 #include "xbrz_tools.h"
 
+#if defined __GNUC__ && defined __SSE2__ //x86/x86-64
+    #define XBRZ_SIMD_X86
+    #include <immintrin.h>
+#endif
+
 using namespace xbrz;
 
 
@@ -84,8 +89,10 @@ uint32_t gradientARGB(uint32_t pixFront, uint32_t pixBack)
 
 #if   defined __GNUC__
     #define FORCE_INLINE __attribute__((always_inline)) inline
+    #define TARGET_AVX __attribute__((target("avx")))
 #else
     #define FORCE_INLINE inline
+    #define TARGET_AVX
 #endif
 
 
@@ -156,6 +163,16 @@ double distRGB(uint32_t pix1, uint32_t pix2)
 #endif
 
 
+//constexpr double k_b = 0.0722; //ITU-R BT.709 conversion
+//constexpr double k_r = 0.2126; //
+constexpr double k_b = 0.0593; //ITU-R BT.2020 conversion
+constexpr double k_r = 0.2627; //
+constexpr double k_g = 1 - k_b - k_r;
+
+constexpr double scale_b = 0.5 / (1 - k_b);
+constexpr double scale_r = 0.5 / (1 - k_r);
+
+
 inline
 double distYCbCr(uint32_t pix1, uint32_t pix2, double /*testAttribute*/)
 {
@@ -166,15 +183,6 @@ double distYCbCr(uint32_t pix1, uint32_t pix2, double /*testAttribute*/)
     const int g_diff = static_cast<int>(getGreen(pix1)) - getGreen(pix2); //
     const int b_diff = static_cast<int>(getBlue (pix1)) - getBlue (pix2); //substraction for int is noticeable faster than for double!
 
-    //const double k_b = 0.0722; //ITU-R BT.709 conversion
-    //const double k_r = 0.2126; //
-    const double k_b = 0.0593; //ITU-R BT.2020 conversion
-    const double k_r = 0.2627; //
-    const double k_g = 1 - k_b - k_r;
-
-    const double scale_b = 0.5 / (1 - k_b);
-    const double scale_r = 0.5 / (1 - k_r);
-
     const double y   = k_r * r_diff + k_g * g_diff + k_b * b_diff; //[!], analog YCbCr!
     const double c_b = scale_b * (b_diff - y);
     const double c_r = scale_r * (r_diff - y);
@@ -199,13 +207,6 @@ double distYCbCrBuffered(uint32_t pix1, uint32_t pix2, double /*testAttribute*/)
             const int g_diff = static_cast<signed char>(getByte<1>(i)) * 2;
             const int b_diff = static_cast<signed char>(getByte<0>(i)) * 2;
 
-            const double k_b = 0.0593; //ITU-R BT.2020 conversion
-            const double k_r = 0.2627; //
-            const double k_g = 1 - k_b - k_r;
-
-            const double scale_b = 0.5 / (1 - k_b);
-            const double scale_r = 0.5 / (1 - k_r);
-
             const double y   = k_r * r_diff + k_g * g_diff + k_b * b_diff; //[!], analog YCbCr!
             const double c_b = scale_b * (b_diff - y);
             const double c_r = scale_r * (r_diff - y);
@@ -289,10 +290,14 @@ BlendResult preProcessCorners(const Kernel_4x4& ker, const xbrz::ScalerCfg& cfg)
          ker.f == ker.i))
         return {};
 
-    auto dist = [&](uint32_t pix1, uint32_t pix2) { return ColorDistance::dist(pix1, pix2, cfg.testAttribute); };
+    //calculate all distances in one go => SIMD
+    const uint32_t pix1[] = { ker.g, ker.e, ker.k, ker.i, ker.h, /**/ ker.d, ker.h, ker.b, ker.f, ker.e };
+    const uint32_t pix2[] = { ker.e, ker.c, ker.i, ker.o, ker.f, /**/ ker.h, ker.l, ker.f, ker.n, ker.i };
+    double d[10];
+    ColorDistance::distBatch(pix1, pix2, d, 10, cfg.testAttribute);
 
-    const double hf = dist(ker.g, ker.e) + dist(ker.e, ker.c) + dist(ker.k, ker.i) + dist(ker.i, ker.o) + cfg.centerDirectionBias * dist(ker.h, ker.f);
-    const double ei = dist(ker.d, ker.h) + dist(ker.h, ker.l) + dist(ker.b, ker.f) + dist(ker.f, ker.n) + cfg.centerDirectionBias * dist(ker.e, ker.i);
+    const double hf = d[0] + d[1] + d[2] + d[3] + cfg.centerDirectionBias * d[4];
+    const double ei = d[5] + d[6] + d[7] + d[8] + cfg.centerDirectionBias * d[9];
 
     BlendResult result = {};
     if (hf < ei) //test sample: 70% of values max(hf, ei) / min(hf, ei) are between 1.1 and 3.7 with median being 1.8
@@ -1076,6 +1081,14 @@ struct Scaler6x : public ColorGradient
 
 //------------------------------------------------------------------------------------
 
+template <class ColorDistance> inline
+void distBatchScalar(const uint32_t* pix1, const uint32_t* pix2, double* dist, size_t count, double testAttribute)
+{
+    for (size_t i = 0; i < count; ++i)
+        dist[i] = ColorDistance::dist(pix1[i], pix2[i], testAttribute);
+}
+
+
 struct ColorDistanceRGB
 {
     static double dist(uint32_t pix1, uint32_t pix2, double testAttribute)
@@ -1086,6 +1099,11 @@ struct ColorDistanceRGB
         //    return 0;
         //return distYCbCr(pix1, pix2, luminanceWeight);
     }
+
+    static void distBatch(const uint32_t* pix1, const uint32_t* pix2, double* dist, size_t count, double testAttribute)
+    {
+        distBatchScalar<ColorDistanceRGB>(pix1, pix2, dist, count, testAttribute); //buffered: table lookups do not vectorize
+    }
 };
 
 struct ColorDistanceARGB
@@ -1112,6 +1130,11 @@ struct ColorDistanceARGB
         else
             return a2 * d + 255 * (a1 - a2);
     }
+
+    static void distBatch(const uint32_t* pix1, const uint32_t* pix2, double* dist, size_t count, double testAttribute)
+    {
+        distBatchScalar<ColorDistanceARGB>(pix1, pix2, dist, count, testAttribute);
+    }
 };
 
 
@@ -1128,9 +1151,117 @@ struct ColorDistanceUnbufferedARGB
         else
             return a2 * d + 255 * (a1 - a2);
     }
+
+    static void distBatch(const uint32_t* pix1, const uint32_t* pix2, double* dist, size_t count, double testAttribute);
 };
 
 
+#ifdef XBRZ_SIMD_X86
+/*  vectorized ColorDistanceUnbufferedARGB::dist():
+    bit-exact with the scalar version since IEEE 754 +, -, *, / and sqrt are correctly rounded for each SIMD lane, too
+    => evaluation order must match the scalar code exactly! (and no FMA!)                                               */
+template <int shift> inline
+__m128i getChannel(__m128i pix) { return _mm_and_si128(_mm_srli_epi32(pix, shift), _mm_set1_epi32(0xff)); }
+
+
+inline
+void distUnbufferedARGBx2(const uint32_t* pix1, const uint32_t* pix2, double* dist) //SSE2: 2 pixel pairs
+{
+    const __m128i p1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pix1));
+    const __m128i p2 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pix2));
+
+    const __m128d r_diff = _mm_cvtepi32_pd(_mm_sub_epi32(getChannel<16>(p1), getChannel<16>(p2)));
+    const __m128d g_diff = _mm_cvtepi32_pd(_mm_sub_epi32(getChannel< 8>(p1), getChannel< 8>(p2)));
+    const __m128d b_diff = _mm_cvtepi32_pd(_mm_sub_epi32(getChannel< 0>(p1), getChannel< 0>(p2)));
+
+    const __m128d y = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(k_r), r_diff),
+                                            _mm_mul_pd(_mm_set1_pd(k_g), g_diff)),
+                                 _mm_mul_pd(_mm_set1_pd(k_b), b_diff));
+    const __m128d c_b = _mm_mul_pd(_mm_set1_pd(scale_b), _mm_sub_pd(b_diff, y));
+    const __m128d c_r = _mm_mul_pd(_mm_set1_pd(scale_r), _mm_sub_pd(r_diff, y));
+
+    const __m128d d = _mm_sqrt_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(y, y), _mm_mul_pd(c_b, c_b)), _mm_mul_pd(c_r, c_r)));
+
+    const __m128d a1 = _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_epi32(p1, 24)), _mm_set1_pd(255.0));
+    const __m128d a2 = _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_epi32(p2, 24)), _mm_set1_pd(255.0));
+    const __m128d aMin = _mm_min_pd(a1, a2);
+    const __m128d aMax = _mm_max_pd(a1, a2);
+
+    _mm_storeu_pd(dist, _mm_add_pd(_mm_mul_pd(aMin, d), _mm_mul_pd(_mm_set1_pd(255.0), _mm_sub_pd(aMax, aMin))));
+}
+
+
+TARGET_AVX inline
+void distUnbufferedARGBx4(const uint32_t* pix1, const uint32_t* pix2, double* dist) //AVX: 4 pixel pairs
+{
+    const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pix1));
+    const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pix2));
+
+    const __m256d r_diff = _mm256_cvtepi32_pd(_mm_sub_epi32(getChannel<16>(p1), getChannel<16>(p2)));
+    const __m256d g_diff = _mm256_cvtepi32_pd(_mm_sub_epi32(getChannel< 8>(p1), getChannel< 8>(p2)));
+    const __m256d b_diff = _mm256_cvtepi32_pd(_mm_sub_epi32(getChannel< 0>(p1), getChannel< 0>(p2)));
+
+    const __m256d y = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(k_r), r_diff),
+                                                  _mm256_mul_pd(_mm256_set1_pd(k_g), g_diff)),
+                                    _mm256_mul_pd(_mm256_set1_pd(k_b), b_diff));
+    const __m256d c_b = _mm256_mul_pd(_mm256_set1_pd(scale_b), _mm256_sub_pd(b_diff, y));
+    const __m256d c_r = _mm256_mul_pd(_mm256_set1_pd(scale_r), _mm256_sub_pd(r_diff, y));
+
+    const __m256d d = _mm256_sqrt_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(y, y), _mm256_mul_pd(c_b, c_b)), _mm256_mul_pd(c_r, c_r)));
+
+    const __m256d a1 = _mm256_div_pd(_mm256_cvtepi32_pd(_mm_srli_epi32(p1, 24)), _mm256_set1_pd(255.0));
+    const __m256d a2 = _mm256_div_pd(_mm256_cvtepi32_pd(_mm_srli_epi32(p2, 24)), _mm256_set1_pd(255.0));
+    const __m256d aMin = _mm256_min_pd(a1, a2);
+    const __m256d aMax = _mm256_max_pd(a1, a2);
+
+    _mm256_storeu_pd(dist, _mm256_add_pd(_mm256_mul_pd(aMin, d), _mm256_mul_pd(_mm256_set1_pd(255.0), _mm256_sub_pd(aMax, aMin))));
+}
+
+
+void distUnbufferedARGBBatchSse2(const uint32_t* pix1, const uint32_t* pix2, double* dist, size_t count, double testAttribute)
+{
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+        distUnbufferedARGBx2(pix1 + i, pix2 + i, dist + i);
+
+    distBatchScalar<ColorDistanceUnbufferedARGB>(pix1 + i, pix2 + i, dist + i, count - i, testAttribute);
+}
+
+
+TARGET_AVX
+void distUnbufferedARGBBatchAvx(const uint32_t* pix1, const uint32_t* pix2, double* dist, size_t count, double testAttribute)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        distUnbufferedARGBx4(pix1 + i, pix2 + i, dist + i);
+
+    distUnbufferedARGBBatchSse2(pix1 + i, pix2 + i, dist + i, count - i, testAttribute);
+}
+#endif
+
+
+void ColorDistanceUnbufferedARGB::distBatch(const uint32_t* pix1, const uint32_t* pix2, double* dist, size_t count, double testAttribute)
+{
+#ifdef XBRZ_SIMD_X86
+    using DistBatchFun = void (*)(const uint32_t* pix1, const uint32_t* pix2, double* dist, size_t count, double testAttribute);
+
+    static const DistBatchFun distBatchSimd = [] //select once at runtime
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx") ? &distUnbufferedARGBBatchAvx : &distUnbufferedARGBBatchSse2;
+    }();
+    distBatchSimd(pix1, pix2, dist, count, testAttribute);
+
+#ifndef NDEBUG
+    for (size_t i = 0; i < count; ++i)
+        assert(dist[i] == ColorDistanceUnbufferedARGB::dist(pix1[i], pix2[i], testAttribute)); //SIMD must be bit-exact!
+#endif
+#else
+    distBatchScalar<ColorDistanceUnbufferedARGB>(pix1, pix2, dist, count, testAttribute);
+#endif
+}
+
+
 struct ColorGradientRGB
 {
     template <unsigned int M, unsigned int N>
@@ -46,6 +46,7 @@ enum class ColorFormat //from high bits -> low bits, 8 bit per channel
 };
 
 const int SCALE_FACTOR_MAX = 6;
+const int VERSION = 1; //increment whenever scaling results change: invalidates images cached by clients
 
 /*
 -> map source (srcWidth * srcHeight) to target (scale * width x scale * height) image, optionally processing a half-open slice of rows [yFirst, yLast) only
@@ -0,0 +1,273 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#include "error_log.h"
+#include "file_access.h"
+#include "serialize.h"
+#include "scope_guard.h"
+    #include <fcntl.h>  //open
+    #include <unistd.h> //close, pread, pwrite
+
+using namespace zen;
+
+
+namespace
+{
+const size_t LOG_ITEMS_RECENT_MAX = LOG_ITEMS_IN_MEMORY_MAX / 4; //most recent items to keep in memory after spooling
+static_assert(LOG_FAILS_IN_MEMORY_MAX + LOG_ITEMS_RECENT_MAX < LOG_ITEMS_IN_MEMORY_MAX); //=> amortized constant time for ErrorLog::add()
+
+const size_t SPOOL_BLOCK_SIZE = 128 * 1024;
+}
+
+
+class zen::LogSpool
+{
+public:
+    LogSpool() //throw SysError
+    {
+        const Zstring tempFolderPath = []
+        {
+            try { return getTempFolderPath(); /*throw FileError*/ }
+            catch (const FileError& e) { throw SysError(replaceCpy(e.toString(), L"\n\n", L'\n')); }
+        }();
+
+        //unnamed temporary file: no clean-up needed, not even after a crash
+        fileHandle_ = ::open(tempFolderPath.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if (fileHandle_ == -1)
+            THROW_LAST_SYS_ERROR("open(O_TMPFILE)");
+    }
+
+    ~LogSpool() { ::close(fileHandle_); }
+
+    uint64_t size() const { return bytesWritten_ + buf_.ref().size(); }
+
+    void write(const LogEntry& entry) //throw SysError
+    {
+        writeNumber<int64_t>(buf_, entry.time);
+        writeNumber<int32_t>(buf_, entry.type);
+        writeContainer(buf_, entry.message);
+
+        if (buf_.ref().size() >= SPOOL_BLOCK_SIZE)
+            flush(); //throw SysError
+    }
+
+    void truncate(uint64_t size) //nothrow; discard data of failed write
+    {
+        assert(size <= bytesWritten_ + buf_.ref().size());
+        if (size >= bytesWritten_)
+            buf_.ref().resize(size - bytesWritten_);
+        else
+        {
+            buf_.ref().clear();
+            bytesWritten_ = size; //=> subsequent pwrite() overwrites stale data
+        }
+    }
+
+    void copyFrom(LogSpool& src, uint64_t bytesToCopy) //throw SysError
+    {
+        src.flush(); //throw SysError
+        assert(size() == 0 && bytesToCopy <= src.bytesWritten_);
+
+        std::vector<std::byte> buffer(SPOOL_BLOCK_SIZE);
+        for (uint64_t pos = 0; pos < bytesToCopy;)
+        {
+            const size_t bytesRead = src.tryRead(pos, buffer.data(), static_cast<size_t>(std::min<uint64_t>(bytesToCopy - pos, buffer.size()))); //throw SysError
+            if (bytesRead == 0)
+                throw SysErrorUnexpectedEos();
+
+            writeAt(bytesWritten_, buffer.data(), bytesRead); //throw SysError
+            bytesWritten_ += bytesRead;
+            pos += bytesRead;
+        }
+    }
+
+    void read(size_t itemCount, const std::function<void(const LogEntry& entry)>& onItem /*throw X*/) //throw SysError, X
+    {
+        flush(); //throw SysError
+
+        uint64_t readPos = 0;
+        BufferedInputStream streamIn([&](void* buffer, size_t bytesToRead)
+        {
+            const size_t bytesRead = tryRead(readPos, buffer, bytesToRead); //throw SysError
+            readPos += bytesRead;
+            return bytesRead;
+        }, SPOOL_BLOCK_SIZE);
+
+        for (size_t i = 0; i < itemCount; ++i)
+        {
+            LogEntry entry;
+            entry.time    = static_cast<time_t>(readNumber<int64_t>(streamIn)); //
+            entry.type    = static_cast<MessageType>(readNumber<int32_t>(streamIn)); //throw SysErrorUnexpectedEos
+            entry.message = readContainer<Zstringc>(streamIn); //
+            onItem(entry); //throw X
+        }
+    }
+
+private:
+    LogSpool           (const LogSpool&) = delete;
+    LogSpool& operator=(const LogSpool&) = delete;
+
+    void flush() //throw SysError
+    {
+        if (!buf_.ref().empty())
+        {
+            writeAt(bytesWritten_, buf_.ref().data(), buf_.ref().size()); //throw SysError
+            bytesWritten_ += buf_.ref().size();
+            buf_.ref().clear();
+        }
+    }
+
+    void writeAt(uint64_t pos, const void* buffer, size_t bytesToWrite) //throw SysError
+    {
+        while (bytesToWrite > 0)
+        {
+            ssize_t bytesWritten = 0;
+            do
+                bytesWritten = ::pwrite(fileHandle_, buffer, bytesToWrite, pos);
+            while (bytesWritten < 0 && errno == EINTR);
+
+            if (bytesWritten <= 0)
+            {
+                if (bytesWritten == 0) //comment in safe-read.c suggests to treat this as an error due to buggy drivers
+                    errno = ENOSPC;
+
+                THROW_LAST_SYS_ERROR("pwrite");
+            }
+            ASSERT_SYSERROR(makeUnsigned(bytesWritten) <= bytesToWrite); //better safe than sorry
+
+            buffer = static_cast<const std::byte*>(buffer) + bytesWritten;
+            bytesToWrite -= bytesWritten;
+            pos          += bytesWritten;
+        }
+    }
+
+    size_t tryRead(uint64_t pos, void* buffer, size_t bytesToRead) //throw SysError; may return short, only 0 means EOF
+    {
+        const size_t bytesAvailable = pos < bytesWritten_ ? static_cast<size_t>(std::min<uint64_t>(bytesWritten_ - pos, bytesToRead)) : 0;
+        if (bytesAvailable == 0)
+            return 0;
+
+        ssize_t bytesRead = 0;
+        do
+            bytesRead = ::pread(fileHandle_, buffer, bytesAvailable, pos);
+        while (bytesRead < 0 && errno == EINTR);
+
+        if (bytesRead < 0)
+            THROW_LAST_SYS_ERROR("pread");
+        ASSERT_SYSERROR(makeUnsigned(bytesRead) <= bytesAvailable); //better safe than sorry
+        return bytesRead;
+    }
+
+    int fileHandle_ = -1;
+    uint64_t bytesWritten_ = 0;
+    MemoryStreamOut buf_;
+};
+
+
+void ErrorLog::add(LogEntry&& entry) //nothrow
+{
+    switch (entry.type)
+    {
+        case MSG_TYPE_INFO:
+            ++stats_.infos;
+            break;
+        case MSG_TYPE_WARNING:
+            ++stats_.warnings;
+            break;
+        case MSG_TYPE_ERROR:
+            ++stats_.errors;
+            break;
+    }
+    ++itemCount_;
+    items_.push_back(std::move(entry));
+
+    if (items_.size() > compactThreshold_)
+        compact(); //nothrow
+}
+
+
+void ErrorLog::append(const ErrorLog& log) //nothrow
+{
+    assert(&log != this);
+    try
+    {
+        log.visitItems([&](const LogEntry& entry) { add(LogEntry(entry)); }); //throw SysError
+    }
+    catch (const SysError& e) { add({std::time(nullptr), MSG_TYPE_ERROR, utfTo<Zstringc>(e.toString())}); }
+}
+
+
+//spool file is append-only => sorting is limited to in-memory items not yet spooled: fine for the common case of merging
+//a small log (e.g. extra log, shared comparison) before spooling starts; otherwise merged items follow the spooled ones
+void ErrorLog::sortByTime()
+{
+    std::stable_sort(items_.begin() + itemsSpooled_, items_.end(), [](const LogEntry& lhs, const LogEntry& rhs) { return lhs.time < rhs.time; });
+}
+
+
+void ErrorLog::visitItems(const std::function<void(const LogEntry& entry)>& onItem /*throw X*/, size_t itemsMax) const //throw SysError, X
+{
+    if (spool_)
+    {
+        const size_t spoolItemsToRead = std::min(spoolItems_, itemsMax);
+        spool_->read(spoolItemsToRead, onItem); //throw SysError, X
+        itemsMax -= spoolItemsToRead;
+    }
+
+    const size_t memItemsToVisit = std::min(items_.size() - itemsSpooled_, itemsMax);
+    std::for_each(items_.begin() + itemsSpooled_, items_.begin() + itemsSpooled_ + memItemsToVisit, onItem); //throw X
+}
+
+
+void ErrorLog::flushToSpool() //throw SysError
+{
+    if (!spool_)
+        spool_ = std::make_shared<LogSpool>(); //throw SysError
+    else if (spool_.use_count() > 1) //shared with a copy of this log
+    {
+        auto spoolCopy = std::make_shared<LogSpool>(); //throw SysError
+        spoolCopy->copyFrom(*spool_, spoolBytes_); //throw SysError
+        spool_ = std::move(spoolCopy);
+    }
+    assert(spool_->size() == spoolBytes_);
+
+    ZEN_ON_SCOPE_FAIL(spool_->truncate(spoolBytes_));
+
+    std::for_each(items_.begin() + itemsSpooled_, items_.end(), [&](const LogEntry& entry) { spool_->write(entry); }); //throw SysError
+
+    spoolBytes_  = spool_->size();
+    spoolItems_ += items_.size() - itemsSpooled_;
+    itemsSpooled_ = items_.size();
+}
+
+
+void ErrorLog::compact() //nothrow
+{
+    try
+    {
+        flushToSpool(); //throw SysError
+    }
+    catch (SysError&) //e.g. no temp folder access => fall back to keeping everything in memory
+    {
+        compactThreshold_ *= 2; //don't retry on every new item
+        return;
+    }
+    //-------------------------------------------------------------
+    //all items are spooled => reduce in-memory window:
+    std::vector<LogEntry> items;
+    items.reserve(LOG_FAILS_IN_MEMORY_MAX + LOG_ITEMS_RECENT_MAX);
+
+    const auto itRecent = items_.end() - std::min(items_.size(), LOG_ITEMS_RECENT_MAX);
+    size_t failCount = 0;
+    for (auto it = items_.begin(); it != itRecent; ++it)
+        if (it->type != MSG_TYPE_INFO && failCount++ < LOG_FAILS_IN_MEMORY_MAX) //keep the *first* warnings/errors: see log file and email previews
+            items.push_back(std::move(*it));
+
+    std::move(itRecent, items_.end(), std::back_inserter(items));
+
+    items_.swap(items);
+    itemsSpooled_ = items_.size();
+}
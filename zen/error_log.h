@@ -9,6 +9,9 @@
 
 #include <cassert>
 #include <vector>
+#include <memory>
+#include <functional>
+#include <limits>
 #include "time.h"
 #include "i18n.h"
 #include "zstring.h"
@@ -32,20 +35,68 @@ struct LogEntry
 
 std::string formatMessage(const LogEntry& entry);
 
-using ErrorLog = std::vector<LogEntry>;
-
-void logMsg(ErrorLog& log, const std::wstring& msg, MessageType type, time_t time = std::time(nullptr));
-
 struct ErrorLogStats
 {
     int infos    = 0;
     int warnings = 0;
     int errors   = 0;
 };
-ErrorLogStats getStats(const ErrorLog& log);
 
 
+class LogSpool;
+
+const size_t LOG_ITEMS_IN_MEMORY_MAX = 100'000; //~10 MB assuming 100 bytes per message
+const size_t LOG_FAILS_IN_MEMORY_MAX = LOG_ITEMS_IN_MEMORY_MAX / 2;
+
+/*  append-only log: once more than LOG_ITEMS_IN_MEMORY_MAX items are logged, the log is streamed to a
+    temporary spool file and only a bounded window is kept in memory (think millions of info messages!)
+    - begin()/end():  in-memory items only: all warnings/errors up to LOG_FAILS_IN_MEMORY_MAX + the most recent items
+                      => suitable for GUI log panel and previews
+    - visitItems():   *all* items in logging order (or the first "itemsMax") => e.g. saving log file
+    - getStats():     *all* items
+    - sortByTime():   items already spooled keep their logging order! => logs merged via append() after spooling has
+                      started are *not* interleaved by time with the spooled items, but follow them                 */
+class ErrorLog
+{
+public:
+    ErrorLog() {}
+
+    using const_iterator = std::vector<LogEntry>::const_iterator;
+    const_iterator begin() const { return items_.begin(); }
+    const_iterator end  () const { return items_.end  (); }
+
+    bool empty() const { return itemCount_ == 0; }
+    size_t itemCount() const { return itemCount_; } //including items that are not in memory
+    bool allItemsInMemory() const { return !spool_; }
+
+    void add(LogEntry&& entry); //nothrow
+    void append(const ErrorLog& log); //nothrow
+
+    void sortByTime(); //stable sort; only considers items not yet spooled
 
+    void visitItems(const std::function<void(const LogEntry& entry)>& onItem /*throw X*/, //throw SysError, X
+                    size_t itemsMax = std::numeric_limits<size_t>::max()) const; //stop early: don't read the full spool file
+
+    const ErrorLogStats& getStats() const { return stats_; }
+
+private:
+    void compact(); //nothrow
+    void flushToSpool(); //throw SysError
+
+    std::vector<LogEntry> items_; //in logging order
+    size_t itemsSpooled_ = 0; //items_[0, itemsSpooled_) are already contained in spool_
+    size_t itemCount_ = 0;
+    ErrorLogStats stats_;
+
+    std::shared_ptr<LogSpool> spool_; //optional; shared by copies of ErrorLog => copy on write!
+    uint64_t spoolBytes_ = 0; //size of spool data belonging to this log
+    size_t   spoolItems_ = 0; //
+    size_t compactThreshold_ = LOG_ITEMS_IN_MEMORY_MAX; //increased if spooling fails
+};
+
+void logMsg(ErrorLog& log, const std::wstring& msg, MessageType type, time_t time = std::time(nullptr));
+
+ErrorLogStats getStats(const ErrorLog& log);
 
 
 
@@ -54,29 +105,15 @@ ErrorLogStats getStats(const ErrorLog& log);
 inline
 void logMsg(ErrorLog& log, const std::wstring& msg, MessageType type, time_t time)
 {
-    log.push_back({time, type, utfTo<Zstringc>(msg)});
+    log.add({time, type, utfTo<Zstringc>(msg)});
 }
 
 
 inline
 ErrorLogStats getStats(const ErrorLog& log)
 {
-    ErrorLogStats count;
-    for (const LogEntry& entry : log)
-        switch (entry.type)
-        {
-            case MSG_TYPE_INFO:
-                ++count.infos;
-                break;
-            case MSG_TYPE_WARNING:
-                ++count.warnings;
-                break;
-            case MSG_TYPE_ERROR:
-                ++count.errors;
-                break;
-        }
-    assert(std::ssize(log) == count.infos + count.warnings + count.errors);
-    return count;
+    assert(static_cast<int>(log.itemCount()) == log.getStats().infos + log.getStats().warnings + log.getStats().errors);
+    return log.getStats(); //constant time
 }
 
 
@@ -7,6 +7,7 @@
 #ifndef JSON_H_0187348321748321758934215734
 #define JSON_H_0187348321748321758934215734
 
+#include <span>
 #include <zen/string_tools.h>
 
 
@@ -61,6 +62,23 @@ struct JsonParsingError
 JsonValue parseJson(const std::string& stream); //throw JsonParsingError
 
 
+/*  SAX-style parsing: process a stream (e.g. HTTP response) while it is received, without building a JsonValue tree
+    - path: names of enclosing object members, empty string for array elements
+      e.g. {"files": [{"id": "abc"}]} => value "abc" has path: "files", "", "id"
+    - primVal is valid for the duration of the call only!                                                            */
+class JsonStreamCallback
+{
+public:
+    virtual ~JsonStreamCallback() {}
+
+    virtual void onContainerBegin(std::span<const std::string> path, JsonValue::Type type) = 0; //throw X; object or array
+    virtual void onContainerEnd  (std::span<const std::string> path, JsonValue::Type type) = 0; //throw X
+    virtual void onValue(std::span<const std::string> path, JsonValue::Type type, std::string_view primVal) = 0; //throw X; primitive types only
+};
+
+class JsonStreamParser; //same grammar as parseJson(): feed(chunk) ... feed(chunk), finish()
+
+
 
 //helper functions for JsonValue access:
 inline
@@ -127,7 +145,7 @@ namespace
 }
 
 
-[[nodiscard]] std::string jsonUnescape(const std::string& str)
+[[nodiscard]] std::string jsonUnescape(const std::string_view str)
 {
     std::string output;
     std::basic_string<impl::Char16> utf16Buf;
@@ -549,6 +567,273 @@ JsonValue parseJson(const std::string& stream) //throw JsonParsingError
 {
     return json_impl::JsonParser(stream).parse(); //throw JsonParsingError
 }
+
+
+class JsonStreamParser
+{
+public:
+    explicit JsonStreamParser(JsonStreamCallback& cb) : cb_(cb) {}
+
+    void feed(std::span<const char> buf) //throw JsonParsingError, X
+    {
+        const char*       it   = buf.data();
+        const char* const last = it + buf.size();
+        chunkBegin_ = it;
+
+        for (; bomPos_ < BYTE_ORDER_MARK_UTF8.size() && it != last; ++it, ++bomPos_)
+            if (*it != BYTE_ORDER_MARK_UTF8[bomPos_])
+            {
+                if (bomPos_ != 0) //partial BOM
+                    throwParsingError(it);
+                bomPos_ = BYTE_ORDER_MARK_UTF8.size();
+                break;
+            }
+
+        while (it != last)
+            if (partial_ == PartialToken::string)
+                it = scanString(it, last); //throw JsonParsingError, X
+            else if (partial_ == PartialToken::bare)
+                it = scanBare(it, last); //throw JsonParsingError, X
+            else
+                switch (const char c = *it++)
+                {
+                    case '\n':
+                        ++row_;
+                        rowOffset_ = getOffset(it);
+                        break;
+                    case ' ':
+                    case '\t':
+                    case '\r':
+                        break;
+
+                    case '{': containerBegin(JsonValue::Type::object, it); break; //throw JsonParsingError, X
+                    case '[': containerBegin(JsonValue::Type::array,  it); break; //
+                    case '}': containerEnd  (JsonValue::Type::object, it); break; //
+                    case ']': containerEnd  (JsonValue::Type::array,  it); break; //
+
+                    case ':':
+                        if (expect_ != Expect::colon)
+                            throwParsingError(it);
+                        expect_ = Expect::value;
+                        break;
+
+                    case ',':
+                        if (expect_ != Expect::commaOrEnd)
+                            throwParsingError(it);
+                        expect_ = containers_.back() == JsonValue::Type::object ? Expect::name : Expect::value;
+                        break;
+
+                    case '"':
+                        partial_ = PartialToken::string;
+                        break;
+
+                    default:
+                        if (!isBareChar(c))
+                            throwParsingError(it - 1);
+                        partial_ = PartialToken::bare;
+                        --it;
+                        break;
+                }
+
+        chunkOffset_ += buf.size();
+        chunkBegin_ = nullptr;
+    }
+
+    void finish() //throw JsonParsingError, X
+    {
+        if (partial_ == PartialToken::bare) //e.g. top-level number
+        {
+            partial_ = PartialToken::none;
+            bareToken(partialBuf_, nullptr); //throw JsonParsingError, X
+        }
+        if (partial_ != PartialToken::none || expect_ != Expect::end)
+            throwParsingError(nullptr);
+    }
+
+private:
+    JsonStreamParser           (const JsonStreamParser&) = delete;
+    JsonStreamParser& operator=(const JsonStreamParser&) = delete;
+
+    enum class PartialToken //token might be split between chunks
+    {
+        none,
+        string,
+        bare, //number, boolean, null
+    };
+
+    enum class Expect
+    {
+        value,
+        valueOrArrayEnd,
+        nameOrObjectEnd,
+        name,
+        colon,
+        commaOrEnd,
+        end,
+    };
+
+    static bool isBareChar(const char c) { return ('a' <= c && c <= 'z') || ('0' <= c && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'E'; }
+
+    const char* scanString(const char* it, const char* const last) //throw JsonParsingError, X
+    {
+        const char* const first = it;
+        if (escapeNext_) //chunk ended with backslash
+        {
+            ++it;
+            escapeNext_ = false;
+        }
+        for (;;)
+        {
+            it = std::find_if(it, last, [](const char c) { return c == '"' || c == '\\'; });
+            if (it == last)
+                break;
+
+            if (*it == '\\') //skip next char
+            {
+                haveEscape_ = true;
+                if (++it == last)
+                {
+                    escapeNext_ = true;
+                    break;
+                }
+                ++it;
+            }
+            else //zero-copy unless string is split between chunks or needs unescaping
+            {
+                std::string_view str(first, it);
+                if (!partialBuf_.empty())
+                {
+                    partialBuf_.append(first, it);
+                    str = partialBuf_;
+                }
+                if (haveEscape_)
+                {
+                    unescapeBuf_ = json_impl::jsonUnescape(str);
+                    str = unescapeBuf_;
+                }
+                partial_ = PartialToken::none;
+                haveEscape_ = false;
+                ++it;
+
+                stringToken(str, it); //throw JsonParsingError, X
+                partialBuf_.clear();
+                return it;
+            }
+        }
+        partialBuf_.append(first, last);
+        return last;
+    }
+
+    const char* scanBare(const char* it, const char* const last) //throw JsonParsingError, X
+    {
+        const char* const first = it;
+        it = std::find_if_not(it, last, isBareChar);
+        if (it == last) //token might continue in next chunk
+        {
+            partialBuf_.append(first, last);
+            return last;
+        }
+
+        std::string_view str(first, it);
+        if (!partialBuf_.empty())
+        {
+            partialBuf_.append(first, it);
+            str = partialBuf_;
+        }
+        partial_ = PartialToken::none;
+
+        bareToken(str, it); //throw JsonParsingError, X
+        partialBuf_.clear();
+        return it;
+    }
+
+    void stringToken(const std::string_view str, const char* it) //throw JsonParsingError, X
+    {
+        if (expect_ == Expect::nameOrObjectEnd ||
+            expect_ == Expect::name)
+        {
+            path_.back().assign(str);
+            expect_ = Expect::colon;
+        }
+        else
+            primitiveValue(JsonValue::Type::string, str, it); //throw JsonParsingError, X
+    }
+
+    void bareToken(const std::string_view str, const char* it) //throw JsonParsingError, X
+    {
+        if (str == "true" || str == "false")
+            primitiveValue(JsonValue::Type::boolean, str, it); //throw JsonParsingError, X
+        else if (str == "null")
+            primitiveValue(JsonValue::Type::null, {}, it); //
+        else if (std::all_of(str.begin(), str.end(), [](const char c) { return ('0' <= c && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'; }))
+            primitiveValue(JsonValue::Type::number, str, it); //
+        else
+            throwParsingError(it);
+    }
+
+    void primitiveValue(JsonValue::Type type, const std::string_view primVal, const char* it) //throw JsonParsingError, X
+    {
+        if (expect_ != Expect::value &&
+            expect_ != Expect::valueOrArrayEnd)
+            throwParsingError(it);
+
+        cb_.onValue(path_, type, primVal); //throw X
+        valueEnd();
+    }
+
+    void containerBegin(JsonValue::Type type, const char* it) //throw JsonParsingError, X
+    {
+        if (expect_ != Expect::value &&
+            expect_ != Expect::valueOrArrayEnd)
+            throwParsingError(it);
+
+        cb_.onContainerBegin(path_, type); //throw X
+        containers_.push_back(type);
+        path_.emplace_back(); //object: member name set later; array: always empty
+        expect_ = type == JsonValue::Type::object ? Expect::nameOrObjectEnd : Expect::valueOrArrayEnd;
+    }
+
+    void containerEnd(JsonValue::Type type, const char* it) //throw JsonParsingError, X
+    {
+        if (containers_.empty() || containers_.back() != type ||
+            (expect_ != Expect::commaOrEnd &&
+             expect_ != (type == JsonValue::Type::object ? Expect::nameOrObjectEnd : Expect::valueOrArrayEnd)))
+            throwParsingError(it);
+
+        containers_.pop_back();
+        path_.pop_back();
+        cb_.onContainerEnd(path_, type); //throw X
+        valueEnd();
+    }
+
+    void valueEnd() { expect_ = containers_.empty() ? Expect::end : Expect::commaOrEnd; }
+
+    size_t getOffset(const char* it) const { return chunkOffset_ + (it - chunkBegin_); }
+
+    [[noreturn]] void throwParsingError(const char* it) const //throw JsonParsingError
+    {
+        const size_t offset = it ? getOffset(it) : chunkOffset_;
+        throw JsonParsingError(row_, offset - rowOffset_);
+    }
+
+    JsonStreamCallback& cb_;
+
+    Expect expect_ = Expect::value;
+    std::vector<JsonValue::Type> containers_;
+    std::vector<std::string> path_;
+
+    PartialToken partial_ = PartialToken::none;
+    std::string partialBuf_; //token split between chunks
+    bool haveEscape_ = false;
+    bool escapeNext_ = false;
+    std::string unescapeBuf_;
+
+    size_t bomPos_ = 0;
+    size_t row_ = 0;
+    size_t rowOffset_ = 0; //byte offset of current row
+    size_t chunkOffset_ = 0;
+    const char* chunkBegin_ = nullptr;
+};
 }
 
 #endif //JSON_H_0187348321748321758934215734
@@ -0,0 +1,317 @@
+// *****************************************************************************
+// * This file is part of the FreeFileSync project. It is distributed under    *
+// * GNU General Public License: https://www.gnu.org/licenses/gpl-3.0          *
+// * Copyright (C) Zenju (zenju AT freefilesync DOT org) - All Rights Reserved *
+// *****************************************************************************
+
+#include "perf.h"
+#include <map>
+#include "thread.h"
+    #include <unistd.h> //gettid
+    #include <sys/prctl.h>
+
+using namespace zen;
+
+
+std::atomic<bool> zen::impl::perfTraceActive = false;
+
+
+namespace
+{
+const size_t TRACE_EVENTS_MAX = 200'000; //~20 MB; beyond: keep aggregated metrics only
+
+//AFS calls range from microseconds (local disk) to seconds (cloud)
+constexpr double LATENCY_BUCKETS_SEC[] = {0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10};
+
+
+struct TraceEvent
+{
+    const char* category = nullptr; //string literal
+    std::string name;
+    int64_t startUs    = 0; //relative to PerfTraceData::startTime
+    int64_t durationUs = 0;
+    uint32_t threadId  = 0;
+};
+
+
+struct ThreadStats
+{
+    std::string threadName;
+    std::chrono::nanoseconds busyTime{}; //sum of top-level spans
+};
+
+
+struct LatencyHistogram
+{
+    uint64_t bucketCount[std::size(LATENCY_BUCKETS_SEC)] = {}; //non-cumulative
+    uint64_t count = 0;
+    std::chrono::nanoseconds sum{};
+};
+
+
+struct TransferStats
+{
+    uint64_t bytes = 0;
+    uint64_t count = 0;
+    std::chrono::nanoseconds duration{};
+};
+
+
+struct PerfTraceData
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    time_t startTimeUtc = std::time(nullptr);
+
+    std::vector<TraceEvent> events;
+    size_t eventsDropped = 0;
+
+    std::map<std::string /*name*/, std::chrono::nanoseconds> phaseTimes;
+    std::map<uint32_t /*thread id*/, ThreadStats> threads;
+    std::map<std::pair<std::string /*operation*/, std::string /*device*/>, LatencyHistogram> latencies;
+    std::map<std::pair<std::string /*device*/, std::string /*direction*/>, TransferStats> transfers;
+};
+Protected<PerfTraceData> globalPerfTrace; //accessed after startPerfTrace() only => no static initialization order issues
+
+thread_local int perfTraceSpanDepth = 0; //only top-level spans count as "busy" for thread utilization
+
+
+uint32_t getCurrentThreadId() { return static_cast<uint32_t>(::gettid()); }
+
+
+std::string getCurrentThreadName()
+{
+    char buf[17] = {}; //"The buffer should allow space for up to 16 bytes"
+    if (::prctl(PR_GET_NAME, buf, 0, 0, 0) != 0)
+        return {};
+    return buf;
+}
+
+
+std::string escapeJson(std::string_view str)
+{
+    std::string output;
+    for (const char c : str)
+        switch (c)
+        {
+            //*INDENT-OFF*
+            case '"':  output += "\\\""; break;
+            case '\\': output += "\\\\"; break;
+            case '\n': output += "\\n";  break;
+            case '\r': output += "\\r";  break;
+            case '\t': output += "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    output += printNumber<std::string>("\\u%04x", static_cast<int>(c));
+                else
+                    output += c;
+            //*INDENT-ON*
+        }
+    return output;
+}
+
+
+std::string escapePromLabel(std::string_view str) //https://prometheus.io/docs/instrumenting/exposition_formats/#text-format-details
+{
+    std::string output;
+    for (const char c : str)
+        switch (c)
+        {
+            //*INDENT-OFF*
+            case '"':  output += "\\\""; break;
+            case '\\': output += "\\\\"; break;
+            case '\n': output += "\\n";  break;
+            default:   output += c;
+            //*INDENT-ON*
+        }
+    return output;
+}
+
+
+std::string formatSeconds(std::chrono::nanoseconds duration)
+{
+    return printNumber<std::string>("%.6f", std::chrono::duration<double>(duration).count());
+}
+
+
+int64_t toMicroSec(std::chrono::nanoseconds duration) { return std::chrono::duration_cast<std::chrono::microseconds>(duration).count(); }
+}
+
+
+void zen::startPerfTrace()
+{
+    globalPerfTrace.access([](PerfTraceData& data) { data = PerfTraceData(); });
+    impl::perfTraceActive = true;
+}
+
+
+void PerfTraceSpan::start(const char* category, std::string_view name)
+{
+    assert(category);
+    category_  = category;
+    name_      = name;
+    startTime_ = std::chrono::steady_clock::now();
+    ++perfTraceSpanDepth;
+}
+
+
+void PerfTraceSpan::finish()
+{
+    const auto endTime = std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds duration = endTime - startTime_;
+    const bool topLevel = --perfTraceSpanDepth == 0;
+    const uint32_t threadId = getCurrentThreadId();
+
+    globalPerfTrace.access([&](PerfTraceData& data)
+    {
+        if (startTime_ < data.startTime) //span started before startPerfTrace() reset
+            return;
+
+        ThreadStats& ts = data.threads[threadId];
+        if (ts.threadName.empty())
+            ts.threadName = getCurrentThreadName();
+        if (topLevel)
+            ts.busyTime += duration;
+
+        if (std::string_view(category_) == "phase")
+            data.phaseTimes[name_] += duration;
+
+        if (data.events.size() < TRACE_EVENTS_MAX)
+            data.events.push_back({category_, std::move(name_), toMicroSec(startTime_ - data.startTime), toMicroSec(duration), threadId});
+        else
+            ++data.eventsDropped;
+    });
+}
+
+
+void zen::perfRecordLatency(std::string_view operation, std::string_view device, std::chrono::nanoseconds duration)
+{
+    if (!perfTraceEnabled())
+        return;
+
+    const double durationSec = std::chrono::duration<double>(duration).count();
+    const size_t bucketIdx = std::lower_bound(std::begin(LATENCY_BUCKETS_SEC), std::end(LATENCY_BUCKETS_SEC), durationSec) - std::begin(LATENCY_BUCKETS_SEC);
+
+    globalPerfTrace.access([&](PerfTraceData& data)
+    {
+        LatencyHistogram& hist = data.latencies[{std::string(operation), std::string(device)}];
+        if (bucketIdx < std::size(hist.bucketCount)) //else: +Inf bucket
+            ++hist.bucketCount[bucketIdx];
+        ++hist.count;
+        hist.sum += duration;
+    });
+}
+
+
+void zen::perfRecordTransfer(std::string_view device, std::string_view direction, uint64_t bytes, std::chrono::nanoseconds duration)
+{
+    if (!perfTraceEnabled())
+        return;
+
+    globalPerfTrace.access([&](PerfTraceData& data)
+    {
+        TransferStats& ts = data.transfers[{std::string(device), std::string(direction)}];
+        ts.bytes += bytes;
+        ++ts.count;
+        ts.duration += duration;
+    });
+}
+
+
+std::string zen::getPerfTraceChromeJson() //https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+{
+    return globalPerfTrace.access([](const PerfTraceData& data)
+    {
+        const uint32_t processId = static_cast<uint32_t>(::getpid());
+
+        std::string output = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool firstItem = true;
+        auto addItem = [&](const std::string& item)
+        {
+            if (!firstItem)
+                output += ",\n";
+            firstItem = false;
+            output += item;
+        };
+
+        for (const auto& [threadId, ts] : data.threads)
+            addItem("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + numberTo<std::string>(processId) +
+                    ",\"tid\":" + numberTo<std::string>(threadId) +
+                    ",\"args\":{\"name\":\"" + escapeJson(ts.threadName) + "\"}}");
+
+        for (const TraceEvent& te : data.events)
+            addItem("{\"name\":\"" + escapeJson(te.name) +
+                    "\",\"cat\":\"" + escapeJson(te.category) +
+                    "\",\"ph\":\"X\",\"ts\":" + numberTo<std::string>(te.startUs) +
+                    ",\"dur\":" + numberTo<std::string>(te.durationUs) +
+                    ",\"pid\":" + numberTo<std::string>(processId) +
+                    ",\"tid\":" + numberTo<std::string>(te.threadId) + '}');
+
+        output += "\n],\"otherData\":{\"eventsDropped\":\"" + numberTo<std::string>(data.eventsDropped) + "\"}}\n";
+        return output;
+    });
+}
+
+
+std::string zen::getPerfMetricsPrometheus() //https://prometheus.io/docs/instrumenting/exposition_formats/
+{
+    return globalPerfTrace.access([](const PerfTraceData& data)
+    {
+        const std::chrono::nanoseconds runTime = std::chrono::steady_clock::now() - data.startTime;
+        std::string output;
+
+        auto addHeader = [&](const char* metricName, const char* type, const char* help)
+        {
+            output += std::string("# HELP ") + metricName + ' ' + help + '\n';
+            output += std::string("# TYPE ") + metricName + ' ' + type + '\n';
+        };
+
+        addHeader("ffs_run_start_time_seconds", "gauge", "Start time of the run since Unix epoch.");
+        output += "ffs_run_start_time_seconds " + numberTo<std::string>(data.startTimeUtc) + '\n';
+
+        addHeader("ffs_run_duration_seconds", "gauge", "Total duration of the run.");
+        output += "ffs_run_duration_seconds " + formatSeconds(runTime) + '\n';
+
+        addHeader("ffs_phase_duration_seconds", "gauge", "Time spent per phase.");
+        for (const auto& [phase, duration] : data.phaseTimes)
+            output += "ffs_phase_duration_seconds{phase=\"" + escapePromLabel(phase) + "\"} " + formatSeconds(duration) + '\n';
+
+        addHeader("ffs_thread_busy_seconds", "gauge", "Time spent in traced operations per thread.");
+        for (const auto& [threadId, ts] : data.threads)
+            output += "ffs_thread_busy_seconds{thread=\"" + escapePromLabel(ts.threadName) + "\",tid=\"" + numberTo<std::string>(threadId) + "\"} " + formatSeconds(ts.busyTime) + '\n';
+
+        addHeader("ffs_thread_utilization_ratio", "gauge", "Busy time per thread relative to run duration.");
+        for (const auto& [threadId, ts] : data.threads)
+            output += "ffs_thread_utilization_ratio{thread=\"" + escapePromLabel(ts.threadName) + "\",tid=\"" + numberTo<std::string>(threadId) + "\"} " +
+                      printNumber<std::string>("%.4f", runTime.count() > 0 ? static_cast<double>(ts.busyTime.count()) / runTime.count() : 0.0) + '\n';
+
+        addHeader("ffs_device_transfer_bytes", "gauge", "Bytes transferred per device.");
+        for (const auto& [key, ts] : data.transfers)
+            output += "ffs_device_transfer_bytes{device=\"" + escapePromLabel(key.first) + "\",direction=\"" + escapePromLabel(key.second) + "\"} " + numberTo<std::string>(ts.bytes) + '\n';
+
+        addHeader("ffs_device_transfer_seconds", "gauge", "Time spent transferring files per device.");
+        for (const auto& [key, ts] : data.transfers)
+            output += "ffs_device_transfer_seconds{device=\"" + escapePromLabel(key.first) + "\",direction=\"" + escapePromLabel(key.second) + "\"} " + formatSeconds(ts.duration) + '\n';
+
+        addHeader("ffs_device_throughput_bytes_per_second", "gauge", "Average transfer throughput per device.");
+        for (const auto& [key, ts] : data.transfers)
+            output += "ffs_device_throughput_bytes_per_second{device=\"" + escapePromLabel(key.first) + "\",direction=\"" + escapePromLabel(key.second) + "\"} " +
+                      printNumber<std::string>("%.0f", ts.duration.count() > 0 ? ts.bytes / std::chrono::duration<double>(ts.duration).count() : 0.0) + '\n';
+
+        addHeader("ffs_afs_call_duration_seconds", "histogram", "Latency of file system calls per device.");
+        for (const auto& [key, hist] : data.latencies)
+        {
+            const std::string labels = "operation=\"" + escapePromLabel(key.first) + "\",device=\"" + escapePromLabel(key.second) + '"';
+
+            uint64_t cumulativeCount = 0;
+            for (size_t i = 0; i < std::size(LATENCY_BUCKETS_SEC); ++i)
+            {
+                cumulativeCount += hist.bucketCount[i];
+                output += "ffs_afs_call_duration_seconds_bucket{" + labels + ",le=\"" + printNumber<std::string>("%g", LATENCY_BUCKETS_SEC[i]) + "\"} " + numberTo<std::string>(cumulativeCount) + '\n';
+            }
+            output += "ffs_afs_call_duration_seconds_bucket{" + labels + ",le=\"+Inf\"} " + numberTo<std::string>(hist.count) + '\n';
+            output += "ffs_afs_call_duration_seconds_sum{"     + labels + "} " + formatSeconds(hist.sum) + '\n';
+            output += "ffs_afs_call_duration_seconds_count{"   + labels + "} " + numberTo<std::string>(hist.count) + '\n';
+        }
+        return output;
+    });
+}
@@ -8,6 +8,7 @@
 #define PERF_H_83947184145342652456
 
 #include <chrono>
+#include <atomic>
 #include "string_tools.h"
 
     #include <iostream>
@@ -98,6 +99,55 @@ private:
     StopWatch watch_;
     bool resultShown_ = false;
 };
+
+
+//############# production metrics: trace events, latency histograms, throughput ###############
+/* disabled by default: overhead per instrumented call = one relaxed atomic load
+   enable via startPerfTrace(), then export at the end of the run:
+       - Chrome trace-event JSON: chrome://tracing, https://ui.perfetto.dev
+       - Prometheus text format: e.g. for node_exporter's textfile collector
+
+   Example:
+       PerfTraceSpan dummy("phase", "Compare");  //per-phase timing + thread utilization
+       perfRecordLatency("getItemType", device, duration);
+       perfRecordTransfer(device, "read", bytes, duration);                   */
+namespace impl { extern std::atomic<bool> perfTraceActive; }
+
+inline bool perfTraceEnabled() { return impl::perfTraceActive.load(std::memory_order_relaxed); }
+
+void startPerfTrace(); //discards previously recorded data
+
+
+class PerfTraceSpan //record a "complete event": nested spans are fine
+{
+public:
+    PerfTraceSpan(const char* category, std::string_view name)
+    {
+        if (perfTraceEnabled())
+            start(category, name);
+    }
+
+    ~PerfTraceSpan() { if (category_) finish(); }
+
+private:
+    PerfTraceSpan           (const PerfTraceSpan&) = delete;
+    PerfTraceSpan& operator=(const PerfTraceSpan&) = delete;
+
+    void start(const char* category, std::string_view name);
+    void finish();
+
+    const char* category_ = nullptr;
+    std::string name_;
+    std::chrono::steady_clock::time_point startTime_;
+};
+
+
+//thread-safe; no-op if perf trace is not enabled
+void perfRecordLatency(std::string_view operation, std::string_view device, std::chrono::nanoseconds duration);
+void perfRecordTransfer(std::string_view device, std::string_view direction /*"read", "write"*/, uint64_t bytes, std::chrono::nanoseconds duration);
+
+std::string getPerfTraceChromeJson();
+std::string getPerfMetricsPrometheus();
 }
 
 #endif //PERF_H_83947184145342652456
@@ -7,8 +7,15 @@
 #ifndef UTF_H_01832479146991573473545
 #define UTF_H_01832479146991573473545
 
+#include <span>
 #include "string_tools.h" //copyStringTo
 
+#if defined __GNUC__ && defined __SSE2__ //x86/x86-64
+    #include <emmintrin.h>
+#elif defined __GNUC__ && defined __aarch64__ //NEON is mandatory on ARM64
+    #include <arm_neon.h>
+#endif
+
 
 namespace zen
 {
@@ -53,6 +60,37 @@ const CodePoint CODE_POINT_MAX      = 0x10ffff;
 static_assert(LEAD_SURROGATE + TRAIL_SURROGATE + TRAIL_SURROGATE_MAX + REPLACEMENT_CHAR + CODE_POINT_MAX == 1348603);
 
 
+//ASCII is encoded identically in UTF-8/16/32 => skip decoding for runs of ASCII chars: 16 bytes at a time with SSE2/NEON, 8 bytes (SWAR) otherwise
+template <class Char> inline
+const Char* findNonAscii(const Char* first, const Char* const last)
+{
+    static_assert(std::is_unsigned_v<Char> && (sizeof(Char) == 1 || sizeof(Char) == 2 || sizeof(Char) == 4));
+
+    constexpr uint64_t nonAsciiMask = sizeof(Char) == 1 ? 0x8080'8080'8080'8080 :
+                                      sizeof(Char) == 2 ? 0xff80'ff80'ff80'ff80 :
+                                      /*sizeof(Char) == 4*/ 0xffff'ff80'ffff'ff80;
+#if defined __GNUC__ && defined __SSE2__
+    const __m128i maskVec = _mm_set1_epi64x(static_cast<long long>(nonAsciiMask));
+    for (; last - first >= static_cast<ptrdiff_t>(16 / sizeof(Char)); first += 16 / sizeof(Char))
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first)), maskVec), _mm_setzero_si128())) != 0xffff)
+            break; //find exact position below
+#elif defined __GNUC__ && defined __aarch64__
+    const uint8x16_t maskVec = vreinterpretq_u8_u64(vdupq_n_u64(nonAsciiMask));
+    for (; last - first >= static_cast<ptrdiff_t>(16 / sizeof(Char)); first += 16 / sizeof(Char))
+        if (vmaxvq_u8(vandq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(first)), maskVec)) != 0)
+            break; //
+#endif
+    for (; last - first >= static_cast<ptrdiff_t>(8 / sizeof(Char)); first += 8 / sizeof(Char))
+    {
+        uint64_t block = 0;
+        std::memcpy(&block, first, sizeof(block)); //no alignment requirements
+        if (block & nonAsciiMask)
+            break; //
+    }
+    return std::find_if(first, last, [](Char c) { return c >= 0x80; });
+}
+
+
 template <class Function> inline
 void codePointToUtf16(CodePoint cp, Function writeOutput) //"writeOutput" is a unary function taking a Char16
 {
@@ -97,6 +135,13 @@ public:
         return cp;
     }
 
+    std::span<const Char16> getAsciiRun()
+    {
+        const Char16* const first = it_;
+        it_ = findNonAscii(it_, last_);
+        return {first, it_};
+    }
+
 private:
     void decodeTrail(CodePoint& cp)
     {
@@ -199,6 +244,13 @@ public:
         return cp;
     }
 
+    std::span<const Char8> getAsciiRun()
+    {
+        const Char8* const first = it_;
+        it_ = findNonAscii(it_, last_);
+        return {first, it_};
+    }
+
 private:
     bool decodeTrail(CodePoint& cp)
     {
@@ -238,6 +290,7 @@ class UtfDecoderImpl<CharType, 1> //UTF8-char
 public:
     UtfDecoderImpl(const CharType* str, size_t len) : decoder_(reinterpret_cast<const Char8*>(str), len) {}
     std::optional<CodePoint> getNext() { return decoder_.getNext(); }
+    std::span<const Char8> getAsciiRun() { return decoder_.getAsciiRun(); }
 private:
     Utf8Decoder decoder_;
 };
@@ -249,6 +302,7 @@ class UtfDecoderImpl<CharType, 2> //Windows: UTF16-wchar_t
 public:
     UtfDecoderImpl(const CharType* str, size_t len) : decoder_(reinterpret_cast<const Char16*>(str), len) {}
     std::optional<CodePoint> getNext() { return decoder_.getNext(); }
+    std::span<const Char16> getAsciiRun() { return decoder_.getAsciiRun(); }
 private:
     Utf16Decoder decoder_;
 };
@@ -265,6 +319,12 @@ public:
             return {};
         return *it_++;
     }
+    std::span<const CodePoint> getAsciiRun()
+    {
+        const CodePoint* const first = it_;
+        it_ = findNonAscii(it_, last_);
+        return {first, it_};
+    }
 private:
     const CodePoint* it_;
     const CodePoint* last_;
@@ -291,11 +351,15 @@ bool isValidUtf(const UtfString& str)
     using namespace impl;
 
     UtfDecoder<GetCharTypeT<UtfString>> decoder(strBegin(str), strLength(str));
-    while (const std::optional<CodePoint> cp = decoder.getNext())
+    for (;;)
+    {
+        decoder.getAsciiRun(); //fast path
+        const std::optional<CodePoint> cp = decoder.getNext();
+        if (!cp)
+            return true;
         if (*cp == REPLACEMENT_CHAR)
             return false;
-
-    return true;
+    }
 }
 
 
@@ -304,9 +368,13 @@ size_t unicodeLength(const UtfString& str) //return number of code points (+ cor
 {
     size_t uniLen = 0;
     UtfDecoder<GetCharTypeT<UtfString>> decoder(strBegin(str), strLength(str));
-    while (decoder.getNext())
+    for (;;)
+    {
+        uniLen += decoder.getAsciiRun().size(); //fast path
+        if (!decoder.getNext())
+            return uniLen;
         ++uniLen;
-    return uniLen;
+    }
 }
 
 
@@ -337,6 +405,52 @@ UtfStringOut getUnicodeSubstring(const UtfStringIn& str, size_t uniPosFirst, siz
 
 namespace impl
 {
+//appending single chars is slow for some string classes (e.g. Zbase: reserve() for each call) => append in blocks
+template <class TargetString>
+class BufferedStringOut
+{
+public:
+    using CharTrg = GetCharTypeT<TargetString>;
+
+    explicit BufferedStringOut(TargetString& output) : output_(output) {}
+
+    void operator()(CharTrg c)
+    {
+        if (pos_ == std::size(buf_))
+            flush();
+        buf_[pos_++] = c;
+    }
+
+    template <class Char>
+    void appendAscii(std::span<const Char> chars) //ASCII: conversion = zero-extension/truncation (vectorized by compiler)
+    {
+        for (auto it = chars.begin(); it != chars.end();)
+        {
+            if (pos_ == std::size(buf_))
+                flush();
+            const size_t blockSize = std::min(std::size(buf_) - pos_, static_cast<size_t>(chars.end() - it));
+            std::transform(it, it + blockSize, buf_ + pos_, [](Char c) { return static_cast<CharTrg>(c); });
+            it   += blockSize;
+            pos_ += blockSize;
+        }
+    }
+
+    void flush()
+    {
+        output_.append(buf_, pos_);
+        pos_ = 0;
+    }
+
+private:
+    BufferedStringOut           (const BufferedStringOut&) = delete;
+    BufferedStringOut& operator=(const BufferedStringOut&) = delete;
+
+    TargetString& output_;
+    CharTrg buf_[256];
+    size_t pos_ = 0;
+};
+
+
 template <class TargetString, class SourceString> inline
 TargetString utfTo(const SourceString& str, std::true_type) { return copyStringTo<TargetString>(str); }
 
@@ -349,10 +463,19 @@ TargetString utfTo(const SourceString& str, std::false_type)
     static_assert(sizeof(CharSrc) != sizeof(CharTrg));
 
     TargetString output;
+    BufferedStringOut<TargetString> bufOut(output);
 
     UtfDecoder<CharSrc> decoder(strBegin(str), strLength(str));
-    while (const std::optional<CodePoint> cp = decoder.getNext())
-        codePointToUtf<CharTrg>(*cp, [&](CharTrg c) { output += c; });
+    for (;;)
+    {
+        bufOut.appendAscii(decoder.getAsciiRun()); //fast path: no decoding/encoding needed
+
+        const std::optional<CodePoint> cp = decoder.getNext();
+        if (!cp)
+            break;
+        codePointToUtf<CharTrg>(*cp, [&](CharTrg c) { bufOut(c); });
+    }
+    bufOut.flush();
 
     return output;
 }
@@ -5,14 +5,102 @@
 // *****************************************************************************
 
 #include "zstring.h"
+#include <bit> //std::countr_zero
     //#include <glib.h>
     #include "sys_error.h"
 
+#if defined __GNUC__ && defined __SSE2__ //x86/x86-64
+    #define ZEN_SIMD_X86
+    #include <immintrin.h>
+#elif defined __GNUC__ && defined __aarch64__ //NEON is mandatory on ARM64
+    #define ZEN_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
 using namespace zen;
 
 
 namespace
 {
+/*  ASCII fast paths: 16 bytes at a time with SSE2/NEON, 8 bytes (SWAR) otherwise
+    => called for every item name during filtering, merging by name and sorting: glib is needed for true non-ASCII only
+    AVX2: no measurable gain for typical file name lengths (< 32 bytes), and not part of the x86-64 baseline anyway */
+static_assert(std::is_same_v<Zchar, char>);
+
+inline bool isAsciiUtf8(const Zstring& str)
+{
+    const auto first = reinterpret_cast<const impl::Char8*>(str.c_str());
+    const auto last = first + str.size();
+    return impl::findNonAscii(first, last) == last;
+}
+
+
+#ifdef ZEN_SIMD_X86
+inline __m128i isLowerAscii(__m128i v) //expects ASCII: signed comparison is fine
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8('z' + 1)));
+}
+inline __m128i toUpperAscii(__m128i v) { return _mm_sub_epi8(v, _mm_and_si128(isLowerAscii(v), _mm_set1_epi8('a' - 'A'))); }
+
+#elif defined ZEN_SIMD_NEON
+inline uint8x16_t isLowerAscii(uint8x16_t v) { return vandq_u8(vcgeq_u8(v, vdupq_n_u8('a')), vcleq_u8(v, vdupq_n_u8('z'))); }
+inline uint8x16_t toUpperAscii(uint8x16_t v) { return vsubq_u8(v, vandq_u8(isLowerAscii(v), vdupq_n_u8('a' - 'A'))); }
+#endif
+
+
+bool haveLowerCaseAscii(const char* first, const char* const last)
+{
+#ifdef ZEN_SIMD_X86
+    for (; last - first >= 16; first += 16)
+        if (_mm_movemask_epi8(isLowerAscii(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first)))) != 0)
+            return true;
+#elif defined ZEN_SIMD_NEON
+    for (; last - first >= 16; first += 16)
+        if (vmaxvq_u8(isLowerAscii(vld1q_u8(reinterpret_cast<const uint8_t*>(first)))) != 0)
+            return true;
+#endif
+    return std::any_of(first, last, [](char c) { return 'a' <= c && c <= 'z'; });
+}
+
+
+void toUpperAsciiInPlace(char* first, char* const last)
+{
+#ifdef ZEN_SIMD_X86
+    for (; last - first >= 16; first += 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(first), toUpperAscii(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first))));
+#elif defined ZEN_SIMD_NEON
+    for (; last - first >= 16; first += 16)
+        vst1q_u8(reinterpret_cast<uint8_t*>(first), toUpperAscii(vld1q_u8(reinterpret_cast<const uint8_t*>(first))));
+#endif
+    for (; first != last; ++first)
+        *first = asciiToUpper(*first);
+}
+
+
+//position of first char differing after conversion to upper case, or "len"
+size_t mismatchNoCaseAscii(const char* lhs, const char* rhs, size_t len)
+{
+    size_t i = 0;
+#ifdef ZEN_SIMD_X86
+    for (; len - i >= 16; i += 16)
+        if (const unsigned int eqMask = _mm_movemask_epi8(_mm_cmpeq_epi8(toUpperAscii(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i))),
+                                                                         toUpperAscii(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i)))));
+            eqMask != 0xffff)
+            return i + std::countr_zero(~eqMask);
+#elif defined ZEN_SIMD_NEON
+    for (; len - i >= 16; i += 16)
+        if (vminvq_u8(vceqq_u8(toUpperAscii(vld1q_u8(reinterpret_cast<const uint8_t*>(lhs + i))),
+                               toUpperAscii(vld1q_u8(reinterpret_cast<const uint8_t*>(rhs + i))))) != 0xff)
+            break; //find exact position below
+#endif
+    for (; i < len; ++i)
+        if (asciiToUpper(lhs[i]) != asciiToUpper(rhs[i]))
+            break;
+    return i;
+}
+
+
 Zstring getUnicodeNormalForm_NonAsciiValidUtf(const Zstring& str, UnicodeNormalForm form)
 {
     //Example: const char* decomposed  = "\x6f\xcc\x81"; //ó
@@ -85,9 +173,11 @@ Zstring getUpperCaseAscii(const Zstring& str)
 {
     assert(isAsciiString(str));
 
+    if (!haveLowerCaseAscii(str.data(), str.data() + str.size())) //e.g. already normalized, or digits only
+        return str; //ref-counted: no memory allocation
+
     Zstring output = str;
-    for (Zchar& c : output)  //identical to LCMapStringEx(), g_unichar_toupper(), CFStringUppercase() [verified!]
-        c = asciiToUpper(c); //
+    toUpperAsciiInPlace(output.data(), output.data() + output.size()); //identical to LCMapStringEx(), g_unichar_toupper(), CFStringUppercase() [verified!]
     return output;
 }
 
@@ -123,7 +213,7 @@ Zstring getUnicodeNormalForm(const Zstring& str, UnicodeNormalForm form)
 {
     static_assert(std::is_same_v<decltype(str), const Zbase<Zchar>&>, "god bless our ref-counting! => save needless memory allocation!");
 
-    if (isAsciiString(str)) //fast path: in the range of 3.5ns
+    if (isAsciiUtf8(str)) //fast path: in the range of 3.5ns
         return str;
 
     return getUnicodeNormalForm_NonAsciiValidUtf(getValidUtf(str), form); //slow path
@@ -132,7 +222,7 @@ Zstring getUnicodeNormalForm(const Zstring& str, UnicodeNormalForm form)
 
 Zstring getUpperCase(const Zstring& str)
 {
-    return isAsciiString(str) ? //fast path: in the range of 3.5ns
+    return isAsciiUtf8(str) ? //fast path: in the range of 3.5ns
            getUpperCaseAscii(str) :
            getUpperCaseNonAscii(str); //slow path
 }
@@ -173,15 +263,22 @@ std::weak_ordering compareNoCaseUtf8(const char* lhs, size_t lhsLen, const char*
 
 
 std::weak_ordering compareNatural(const Zstring& lhs, const Zstring& rhs)
+{
+    /* Unicode Normalization Forms:
+          Windows: CompareString() ignores NFD/NFC differences and converts to NFD
+          Linux:  g_unichar_toupper() can't ignore differences
+          macOS:  CFStringCompare() considers differences */
+    return compareNatural(ZstringNatural(lhs),  //normalize: - broken UTF encoding
+                          ZstringNatural(rhs)); //           - Unicode non-characters
+}
+
+
+std::weak_ordering compareNatural(const ZstringNatural& lhs, const ZstringNatural& rhs)
 {
     try
     {
-        /* Unicode Normalization Forms:
-              Windows: CompareString() ignores NFD/NFC differences and converts to NFD
-              Linux:  g_unichar_toupper() can't ignore differences
-              macOS:  CFStringCompare() considers differences */
-        const Zstring& lhsNorm = getUnicodeNormalForm(lhs, UnicodeNormalForm::nfd); //normalize: - broken UTF encoding
-        const Zstring& rhsNorm = getUnicodeNormalForm(rhs, UnicodeNormalForm::nfd); //           - Unicode non-characters
+        const Zstring& lhsNorm = lhs.normStr;
+        const Zstring& rhsNorm = rhs.normStr;
 
         const char* strL = lhsNorm.c_str();
         const char* strR = rhsNorm.c_str();
@@ -257,27 +354,27 @@ std::weak_ordering compareNatural(const Zstring& lhs, const Zstring& rhs)
     catch (const SysError& e)
     {
         throw std::runtime_error(std::string(__FILE__) + '[' + numberTo<std::string>(__LINE__) + "] Error comparing strings:" + '\n' +
-                                 utfTo<std::string>(lhs) + '\n' + utfTo<std::string>(rhs) + "\n\n" + utfTo<std::string>(e.toString()));
+                                 utfTo<std::string>(lhs.normStr) + '\n' + utfTo<std::string>(rhs.normStr) + "\n\n" + utfTo<std::string>(e.toString()));
     }
 }
 
 
 std::weak_ordering compareNoCase(const Zstring& lhs, const Zstring& rhs)
 {
-    const bool isAsciiL = isAsciiString(lhs);
-    const bool isAsciiR = isAsciiString(rhs);
+    const bool isAsciiL = isAsciiUtf8(lhs);
+    const bool isAsciiR = isAsciiUtf8(rhs);
 
     //fast path: no memory allocations => ~ 6x speedup
     if (isAsciiL && isAsciiR)
     {
         const size_t minSize = std::min(lhs.size(), rhs.size());
-        for (size_t i = 0; i < minSize; ++i)
+        if (const size_t i = mismatchNoCaseAscii(lhs.c_str(), rhs.c_str(), minSize);
+            i != minSize)
         {
             //ordering: do NOT call compareAsciiNoCase(), which uses asciiToLower()!
             const Zchar lUp = asciiToUpper(lhs[i]); //
             const Zchar rUp = asciiToUpper(rhs[i]); //no surprises: emulate getUpperCase() [verified!]
-            if (lUp != rUp)                         //
-                return lUp <=> rUp;                 //
+            return lUp <=> rUp;                     //
         }
         return lhs.size() <=> rhs.size();
     }
@@ -293,21 +390,15 @@ std::weak_ordering compareNoCase(const Zstring& lhs, const Zstring& rhs)
 
 bool equalNoCase(const Zstring& lhs, const Zstring& rhs)
 {
-    const bool isAsciiL = isAsciiString(lhs);
-    const bool isAsciiR = isAsciiString(rhs);
+    const bool isAsciiL = isAsciiUtf8(lhs);
+    const bool isAsciiR = isAsciiUtf8(rhs);
 
     //fast-path: no extra memory allocations
     //caveat: ASCII-char and non-ASCII Unicode *can* compare case-insensitive equal!!! e.g. i and ı https://freefilesync.org/forum/viewtopic.php?t=9718
     if (isAsciiL && isAsciiR)
     {
-        if (lhs.size() != rhs.size())
-            return false;
-
-        for (size_t i = 0; i < lhs.size(); ++i)
-            if (asciiToUpper(lhs[i]) !=
-                asciiToUpper(rhs[i]))
-                return false;
-        return true;
+        return lhs.size() == rhs.size() &&
+               mismatchNoCaseAscii(lhs.c_str(), rhs.c_str(), lhs.size()) == lhs.size();
     }
 
     return (isAsciiL ? getUpperCaseAscii(lhs) : getUpperCaseNonAscii(lhs)) ==
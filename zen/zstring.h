@@ -76,6 +76,14 @@ std::weak_ordering compareNatural(const Zstring& lhs, const Zstring& rhs);
 
 struct LessNaturalSort { bool operator()(const Zstring& lhs, const Zstring& rhs) const { return compareNatural(lhs, rhs) < 0; } };
 
+struct ZstringNatural //use as sort key: better than repeated Unicode normalizations during compareNatural()
+{
+    ZstringNatural() {}
+    explicit ZstringNatural(const Zstring& str) : normStr(getUnicodeNormalForm(str, UnicodeNormalForm::nfd)) {}
+    Zstring normStr;
+};
+std::weak_ordering compareNatural(const ZstringNatural& lhs, const ZstringNatural& rhs);
+
 
 //------------------------------------------------------------------------------------------
 //common Unicode characters
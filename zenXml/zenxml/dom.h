@@ -49,6 +49,9 @@ public:
 
     void setValue(std::string&& value) { value_ = std::move(value); } //perf
 
+    //raw string value: no conversion, no copy -> disabled documentation extraction
+    const std::string& getValueRef() const { return value_; } //perf
+
     ///Retrieve an attribute by name.
     /**
       \tparam T String-convertible user data type: e.g. any string class, all built-in arithmetic numbers
@@ -74,9 +74,15 @@ XmlDoc parseXml(const std::string& stream); //throw XmlParsingError
 namespace xml_impl
 {
 template <class Predicate> inline
-std::string normalize(const std::string_view& str, Predicate pred) //pred: unary function taking a char, return true if value shall be encoded as hex
+void normalize(const std::string_view& str, std::string& output, Predicate pred) //pred: unary function taking a char, return true if value shall be encoded as hex
 {
-    std::string output;
+    //perf: most names and values need no escaping at all
+    if (std::none_of(str.begin(), str.end(), [&](const char c) { return c == '&' || c == '<' || c == '>' || pred(c); }))
+    {
+        output += str;
+        return;
+    }
+
     for (const char c : str)
         switch (c)
         {
@@ -101,27 +107,25 @@ std::string normalize(const std::string_view& str, Predicate pred) //pred: unary
                     output += c;
                 break;
         }
-    return output;
 }
 
 inline
-std::string normalizeName(const std::string& str)
+void normalizeName(const std::string_view& str, std::string& output)
 {
-    /*const*/ std::string nameFmt = normalize(str, [](const char c) { return isWhiteSpace(c) || c == '=' || c == '/' || c == '\'' || c == '"'; });
-    assert(!nameFmt.empty());
-    return nameFmt;
+    assert(!str.empty());
+    normalize(str, output, [](const char c) { return isWhiteSpace(c) || c == '=' || c == '/' || c == '\'' || c == '"'; });
 }
 
 inline
-std::string normalizeElementValue(const std::string& str)
+void normalizeElementValue(const std::string_view& str, std::string& output)
 {
-    return normalize(str, [](const char c) { return static_cast<unsigned char>(c) < 32; });
+    normalize(str, output, [](const char c) { return static_cast<unsigned char>(c) < 32; });
 }
 
 inline
-std::string normalizeAttribValue(const std::string& str)
+void normalizeAttribValue(const std::string_view& str, std::string& output)
 {
-    return normalize(str, [](const char c) { return static_cast<unsigned char>(c) < 32 || c == '\'' || c == '"'; });
+    normalize(str, output, [](const char c) { return static_cast<unsigned char>(c) < 32 || c == '\'' || c == '"'; });
 }
 
 
@@ -143,7 +147,12 @@ namespace
 {
 std::string denormalize(const std::string_view& str)
 {
+    //perf: most names and values contain neither entities nor line breaks
+    if (std::none_of(str.begin(), str.end(), [](const char c) { return c == '&' || c == '\r'; }))
+        return std::string(str);
+
     std::string output;
+    output.reserve(str.size());
     for (auto it = str.begin(); it != str.end(); ++it)
     {
         const char c = *it;
@@ -187,39 +196,60 @@ void serialize(const XmlElement& element, std::string& stream,
                const std::string& indent,
                size_t indentLevel)
 {
-    const std::string& nameFmt = normalizeName(element.getName());
+    //perf: append to stream directly: no temporary strings per element
+    auto writeEndTag = [&]
+    {
+        stream += "</";
+        normalizeName(element.getName(), stream);
+        stream += '>';
+        stream += lineBreak;
+    };
 
     for (size_t i = 0; i < indentLevel; ++i)
         stream += indent;
 
-    stream += '<' + nameFmt;
+    stream += '<';
+    normalizeName(element.getName(), stream);
 
     auto attr = element.getAttributes();
     for (auto it = attr.first; it != attr.second; ++it)
-        stream += ' ' + normalizeName(it->name) + "=\"" + normalizeAttribValue(it->value) + '"';
+    {
+        stream += ' ';
+        normalizeName(it->name, stream);
+        stream += "=\"";
+        normalizeAttribValue(it->value, stream);
+        stream += '"';
+    }
 
     const auto& children = element.getChildren();
     if (!children.empty()) //structured element
     {
         //no support for mixed-mode content
-        stream += '>' + lineBreak;
+        stream += '>';
+        stream += lineBreak;
 
         for (const XmlElement& el : children)
             serialize(el, stream, lineBreak, indent, indentLevel + 1);
 
         for (size_t i = 0; i < indentLevel; ++i)
             stream += indent;
-        stream += "</" + nameFmt + '>' + lineBreak;
+        writeEndTag();
     }
     else
     {
-        std::string value;
-        element.getValue(value);
+        const std::string& value = element.getValueRef();
 
         if (!value.empty()) //value element
-            stream += '>' + normalizeElementValue(value) + "</" + nameFmt + '>' + lineBreak;
+        {
+            stream += '>';
+            normalizeElementValue(value, stream);
+            writeEndTag();
+        }
         else //empty element
-            stream += "/>" + lineBreak;
+        {
+            stream += "/>";
+            stream += lineBreak;
+        }
     }
 }
 }
@@ -232,19 +262,23 @@ std::string serializeXml(const XmlDoc& doc,
 {
     std::string output = "<?xml";
 
-    const std::string& version = doc.getVersion();
-    if (!version.empty())
-        output += " version=\"" + xml_impl::normalizeAttribValue(version) + '"';
-
-    const std::string& encoding = doc.getEncoding();
-    if (!encoding.empty())
-        output += " encoding=\"" + xml_impl::normalizeAttribValue(encoding) + '"';
-
-    const std::string& standalone = doc.getStandalone();
-    if (!standalone.empty())
-        output += " standalone=\"" + xml_impl::normalizeAttribValue(standalone) + '"';
+    auto writeDeclAttribute = [&](const char* name, const std::string& value)
+    {
+        if (!value.empty())
+        {
+            output += ' ';
+            output += name;
+            output += "=\"";
+            xml_impl::normalizeAttribValue(value, output);
+            output += '"';
+        }
+    };
+    writeDeclAttribute("version",    doc.getVersion());
+    writeDeclAttribute("encoding",   doc.getEncoding());
+    writeDeclAttribute("standalone", doc.getStandalone());
 
-    output += "?>" + lineBreak;
+    output += "?>";
+    output += lineBreak;
 
     xml_impl::serialize(doc.root(), output, lineBreak, indent, 0 /*indentLevel*/);
     return output;
@@ -303,7 +337,7 @@ struct Token
 class Scanner
 {
 public:
-    explicit Scanner(const std::string& stream) : stream_(stream), pos_(stream_.begin())
+    explicit Scanner(const std::string_view stream) : stream_(stream), pos_(stream_.begin()) //zero-copy: stream must outlive Scanner!
     {
         if (zen::startsWith(stream_, BYTE_ORDER_MARK_UTF8))
             pos_ += BYTE_ORDER_MARK_UTF8.size();
@@ -311,29 +345,45 @@ public:
 
     Token getNextToken() //throw XmlParsingError
     {
-        //skip whitespace
-        pos_ = std::find_if_not(pos_, stream_.end(), isWhiteSpace<char>);
+        for (;;)
+        {
+            //skip whitespace
+            pos_ = std::find_if_not(pos_, stream_.end(), isWhiteSpace<char>);
 
-        if (pos_ == stream_.end())
-            return Token::TK_END;
+            if (pos_ == stream_.end())
+                return Token::TK_END;
 
-        //skip XML comments
-        if (startsWith(xmlCommentBegin_))
-        {
-            auto it = std::search(pos_ + xmlCommentBegin_.size(), stream_.end(), xmlCommentEnd_.begin(), xmlCommentEnd_.end());
-            if (it != stream_.end())
-            {
-                pos_ = it + xmlCommentEnd_.size();
-                return getNextToken(); //throw XmlParsingError
-            }
+            //skip XML comments
+            if (!startsWith(xmlCommentBegin))
+                break;
+
+            auto it = std::search(pos_ + xmlCommentBegin.size(), stream_.end(), xmlCommentEnd.begin(), xmlCommentEnd.end());
+            if (it == stream_.end())
+                break;
+            pos_ = it + xmlCommentEnd.size();
         }
 
-        for (auto it = tokens_.begin(); it != tokens_.end(); ++it)
-            if (startsWith(it->first))
-            {
-                pos_ += it->first.size();
-                return it->second;
-            }
+        //perf: dispatch on first char instead of testing each token
+        switch (*pos_)
+        {
+            case '<':
+                if (startsWith("<?xml")) return consume(5, Token::TK_DECL_BEGIN);
+                if (startsWith("</"))    return consume(2, Token::TK_LESS_SLASH);
+                return consume(1, Token::TK_LESS);
+            case '?':
+                if (startsWith("?>")) return consume(2, Token::TK_DECL_END);
+                break;
+            case '/':
+                if (startsWith("/>")) return consume(2, Token::TK_SLASH_GREATER);
+                break;
+            case '>':
+                return consume(1, Token::TK_GREATER);
+            case '=':
+                return consume(1, Token::TK_EQUAL);
+            case '"':
+            case '\'':
+                return consume(1, Token::TK_QUOTE);
+        }
 
         const auto itNameEnd = std::find_if(pos_, stream_.end(), [](const char c)
         {
@@ -407,37 +457,29 @@ private:
     Scanner           (const Scanner&) = delete;
     Scanner& operator=(const Scanner&) = delete;
 
-    bool startsWith(const std::string& prefix) const
+    bool startsWith(const std::string_view prefix) const
     {
         return zen::startsWith(makeStringView(pos_, stream_.end()), prefix);
     }
 
-    using TokenList = std::vector<std::pair<std::string, Token::Type>>;
-    const TokenList tokens_
+    Token::Type consume(size_t tokenLen, Token::Type t)
     {
-        {"<?xml", Token::TK_DECL_BEGIN   },
-        {"?>",    Token::TK_DECL_END     },
-        {"</",    Token::TK_LESS_SLASH   },
-        {"/>",    Token::TK_SLASH_GREATER},
-        {"<",     Token::TK_LESS         }, //evaluate after TK_DECL_BEGIN!
-        {">",     Token::TK_GREATER      },
-        {"=",     Token::TK_EQUAL        },
-        {"\"",    Token::TK_QUOTE        },
-        {"\'",    Token::TK_QUOTE        },
-    };
+        pos_ += tokenLen;
+        return t;
+    }
 
-    const std::string xmlCommentBegin_ = "<!--";
-    const std::string xmlCommentEnd_   = "-->";
+    static constexpr std::string_view xmlCommentBegin = "<!--";
+    static constexpr std::string_view xmlCommentEnd   = "-->";
 
-    const std::string stream_;
-    std::string::const_iterator pos_;
+    const std::string_view stream_;
+    std::string_view::const_iterator pos_;
 };
 
 
 class XmlParser
 {
 public:
-    explicit XmlParser(const std::string& stream) :
+    explicit XmlParser(const std::string_view stream) :
         scn_(stream),
         tk_(scn_.getNextToken()) {} //throw XmlParsingError
 
@@ -494,11 +536,9 @@ private:
             nextToken(); //throw XmlParsingError
 
             expectToken(Token::TK_NAME); //throw XmlParsingError
-            const std::string elementName = token().name;
+            XmlElement& newElement = parent.addChild(std::move(tk_.name));
             nextToken(); //throw XmlParsingError
 
-            XmlElement& newElement = parent.addChild(elementName);
-
             parseAttributes(newElement);
 
             if (token().type == Token::TK_SLASH_GREATER) //empty element
@@ -520,7 +560,7 @@ private:
             consumeToken(Token::TK_LESS_SLASH); //throw XmlParsingError
 
             expectToken(Token::TK_NAME); //throw XmlParsingError
-            if (token().name != elementName)
+            if (token().name != newElement.getName())
                 throw XmlParsingError(scn_.posRow(), scn_.posCol());
             nextToken(); //throw XmlParsingError
 
@@ -532,7 +572,7 @@ private:
     {
         while (token().type == Token::TK_NAME)
         {
-            const std::string attribName = token().name;
+            std::string attribName = std::move(tk_.name);
             nextToken(); //throw XmlParsingError
 
             consumeToken(Token::TK_EQUAL); //throw XmlParsingError
@@ -541,7 +581,7 @@ private:
             nextToken(); //throw XmlParsingError
 
             consumeToken(Token::TK_QUOTE); //throw XmlParsingError
-            element.setAttribute(attribName, attribValue);
+            element.setAttribute(std::move(attribName), attribValue);
         }
     }
 